@@ -0,0 +1,225 @@
+#ifndef _CEST_ARENA_HPP_
+#define _CEST_ARENA_HPP_
+
+#include "cest/vector.hpp"
+#include <memory>      // std::allocator
+#include <new>         // ::operator new, std::bad_array_new_length
+#include <type_traits>
+#include <cstddef>     // std::size_t, std::byte, std::max_align_t
+#include <cstdint>     // std::uintptr_t
+
+// The size in bytes of each block an arena obtains at runtime. Requests which
+// don't fit in a block of this size are given a block of their own.
+#ifndef CEST_ARENA_BLOCK_SIZE
+#define CEST_ARENA_BLOCK_SIZE (64 * 1024)
+#endif
+
+namespace cest {
+
+namespace impl {
+
+// A constant expression can't create objects within an array of bytes; so
+// there an arena's blocks are instead arrays of the element type requested.
+// A block is released through a virtual call, which knows that type; and, as
+// with shared_ptr's control block, the destructor need not be virtual.
+struct arena_typed_block
+{
+  constexpr arena_typed_block(const void* tag, std::size_t size)
+    : tag_(tag), size_(size) {}
+
+  constexpr virtual void destroy() noexcept = 0;
+
+  const void* tag_;  // identifies the element type
+  std::size_t size_;
+  std::size_t used_ = 0;
+
+protected:
+  constexpr ~arena_typed_block() = default;
+};
+
+template <typename T>
+inline constexpr char arena_tag{};
+
+template <typename T>
+struct arena_typed_block_of final : arena_typed_block
+{
+  constexpr arena_typed_block_of(std::size_t size)
+    : arena_typed_block(&arena_tag<T>, size),
+      p_(std::allocator<T>{}.allocate(size)) {}
+
+  constexpr virtual void destroy() noexcept override
+  {
+    std::allocator<T>{}.deallocate(p_, size_);
+    delete this;
+  }
+
+  T* p_;
+};
+
+struct arena_block
+{
+  std::byte*  p;
+  std::size_t size;
+};
+
+} // namespace impl
+
+// A monotonic arena: storage is handed out from large blocks by bumping a
+// pointer, and is only reclaimed, all at once, by release() or the arena's
+// destructor. deallocate is a no-op. This suits many short-lived allocations;
+// such as the nodes and strings created while parsing a single file. The
+// blocks are themselves held in a cest::vector, and an arena may be used
+// within a constant expression.
+class arena
+{
+public:
+  explicit constexpr arena(std::size_t block_size = CEST_ARENA_BLOCK_SIZE)
+    : m_block_size(block_size) {}
+
+  arena(const arena&) = delete;
+  arena& operator=(const arena&) = delete;
+
+  constexpr ~arena() { release(); }
+
+  // As std::allocator, an n whose size in bytes would overflow throws
+  // std::bad_array_new_length
+  template <typename T>
+  constexpr T* allocate(std::size_t n)
+  {
+    if (n > std::size_t(-1) / sizeof(T))
+      throw std::bad_array_new_length();
+    if (std::is_constant_evaluated())
+      return allocate_typed<T>(n);
+    return static_cast<T*>(allocate_bytes(n * sizeof(T), alignof(T)));
+  }
+
+  // Frees every block: O(1) per block, rather than per allocation
+  constexpr void release() noexcept
+  {
+    for (auto* b : m_typed_blocks)
+      b->destroy();
+    m_typed_blocks.clear();
+    for (auto& b : m_blocks)
+      ::operator delete(b.p, b.size, std::align_val_t{alignof(std::max_align_t)});
+    m_blocks.clear();
+    m_cur = m_end = nullptr;
+  }
+
+  constexpr std::size_t block_size()  const noexcept { return m_block_size; }
+  constexpr std::size_t block_count() const noexcept {
+    return m_blocks.size() + m_typed_blocks.size();
+  }
+
+  // At runtime only: storage for any type, from the blocks of raw bytes. A
+  // size which can't be padded to the alignment throws
+  // std::bad_array_new_length.
+  void* allocate_bytes(std::size_t bytes, std::size_t align)
+  {
+    if (bytes > std::size_t(-1) - align)
+      throw std::bad_array_new_length();
+    auto cur = reinterpret_cast<std::uintptr_t>(m_cur);
+    auto aligned = (cur + align - 1) & ~std::uintptr_t(align - 1);
+    const auto end = reinterpret_cast<std::uintptr_t>(m_end);
+    if (!m_cur || aligned > end || bytes > end - aligned) {
+      const std::size_t need = bytes + align;
+      const std::size_t size = need > m_block_size ? need : m_block_size;
+      auto* p = static_cast<std::byte*>(::operator new(size,
+                  std::align_val_t{alignof(std::max_align_t)}));
+      m_blocks.push_back({p, size});
+      // A block of its own doesn't displace the current block
+      if (need > m_block_size && m_cur) {
+        cur = reinterpret_cast<std::uintptr_t>(p);
+        return reinterpret_cast<void*>((cur + align - 1) &
+                                       ~std::uintptr_t(align - 1));
+      }
+      m_cur = p;
+      m_end = p + size;
+      cur = reinterpret_cast<std::uintptr_t>(m_cur);
+      aligned = (cur + align - 1) & ~std::uintptr_t(align - 1);
+    }
+    m_cur = reinterpret_cast<std::byte*>(aligned + bytes);
+    return reinterpret_cast<void*>(aligned);
+  }
+
+private:
+
+  template <typename T>
+  constexpr T* allocate_typed(std::size_t n)
+  {
+    // Only the newest block of type T is bumped; as are the runtime blocks
+    for (std::size_t i = m_typed_blocks.size(); i-- > 0; ) {
+      auto* b = m_typed_blocks[i];
+      if (b->tag_ == &impl::arena_tag<T>) {
+        if (b->size_ - b->used_ >= n) {
+          T* p = static_cast<impl::arena_typed_block_of<T>*>(b)->p_ + b->used_;
+          b->used_ += n;
+          return p;
+        }
+        break;
+      }
+    }
+    const std::size_t per_block = m_block_size / sizeof(T);
+    auto* b = new impl::arena_typed_block_of<T>(n > per_block ? n : per_block);
+    m_typed_blocks.push_back(b);
+    b->used_ = n;
+    return b->p_;
+  }
+
+  std::size_t                        m_block_size;
+  std::byte*                         m_cur = nullptr;
+  std::byte*                         m_end = nullptr;
+  vector<impl::arena_block>          m_blocks;       // runtime
+  vector<impl::arena_typed_block*>   m_typed_blocks; // constant expressions
+};
+
+// An allocator drawing from an arena; usable as the Allocator of any cest
+// container, constructed with e.g. cest::vector<int, A>(A(a)). A default
+// constructed monotonic_allocator has no arena, and uses std::allocator.
+// Containers must not outlive the arena.
+template <typename T>
+class monotonic_allocator
+{
+public:
+  using value_type                             = T;
+  using size_type                              = std::size_t;
+  using difference_type                        = std::ptrdiff_t;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap            = std::true_type;
+
+  constexpr monotonic_allocator() noexcept = default;
+  constexpr monotonic_allocator(arena& a) noexcept : m_arena(&a) {}
+
+  template <typename U>
+  constexpr monotonic_allocator(const monotonic_allocator<U>& other) noexcept
+    : m_arena(other.get_arena()) {}
+
+  [[nodiscard]] constexpr T* allocate(std::size_t n)
+  {
+    if (m_arena)
+      return m_arena->allocate<T>(n);
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  constexpr void deallocate(T* p, std::size_t n) noexcept
+  {
+    if (!m_arena)
+      std::allocator<T>{}.deallocate(p, n);
+  }
+
+  constexpr arena* get_arena() const noexcept { return m_arena; }
+
+  template <typename U>
+  friend constexpr bool operator==(const monotonic_allocator& a,
+                                   const monotonic_allocator<U>& b) noexcept
+  {
+    return a.get_arena() == b.get_arena();
+  }
+
+private:
+  arena* m_arena = nullptr;
+};
+
+} // namespace cest
+
+#endif // _CEST_ARENA_HPP_
@@ -107,6 +107,10 @@ public:
   fail() const
   { return (this->rdstate() & (badbit | failbit)) != 0; }
 
+  constexpr bool
+  bad() const
+  { return (this->rdstate() & badbit) != 0; }
+
   constexpr iostate
   exceptions() const
   { return _M_exception; }
@@ -131,10 +135,48 @@ _M_ctype(0), _M_num_put(0), _M_num_get(0)
   tie() const                        
   { return _M_tie; }
 
+  constexpr basic_ostream<_CharT, _Traits>*
+  tie(basic_ostream<_CharT, _Traits>* __tiestr)
+  {
+    basic_ostream<_CharT, _Traits>* __old = _M_tie;
+    _M_tie = __tiestr;
+    return __old;
+  }
+
   constexpr basic_streambuf<_CharT, _Traits>*
   rdbuf() const
   { return _M_streambuf; }
 
+  // As _M_fill isn't mutable, the default (a space) is returned rather than
+  // cached; so this may be called on a const stream in a constant expression
+  constexpr char_type
+  fill() const
+  { return _M_fill_init ? _M_fill : char_type(' '); }
+
+  constexpr char_type
+  fill(char_type __ch)
+  {
+    char_type __old = this->fill();
+    _M_fill = __ch;
+    _M_fill_init = true;
+    return __old;
+  }
+
+  // Without a ctype facet, as in the "C" locale, each char maps to itself
+  constexpr char_type
+  widen(char __c) const
+  { return char_type(__c); }
+
+  constexpr char
+  narrow(char_type __c, char __dfault) const
+  {
+    if constexpr (sizeof(char_type) == sizeof(char))
+      return char(__c);
+    else
+      return __c >= char_type(0) && __c <= char_type(0x7f) ? char(__c)
+                                                           : __dfault;
+  }
+
   constexpr basic_ios()
   : ios_base(), _M_tie(0), _M_fill(char_type()), _M_fill_init(false),
 _M_streambuf(0), _M_ctype(0), _M_num_put(0), _M_num_get(0)
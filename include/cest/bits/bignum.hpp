@@ -0,0 +1,167 @@
+#ifndef _CEST_BIGNUM_HPP_
+#define _CEST_BIGNUM_HPP_
+
+#include <cstdint>     // std::uint32_t, std::uint64_t
+
+namespace cest {
+
+namespace impl {
+
+// An unsigned integer of up to 32 * _Words bits, for the exact conversion of
+// floating-point numbers to and from decimal. Words at and above _M_n are
+// always zero.
+template <int _Words>
+struct __basic_bignum
+{
+  static constexpr int _S_max = _Words;
+
+  std::uint32_t _M_w[_S_max]{};
+  int           _M_n = 0;
+
+  constexpr __basic_bignum() = default;
+
+  constexpr explicit __basic_bignum(std::uint64_t __v)
+  {
+    for (; __v; __v >>= 32)
+      _M_w[_M_n++] = static_cast<std::uint32_t>(__v);
+  }
+
+  constexpr bool _M_is_zero() const { return _M_n == 0; }
+
+  // *this *= 2^__bits
+  constexpr void _M_shl(int __bits)
+  {
+    if (_M_n == 0 || __bits == 0)
+      return;
+    const int __words = __bits / 32, __s = __bits % 32;
+    int __extra = 0;
+    if (__s == 0)
+      for (int __i = _M_n - 1; __i >= 0; --__i)
+        _M_w[__i + __words] = _M_w[__i];
+    else
+    {
+      const std::uint32_t __top = _M_w[_M_n - 1] >> (32 - __s);
+      for (int __i = _M_n - 1; __i > 0; --__i)
+        _M_w[__i + __words] = (_M_w[__i] << __s) | (_M_w[__i - 1] >> (32 - __s));
+      _M_w[__words] = _M_w[0] << __s;
+      if (__top)
+      {
+        _M_w[_M_n + __words] = __top;
+        __extra = 1;
+      }
+    }
+    for (int __i = 0; __i < __words; ++__i)
+      _M_w[__i] = 0;
+    _M_n += __words + __extra;
+  }
+
+  constexpr void _M_add(std::uint32_t __a)
+  {
+    for (int __i = 0; __a; ++__i)
+    {
+      const std::uint64_t __t = std::uint64_t(_M_w[__i]) + __a;
+      _M_w[__i] = static_cast<std::uint32_t>(__t);
+      __a = static_cast<std::uint32_t>(__t >> 32);
+      if (__i == _M_n)
+        ++_M_n;
+    }
+  }
+
+  constexpr void _M_mul(std::uint32_t __m)
+  {
+    std::uint64_t __carry = 0;
+    for (int __i = 0; __i < _M_n; ++__i)
+    {
+      const std::uint64_t __t = std::uint64_t(_M_w[__i]) * __m + __carry;
+      _M_w[__i] = static_cast<std::uint32_t>(__t);
+      __carry = __t >> 32;
+    }
+    if (__carry)
+      _M_w[_M_n++] = static_cast<std::uint32_t>(__carry);
+  }
+
+  // *this *= 10^__e; as 5^__e * 2^__e
+  constexpr void _M_mul_pow10(int __e)
+  {
+    constexpr std::uint32_t __pow5_13 = 1220703125;
+    int __i = __e;
+    for (; __i >= 13; __i -= 13)
+      _M_mul(__pow5_13);
+    std::uint32_t __p = 1;
+    for (; __i > 0; --__i)
+      __p *= 5;
+    _M_mul(__p);
+    _M_shl(__e);
+  }
+
+  constexpr void _M_add(const __basic_bignum& __b)
+  {
+    const int __n = _M_n > __b._M_n ? _M_n : __b._M_n;
+    std::uint64_t __carry = 0;
+    for (int __i = 0; __i < __n; ++__i)
+    {
+      const std::uint64_t __t = std::uint64_t(_M_w[__i]) + __b._M_w[__i] + __carry;
+      _M_w[__i] = static_cast<std::uint32_t>(__t);
+      __carry = __t >> 32;
+    }
+    _M_n = __n;
+    if (__carry)
+      _M_w[_M_n++] = 1;
+  }
+
+  // Requires *this >= __b
+  constexpr void _M_sub(const __basic_bignum& __b)
+  {
+    std::uint64_t __borrow = 0;
+    for (int __i = 0; __i < _M_n; ++__i)
+    {
+      const std::uint64_t __t = std::uint64_t(_M_w[__i]) - __b._M_w[__i] - __borrow;
+      _M_w[__i] = static_cast<std::uint32_t>(__t);
+      __borrow = __t >> 63;
+    }
+    while (_M_n > 0 && _M_w[_M_n - 1] == 0)
+      --_M_n;
+  }
+
+  // *this %= __s; and returns the quotient: a decimal digit, where used below
+  constexpr int _M_divmod(const __basic_bignum& __s)
+  {
+    int __q = 0;
+    while (__compare(*this, __s) >= 0)
+    {
+      _M_sub(__s);
+      ++__q;
+    }
+    return __q;
+  }
+
+  friend constexpr int __compare(const __basic_bignum& __a,
+                                 const __basic_bignum& __b)
+  {
+    if (__a._M_n != __b._M_n)
+      return __a._M_n < __b._M_n ? -1 : 1;
+    for (int __i = __a._M_n - 1; __i >= 0; --__i)
+      if (__a._M_w[__i] != __b._M_w[__i])
+        return __a._M_w[__i] < __b._M_w[__i] ? -1 : 1;
+    return 0;
+  }
+
+  // Compares __a + __b with __c
+  friend constexpr int __compare_sum(const __basic_bignum& __a,
+                                     const __basic_bignum& __b,
+                                     const __basic_bignum& __c)
+  {
+    __basic_bignum __t = __a;
+    __t._M_add(__b);
+    return __compare(__t, __c);
+  }
+};
+
+// Enough for the exact conversion of any double to decimal
+using __bignum = __basic_bignum<40>;
+
+} // namespace impl
+
+} // namespace cest
+
+#endif // _CEST_BIGNUM_HPP_
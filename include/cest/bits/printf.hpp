@@ -0,0 +1,498 @@
+#ifndef _CEST_PRINTF_HPP_
+#define _CEST_PRINTF_HPP_
+
+// The conversions of the printf family, without a locale or an allocation,
+// into a sink of characters. The format string is parsed as the arguments are
+// formatted; so, within a constant expression, a format which is invalid for
+// its arguments is a compile-time error. At runtime it gives -1. A format
+// string may also be checked alone, against the types of the arguments, by
+// __check_printf.
+
+#include "to_chars.hpp" // cest::impl::__uint_to_chars, __fp_formatter
+#include <climits>      // INT_MAX
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uintptr_t
+#include <string>       // std::char_traits
+#include <type_traits>  // std::is_integral_v, std::is_constant_evaluated
+
+namespace cest {
+
+namespace impl {
+
+// Not constexpr: a call within a constant expression reports the error
+inline void __printf_format_error() { }
+
+constexpr int __printf_invalid()
+{
+  if (std::is_constant_evaluated())
+    __printf_format_error();
+  return -1;
+}
+
+// An argument of the printf family. The type is that of the argument, rather
+// than one implied by the conversion; so %d may be given a long long.
+struct __printf_arg
+{
+  enum _Type : unsigned char { _S_int, _S_uint, _S_double, _S_string,
+                               _S_pointer };
+
+  _Type         _M_type = _S_int;
+  unsigned char _M_size = 0;  // of an integer, in bytes
+  union
+  {
+    long long          _M_i;
+    unsigned long long _M_u;
+    double             _M_d;
+    const char*        _M_s;
+    const void*        _M_p;
+  };
+};
+
+template <typename _Tp>
+constexpr __printf_arg
+__make_printf_arg(const _Tp& __x)
+{
+  using _Up = std::remove_cv_t<_Tp>;
+  __printf_arg __a;
+  if constexpr (std::is_integral_v<_Up>)
+  {
+    __a._M_size = sizeof(_Up);
+    if constexpr (std::is_signed_v<_Up>)
+    {
+      __a._M_type = __printf_arg::_S_int;
+      __a._M_i = __x;
+    }
+    else
+    {
+      __a._M_type = __printf_arg::_S_uint;
+      __a._M_u = __x;
+    }
+  }
+  else if constexpr (std::is_floating_point_v<_Up>)
+  {
+    // There is no long double formatter; so the value is that of a double
+    __a._M_type = __printf_arg::_S_double;
+    __a._M_d = static_cast<double>(__x);
+  }
+  else if constexpr (std::is_convertible_v<const _Tp&, const char*>)
+  {
+    __a._M_type = __printf_arg::_S_string;
+    __a._M_s = __x;
+  }
+  else if constexpr (std::is_pointer_v<_Up> || std::is_null_pointer_v<_Up>)
+  {
+    __a._M_type = __printf_arg::_S_pointer;
+    __a._M_p = __x;
+  }
+  else
+    static_assert(sizeof(_Tp) == 0, "an argument of the printf family must "
+                  "be an integer, floating-point number, string or pointer");
+  return __a;
+}
+
+// A conversion specification; as %-08.3hx
+struct __printf_spec
+{
+  bool          _M_left = false;
+  char          _M_plus = 0;      // '+' or ' '
+  bool          _M_alt = false;
+  bool          _M_zero = false;
+  int           _M_width = 0;
+  int           _M_precision = -1;
+  unsigned char _M_length = 0;    // with hh or h, the bytes of the value
+  char          _M_conv = 0;
+};
+
+// Writes the __npre characters of __pre (a sign or base prefix), __zeros
+// zeros, and __n characters of __s; padded with spaces to the width
+template <typename _Sink>
+constexpr std::size_t
+__printf_pad(_Sink& __sink, const __printf_spec& __spec, const char* __pre,
+             std::size_t __npre, std::size_t __zeros, const char* __s,
+             std::size_t __n)
+{
+  const std::size_t __len = __npre + __zeros + __n;
+  const std::size_t __w = static_cast<std::size_t>(__spec._M_width);
+  const std::size_t __pad = __w > __len ? __w - __len : 0;
+  if (__pad && !__spec._M_left)
+    __sink._M_fill(' ', __pad);
+  if (__npre)
+    __sink._M_put(__pre, __npre);
+  if (__zeros)
+    __sink._M_fill('0', __zeros);
+  if (__n)
+    __sink._M_put(__s, __n);
+  if (__pad && __spec._M_left)
+    __sink._M_fill(' ', __pad);
+  return __len + __pad;
+}
+
+// %d %i %u %o %x %X
+template <typename _Sink>
+constexpr std::size_t
+__printf_int(_Sink& __sink, const __printf_spec& __spec,
+             const __printf_arg& __a)
+{
+  const unsigned __size = __spec._M_length ? __spec._M_length : __a._M_size;
+  const unsigned __shift = 64 - 8 * __size;
+  unsigned long long __u = __a._M_type == __printf_arg::_S_int
+                         ? static_cast<unsigned long long>(__a._M_i)
+                         : __a._M_u;
+  __u = __u << __shift >> __shift;   // as the type of __size bytes
+
+  const char __conv = __spec._M_conv;
+  char __pre[2] = {};
+  std::size_t __npre = 0;
+  if (__conv == 'd' || __conv == 'i')
+  {
+    const long long __v = static_cast<long long>(__u << __shift) >> __shift;
+    __u = __v < 0 ? 0 - static_cast<unsigned long long>(__v) : __v;
+    if (__v < 0)
+      __pre[__npre++] = '-';
+    else if (__spec._M_plus)
+      __pre[__npre++] = __spec._M_plus;
+  }
+  else if ((__conv == 'x' || __conv == 'X') && __spec._M_alt && __u != 0)
+  {
+    __pre[__npre++] = '0';
+    __pre[__npre++] = __conv;
+  }
+
+  const unsigned __base = __conv == 'o' ? 8 : __conv == 'x' ||
+                                              __conv == 'X' ? 16 : 10;
+  char __buf[24];
+  char* const __end = __buf + sizeof __buf;
+  char* const __first = __u == 0 && __spec._M_precision == 0
+                      ? __end : __uint_to_chars(__end, __u, __base,
+                                                __conv == 'X');
+  const std::size_t __n = __end - __first;
+  const std::size_t __prec = __spec._M_precision < 0 ? 0 : __spec._M_precision;
+  std::size_t __zeros = __prec > __n ? __prec - __n : 0;
+  if (__conv == 'o' && __spec._M_alt && !__zeros && (!__n || *__first != '0'))
+    __zeros = 1;
+  if (__spec._M_zero && !__spec._M_left && __spec._M_precision < 0)
+  {
+    const std::size_t __len = __npre + __zeros + __n;
+    if (std::size_t(__spec._M_width) > __len)
+      __zeros += __spec._M_width - __len;
+  }
+  return __printf_pad(__sink, __spec, __pre, __npre, __zeros, __first, __n);
+}
+
+// %f %F %e %E %g %G %a %A
+template <typename _Sink>
+constexpr std::size_t
+__printf_float(_Sink& __sink, const __printf_spec& __spec, double __v)
+{
+  const char __conv = __spec._M_conv;
+  __fp_spec __fs;
+  switch (__conv | 0x20)
+  {
+    case 'f': __fs._M_style = __fp_style::fixed; break;
+    case 'e': __fs._M_style = __fp_style::scientific; break;
+    case 'a': __fs._M_style = __fp_style::hex; break;
+    default:  __fs._M_style = __fp_style::general; break;
+  }
+  // Without a precision, %a has every significant digit
+  __fs._M_precision = __spec._M_precision >= 0 ? __spec._M_precision
+                    : __fs._M_style == __fp_style::hex ? -1 : 6;
+  __fs._M_upper = __conv >= 'A' && __conv <= 'Z';
+  __fs._M_alt = __spec._M_alt;
+  __fs._M_plus = __spec._M_plus;
+
+  const __fp_formatter __fmt(__v, __fs);
+  const std::size_t __n = __fmt.size();
+  const std::size_t __w = static_cast<std::size_t>(__spec._M_width);
+  const std::size_t __pad = __w > __n ? __w - __n : 0;
+  // Zeros follow the sign, and the 0x of %a; but inf and nan have spaces
+  const bool __zero = __spec._M_zero && !__spec._M_left && __fmt.finite();
+  if (__pad && !__zero && !__spec._M_left)
+    __sink._M_fill(' ', __pad);
+
+  // The characters are written through a buffer on the stack; however many
+  // there are
+  struct _Chunks
+  {
+    constexpr void _M_flush()
+    {
+      if (_M_len)
+        _M_sink->_M_put(_M_buf, _M_len);
+      _M_len = 0;
+    }
+    constexpr void _M_put(char __c)
+    {
+      if (_M_pos++ == _M_split)
+      {
+        _M_flush();
+        _M_sink->_M_fill('0', _M_zeros);
+      }
+      if (_M_len == sizeof _M_buf)
+        _M_flush();
+      _M_buf[_M_len++] = __c;
+    }
+
+    _Sink* _M_sink;
+    std::size_t _M_split, _M_zeros;
+    std::size_t _M_pos = 0;
+    std::size_t _M_len = 0;
+    char _M_buf[64]{};
+  } __chunks{&__sink, __pad && __zero ? __fmt.prefix_size() : __n, __pad};
+
+  __fmt.write(__put_iterator<_Chunks, char>{&__chunks});
+  __chunks._M_flush();
+  if (__pad && __spec._M_left)
+    __sink._M_fill(' ', __pad);
+  return __n + __pad;
+}
+
+// %p; an address, other than null, has no value within a constant expression
+template <typename _Sink>
+constexpr long long
+__printf_pointer(_Sink& __sink, const __printf_spec& __spec, const void* __p)
+{
+  if (!__p)
+    return __printf_pad(__sink, __spec, nullptr, 0, 0, "(nil)", 5);
+  if (std::is_constant_evaluated())
+    return __printf_invalid();
+  char __buf[16];
+  char* const __end = __buf + sizeof __buf;
+  const char* __first = __uint_to_chars(__end, std::uintptr_t(__p), 16);
+  return __printf_pad(__sink, __spec, "0x", 2, 0, __first, __end - __first);
+}
+
+// Returns the number of characters of one conversion; or -1
+template <typename _Sink>
+constexpr long long
+__printf_convert(_Sink& __sink, const __printf_spec& __spec,
+                 const __printf_arg& __a)
+{
+  const bool __integer = __a._M_type == __printf_arg::_S_int ||
+                         __a._M_type == __printf_arg::_S_uint;
+  switch (__spec._M_conv)
+  {
+    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+      if (!__integer)
+        return __printf_invalid();
+      return __printf_int(__sink, __spec, __a);
+    case 'c':
+    {
+      if (!__integer)
+        return __printf_invalid();
+      const char __c = static_cast<char>(
+        __a._M_type == __printf_arg::_S_int ? __a._M_i : __a._M_u);
+      return __printf_pad(__sink, __spec, nullptr, 0, 0, &__c, 1);
+    }
+    case 'f': case 'F': case 'e': case 'E':
+    case 'g': case 'G': case 'a': case 'A':
+      if (__a._M_type != __printf_arg::_S_double)
+        return __printf_invalid();
+      return __printf_float(__sink, __spec, __a._M_d);
+    case 's':
+    {
+      if (__a._M_type != __printf_arg::_S_string)
+        return __printf_invalid();
+      const int __prec = __spec._M_precision;
+      const char* __s = __a._M_s;
+      if (!__s)
+        __s = __prec >= 0 && __prec < 6 ? "" : "(null)";
+      std::size_t __n = 0;  // the array may have no null within __prec
+      while ((__prec < 0 || __n < std::size_t(__prec)) && __s[__n])
+        ++__n;
+      return __printf_pad(__sink, __spec, nullptr, 0, 0, __s, __n);
+    }
+    case 'p':
+      if (__a._M_type == __printf_arg::_S_pointer)
+        return __printf_pointer(__sink, __spec, __a._M_p);
+      if (__a._M_type == __printf_arg::_S_string)
+        return __printf_pointer(__sink, __spec, __a._M_s);
+      return __printf_invalid();
+    default:  // including %n
+      return __printf_invalid();
+  }
+}
+
+// Reads the integer of a width or precision, which may instead be a *
+// followed by an int argument
+constexpr bool
+__printf_number(const char*& __p, const __printf_arg* __args,
+                std::size_t __nargs, std::size_t& __next, long long& __val)
+{
+  if (*__p == '*')
+  {
+    ++__p;
+    if (__next == __nargs || (__args[__next]._M_type != __printf_arg::_S_int &&
+                              __args[__next]._M_type != __printf_arg::_S_uint))
+      return false;
+    const __printf_arg& __a = __args[__next++];
+    __val = __a._M_type == __printf_arg::_S_int ? __a._M_i
+          : static_cast<long long>(__a._M_u);
+    if (__val < -INT_MAX || __val > INT_MAX)
+      return false;
+    return true;
+  }
+  __val = 0;
+  for (; *__p >= '0' && *__p <= '9'; ++__p)
+  {
+    __val = __val * 10 + (*__p - '0');
+    if (__val > INT_MAX)
+      return false;
+  }
+  return true;
+}
+
+// Formats into __sink, which has _M_put(const char*, size_t) and
+// _M_fill(char, size_t). Returns the number of characters; or -1 if the
+// format is invalid, or the number would exceed INT_MAX.
+template <typename _Sink>
+constexpr int
+__vprintf(_Sink& __sink, const char* __fmt, const __printf_arg* __args,
+          std::size_t __nargs)
+{
+  std::size_t __count = 0;
+  std::size_t __next = 0;
+  for (const char* __p = __fmt; *__p; __fmt = __p)
+  {
+    while (*__p && *__p != '%')
+      ++__p;
+    if (__p != __fmt)
+    {
+      __sink._M_put(__fmt, __p - __fmt);
+      __count += __p - __fmt;
+    }
+    if (!*__p++)
+      break;
+    if (*__p == '%')
+    {
+      __sink._M_put(__p++, 1);
+      ++__count;
+      continue;
+    }
+
+    __printf_spec __spec;
+    for (;; ++__p)
+    {
+      if (*__p == '-')
+        __spec._M_left = true;
+      else if (*__p == '+')
+        __spec._M_plus = '+';
+      else if (*__p == ' ')
+        __spec._M_plus = __spec._M_plus ? __spec._M_plus : ' ';
+      else if (*__p == '#')
+        __spec._M_alt = true;
+      else if (*__p == '0')
+        __spec._M_zero = true;
+      else
+        break;
+    }
+
+    long long __val = 0;
+    if (!__printf_number(__p, __args, __nargs, __next, __val))
+      return __printf_invalid();
+    if (__val < 0)  // from a *
+      __spec._M_left = true;
+    __spec._M_width = static_cast<int>(__val < 0 ? -__val : __val);
+    if (*__p == '.')
+    {
+      ++__p;
+      if (!__printf_number(__p, __args, __nargs, __next, __val))
+        return __printf_invalid();
+      __spec._M_precision = __val < 0 ? -1 : static_cast<int>(__val);
+    }
+
+    // The length of an integer is that of its argument, unless hh or h
+    if (*__p == 'h')
+    {
+      __spec._M_length = __p[1] == 'h' ? 1 : 2;
+      __p += __p[1] == 'h' ? 2 : 1;
+    }
+    else if (*__p == 'l')
+      __p += __p[1] == 'l' ? 2 : 1;
+    else if (*__p == 'j' || *__p == 'z' || *__p == 't' || *__p == 'L')
+      ++__p;
+
+    __spec._M_conv = *__p;
+    if (!*__p++ || __next == __nargs)
+      return __printf_invalid();
+    const long long __n = __printf_convert(__sink, __spec, __args[__next++]);
+    if (__n < 0)
+      return -1;
+    __count += __n;
+  }
+  return __count <= INT_MAX ? static_cast<int>(__count) : -1;
+}
+
+template <typename _Sink, typename... _Args>
+constexpr int
+__printf_to(_Sink& __sink, const char* __fmt, const _Args&... __args)
+{
+  if constexpr (sizeof...(_Args) == 0)
+    return __vprintf(__sink, __fmt, nullptr, 0);
+  else
+  {
+    const __printf_arg __a[] = { __make_printf_arg(__args)... };
+    return __vprintf(__sink, __fmt, __a, sizeof...(_Args));
+  }
+}
+
+// Discards the characters; only their number is of interest
+struct __count_sink
+{
+  constexpr void _M_put(const char*, std::size_t) { }
+  constexpr void _M_fill(char, std::size_t) { }
+};
+
+// An argument of the type _Tp; zero, or a null pointer or string. If _Tp
+// can't be an argument, the call which is checked reports it.
+template <typename _Tp>
+constexpr __printf_arg
+__printf_sample_arg()
+{
+  using _Up = std::remove_cvref_t<_Tp>;
+  if constexpr (std::is_arithmetic_v<_Up> || std::is_pointer_v<_Up> ||
+                std::is_null_pointer_v<_Up>)
+    return __make_printf_arg(_Up{});
+  else if constexpr (std::is_convertible_v<const _Tp&, const char*>)
+    return __make_printf_arg(static_cast<const char*>(nullptr));
+  else
+    return __printf_arg{};
+}
+
+// Formats, and discards, arguments of the types _Args; so that an invalid
+// format for them, evaluated as a constant, is a compile-time error
+template <typename... _Args>
+constexpr void
+__check_printf(const char* __fmt)
+{
+  __count_sink __sink;
+  const __printf_arg __a[] = { __printf_sample_arg<_Args>()..., {} };
+  __vprintf(__sink, __fmt, __a, sizeof...(_Args));
+}
+
+// As snprintf: writes to an array, up to the character before _M_end
+struct __array_sink
+{
+  char* _M_p;
+  char* _M_end;
+
+  constexpr void _M_put(const char* __s, std::size_t __n)
+  {
+    const std::size_t __k = std::size_t(_M_end - _M_p) < __n ? _M_end - _M_p
+                                                             : __n;
+    std::char_traits<char>::copy(_M_p, __s, __k);
+    _M_p += __k;
+  }
+
+  constexpr void _M_fill(char __c, std::size_t __n)
+  {
+    const std::size_t __k = std::size_t(_M_end - _M_p) < __n ? _M_end - _M_p
+                                                             : __n;
+    std::char_traits<char>::assign(_M_p, __k, __c);
+    _M_p += __k;
+  }
+};
+
+} // namespace impl
+
+} // namespace cest
+
+#endif // _CEST_PRINTF_HPP_
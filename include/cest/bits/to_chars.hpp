@@ -0,0 +1,905 @@
+#ifndef _CEST_TO_CHARS_HPP_
+#define _CEST_TO_CHARS_HPP_
+
+// Locale-free conversion of integers and doubles to characters; shared by the
+// formatted output of cest::basic_ostream. Everything here may be used within
+// a constant expression, and gives the same characters at runtime.
+
+#include "bignum.hpp"  // cest::impl::__bignum
+#include <bit>         // std::bit_cast, std::countl_zero
+#include <cstdint>     // std::uint32_t, std::uint64_t
+#include <cstddef>     // std::size_t, std::ptrdiff_t
+#include <iterator>    // std::iterator_traits, std::output_iterator_tag
+#include <type_traits> // std::make_unsigned_t
+
+namespace cest {
+
+namespace impl {
+
+inline constexpr char __digit_pairs[] =
+  "00010203040506070809101112131415161718192021222324252627282930313233343536"
+  "37383940414243444546474849505152535455565758596061626364656667686970717273"
+  "7475767778798081828384858687888990919293949596979899";
+
+// Writes the digits of __u backwards, ending at __end, and returns a pointer
+// to the first. Decimal digits are produced two at a time.
+template <typename _CharT, typename _UValueT>
+constexpr _CharT*
+__uint_to_chars(_CharT* __end, _UValueT __u, unsigned __base = 10,
+                bool __upper = false)
+{
+  const char* __digits = __upper ? "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                 : "0123456789abcdefghijklmnopqrstuvwxyz";
+  if (__base == 10)
+  {
+    while (__u >= 100)
+    {
+      const unsigned __i = static_cast<unsigned>(__u % 100) * 2;
+      __u /= 100;
+      *--__end = _CharT(__digit_pairs[__i + 1]);
+      *--__end = _CharT(__digit_pairs[__i]);
+    }
+    if (__u >= 10)
+    {
+      const unsigned __i = static_cast<unsigned>(__u) * 2;
+      *--__end = _CharT(__digit_pairs[__i + 1]);
+      *--__end = _CharT(__digit_pairs[__i]);
+    }
+    else
+      *--__end = _CharT('0' + static_cast<unsigned>(__u));
+  }
+  else if ((__base & (__base - 1)) == 0)
+  {
+    const int __shift = std::countr_zero(__base);
+    do {
+      *--__end = _CharT(__digits[static_cast<unsigned>(__u) & (__base - 1)]);
+      __u >>= __shift;
+    } while (__u);
+  }
+  else
+  {
+    do {
+      *--__end = _CharT(__digits[static_cast<unsigned>(__u % __base)]);
+      __u /= __base;
+    } while (__u);
+  }
+  return __end;
+}
+
+// The decimal digits of a double: 0.d[0]d[1]...d[n-1] * 10^k; without trailing
+// zeros. Zero has no digits. An exact conversion has at most 767 significant
+// digits; beyond which all are zero.
+struct __fp_digits
+{
+  static constexpr int _S_max = 800;
+
+  char _M_d[_S_max];
+  int  _M_n = 0;
+  int  _M_k = 0;
+
+  constexpr void _M_trim()
+  {
+    while (_M_n > 0 && _M_d[_M_n - 1] == '0')
+      --_M_n;
+  }
+};
+
+// The fields of a finite double: v = f * 2^e
+struct __fp_decoded
+{
+  std::uint64_t _M_f;
+  int           _M_e;
+  bool          _M_neg;
+  bool          _M_normal;
+  bool          _M_lower_closer; // the gap to the next lower double is halved
+};
+
+constexpr __fp_decoded __decode(double __v)
+{
+  const std::uint64_t __bits = std::bit_cast<std::uint64_t>(__v);
+  const std::uint64_t __mant = __bits & ((std::uint64_t(1) << 52) - 1);
+  const int __be = static_cast<int>((__bits >> 52) & 0x7ff);
+  __fp_decoded __d{};
+  __d._M_neg = __bits >> 63;
+  __d._M_normal = __be != 0;
+  if (__be)
+  {
+    __d._M_f = __mant | (std::uint64_t(1) << 52);
+    __d._M_e = __be - 1075;
+  }
+  else
+  {
+    __d._M_f = __mant;
+    __d._M_e = -1074;
+  }
+  __d._M_lower_closer = __mant == 0 && __be > 1;
+  return __d;
+}
+
+// As above; a float's neighbours, and so its shortest digits, are its own
+constexpr __fp_decoded __decode(float __v)
+{
+  const std::uint32_t __bits = std::bit_cast<std::uint32_t>(__v);
+  const std::uint32_t __mant = __bits & ((std::uint32_t(1) << 23) - 1);
+  const int __be = static_cast<int>((__bits >> 23) & 0xff);
+  __fp_decoded __d{};
+  __d._M_neg = __bits >> 31;
+  __d._M_normal = __be != 0;
+  if (__be)
+  {
+    __d._M_f = __mant | (std::uint32_t(1) << 23);
+    __d._M_e = __be - 150;
+  }
+  else
+  {
+    __d._M_f = __mant;
+    __d._M_e = -149;
+  }
+  __d._M_lower_closer = __mant == 0 && __be > 1;
+  return __d;
+}
+
+// ceil(log10(2^__l)); for |__l| < 1650
+constexpr int __ceil_log10_pow2(int __l)
+{
+  if (__l > 0)
+    return ((__l * 78913) >> 18) + 1;
+  return -((-__l * 78913) >> 18);
+}
+
+// Burger and Dybvig's free-format algorithm: the shortest digits which read
+// back as __v; and of those, the closest (or the even, on a tie). Exact,
+// using bignums.
+constexpr void __dragon4_shortest(const __fp_decoded& __v, __fp_digits& __out)
+{
+  const std::uint64_t __f = __v._M_f;
+  const int __e = __v._M_e;
+  const bool __even = (__f & 1) == 0;
+  const int __lc = __v._M_lower_closer;
+  __bignum __r(__f), __s, __mp(1), __mm(1);
+  if (__e >= 0)
+  {
+    __r._M_shl(__e + 1 + __lc);
+    __s = __bignum(2u << __lc);
+    __mp._M_shl(__e + __lc);
+    __mm._M_shl(__e);
+  }
+  else
+  {
+    __r._M_shl(1 + __lc);
+    __s = __bignum(1);
+    __s._M_shl(1 + __lc - __e);
+    __mp._M_shl(__lc);
+  }
+
+  int __k = __ceil_log10_pow2(__e + 63 - std::countl_zero(__f));
+  if (__k >= 0)
+    __s._M_mul_pow10(__k);
+  else
+  {
+    __r._M_mul_pow10(-__k);
+    __mp._M_mul_pow10(-__k);
+    __mm._M_mul_pow10(-__k);
+  }
+  while (__even ? __compare_sum(__r, __mp, __s) >= 0
+                : __compare_sum(__r, __mp, __s) > 0)
+  {
+    __s._M_mul(10);
+    ++__k;
+  }
+
+  int __n = 0;
+  for (;;)
+  {
+    __r._M_mul(10);
+    __mp._M_mul(10);
+    __mm._M_mul(10);
+    int __d = __r._M_divmod(__s);
+    const bool __low  = __even ? __compare(__r, __mm) <= 0
+                               : __compare(__r, __mm) < 0;
+    const bool __high = __even ? __compare_sum(__r, __mp, __s) >= 0
+                               : __compare_sum(__r, __mp, __s) > 0;
+    if (!__low && !__high)
+    {
+      __out._M_d[__n++] = char('0' + __d);
+      continue;
+    }
+    if (__low && __high)
+    {
+      __bignum __r2 = __r;
+      __r2._M_shl(1);
+      const int __c = __compare(__r2, __s);
+      if (__c > 0 || (__c == 0 && (__d & 1)))
+        ++__d;
+    }
+    else if (__high)
+      ++__d;
+    __out._M_d[__n++] = char('0' + __d);
+    break;
+  }
+  __out._M_n = __n;
+  __out._M_k = __k;
+  __out._M_trim();
+}
+
+// The digits of __v correctly rounded (to even, on a tie, as with glibc's
+// printf) to either __count significant digits or, if __fixed, to __count
+// digits after the decimal point.
+constexpr void __dragon4_exact(const __fp_decoded& __v, bool __fixed,
+                               int __count, __fp_digits& __out)
+{
+  __out._M_n = __out._M_k = 0;
+  if (__v._M_f == 0)
+    return;
+
+  __bignum __r(__v._M_f), __s(1);
+  if (__v._M_e >= 0)
+    __r._M_shl(__v._M_e);
+  else
+    __s._M_shl(-__v._M_e);
+
+  int __k = __ceil_log10_pow2(__v._M_e + 63 - std::countl_zero(__v._M_f));
+  if (__k >= 0)
+    __s._M_mul_pow10(__k);
+  else
+    __r._M_mul_pow10(-__k);
+  while (__compare(__r, __s) >= 0)
+  {
+    __s._M_mul(10);
+    ++__k;
+  }
+
+  const int __n = __fixed ? __k + __count : __count;
+  if (__n < 0)
+    return;
+
+  int __i = 0;
+  for (; __i < __n && __i < __fp_digits::_S_max && !__r._M_is_zero(); ++__i)
+  {
+    __r._M_mul(10);
+    __out._M_d[__i] = char('0' + __r._M_divmod(__s));
+  }
+  __out._M_n = __i;
+  __out._M_k = __k;
+
+  if (__i == __n && !__r._M_is_zero())
+  {
+    __r._M_shl(1);
+    const int __c = __compare(__r, __s);
+    const bool __odd = __n > 0 && ((__out._M_d[__n - 1] - '0') & 1);
+    if (__c > 0 || (__c == 0 && __odd))
+    {
+      int __j = __n - 1;
+      while (__j >= 0 && __out._M_d[__j] == '9')
+        --__j;
+      if (__j < 0)
+      {
+        __out._M_d[0] = '1';
+        __out._M_n = 1;
+        ++__out._M_k;
+      }
+      else
+      {
+        ++__out._M_d[__j];
+        __out._M_n = __j + 1;
+      }
+    }
+  }
+  __out._M_trim();
+}
+
+// A 64-bit significand and binary exponent, for the Grisu fast path
+struct __diy_fp
+{
+  std::uint64_t _M_f;
+  int           _M_e;
+};
+
+constexpr __diy_fp __normalize(__diy_fp __x)
+{
+  const int __s = std::countl_zero(__x._M_f);
+  return {__x._M_f << __s, __x._M_e - __s};
+}
+
+// The upper 64 bits of the product, rounded
+constexpr __diy_fp __multiply(__diy_fp __x, __diy_fp __y)
+{
+  constexpr std::uint64_t __m32 = 0xffffffff;
+  const std::uint64_t __a = __x._M_f >> 32, __b = __x._M_f & __m32;
+  const std::uint64_t __c = __y._M_f >> 32, __d = __y._M_f & __m32;
+  const std::uint64_t __ac = __a * __c, __bc = __b * __c;
+  const std::uint64_t __ad = __a * __d, __bd = __b * __d;
+  const std::uint64_t __t = (__bd >> 32) + (__ad & __m32) + (__bc & __m32)
+                          + (std::uint64_t(1) << 31);
+  return {__ac + (__ad >> 32) + (__bc >> 32) + (__t >> 32),
+          __x._M_e + __y._M_e + 64};
+}
+
+struct __cached_power
+{
+  std::uint64_t _M_f;
+  short         _M_e;
+  short         _M_k; // _M_f * 2^_M_e ~= 10^_M_k
+};
+
+// 10^k for every 8th k from -348 to 340; generated with exact arithmetic
+inline constexpr __cached_power __cached_powers[] = {
+  {0xfa8fd5a0081c0288, -1220, -348},
+  {0xbaaee17fa23ebf76, -1193, -340},
+  {0x8b16fb203055ac76, -1166, -332},
+  {0xcf42894a5dce35ea, -1140, -324},
+  {0x9a6bb0aa55653b2d, -1113, -316},
+  {0xe61acf033d1a45df, -1087, -308},
+  {0xab70fe17c79ac6ca, -1060, -300},
+  {0xff77b1fcbebcdc4f, -1034, -292},
+  {0xbe5691ef416bd60c, -1007, -284},
+  {0x8dd01fad907ffc3c,  -980, -276},
+  {0xd3515c2831559a83,  -954, -268},
+  {0x9d71ac8fada6c9b5,  -927, -260},
+  {0xea9c227723ee8bcb,  -901, -252},
+  {0xaecc49914078536d,  -874, -244},
+  {0x823c12795db6ce57,  -847, -236},
+  {0xc21094364dfb5637,  -821, -228},
+  {0x9096ea6f3848984f,  -794, -220},
+  {0xd77485cb25823ac7,  -768, -212},
+  {0xa086cfcd97bf97f4,  -741, -204},
+  {0xef340a98172aace5,  -715, -196},
+  {0xb23867fb2a35b28e,  -688, -188},
+  {0x84c8d4dfd2c63f3b,  -661, -180},
+  {0xc5dd44271ad3cdba,  -635, -172},
+  {0x936b9fcebb25c996,  -608, -164},
+  {0xdbac6c247d62a584,  -582, -156},
+  {0xa3ab66580d5fdaf6,  -555, -148},
+  {0xf3e2f893dec3f126,  -529, -140},
+  {0xb5b5ada8aaff80b8,  -502, -132},
+  {0x87625f056c7c4a8b,  -475, -124},
+  {0xc9bcff6034c13053,  -449, -116},
+  {0x964e858c91ba2655,  -422, -108},
+  {0xdff9772470297ebd,  -396, -100},
+  {0xa6dfbd9fb8e5b88f,  -369,  -92},
+  {0xf8a95fcf88747d94,  -343,  -84},
+  {0xb94470938fa89bcf,  -316,  -76},
+  {0x8a08f0f8bf0f156b,  -289,  -68},
+  {0xcdb02555653131b6,  -263,  -60},
+  {0x993fe2c6d07b7fac,  -236,  -52},
+  {0xe45c10c42a2b3b06,  -210,  -44},
+  {0xaa242499697392d3,  -183,  -36},
+  {0xfd87b5f28300ca0e,  -157,  -28},
+  {0xbce5086492111aeb,  -130,  -20},
+  {0x8cbccc096f5088cc,  -103,  -12},
+  {0xd1b71758e219652c,   -77,   -4},
+  {0x9c40000000000000,   -50,    4},
+  {0xe8d4a51000000000,   -24,   12},
+  {0xad78ebc5ac620000,     3,   20},
+  {0x813f3978f8940984,    30,   28},
+  {0xc097ce7bc90715b3,    56,   36},
+  {0x8f7e32ce7bea5c70,    83,   44},
+  {0xd5d238a4abe98068,   109,   52},
+  {0x9f4f2726179a2245,   136,   60},
+  {0xed63a231d4c4fb27,   162,   68},
+  {0xb0de65388cc8ada8,   189,   76},
+  {0x83c7088e1aab65db,   216,   84},
+  {0xc45d1df942711d9a,   242,   92},
+  {0x924d692ca61be758,   269,  100},
+  {0xda01ee641a708dea,   295,  108},
+  {0xa26da3999aef774a,   322,  116},
+  {0xf209787bb47d6b85,   348,  124},
+  {0xb454e4a179dd1877,   375,  132},
+  {0x865b86925b9bc5c2,   402,  140},
+  {0xc83553c5c8965d3d,   428,  148},
+  {0x952ab45cfa97a0b3,   455,  156},
+  {0xde469fbd99a05fe3,   481,  164},
+  {0xa59bc234db398c25,   508,  172},
+  {0xf6c69a72a3989f5c,   534,  180},
+  {0xb7dcbf5354e9bece,   561,  188},
+  {0x88fcf317f22241e2,   588,  196},
+  {0xcc20ce9bd35c78a5,   614,  204},
+  {0x98165af37b2153df,   641,  212},
+  {0xe2a0b5dc971f303a,   667,  220},
+  {0xa8d9d1535ce3b396,   694,  228},
+  {0xfb9b7cd9a4a7443c,   720,  236},
+  {0xbb764c4ca7a44410,   747,  244},
+  {0x8bab8eefb6409c1a,   774,  252},
+  {0xd01fef10a657842c,   800,  260},
+  {0x9b10a4e5e9913129,   827,  268},
+  {0xe7109bfba19c0c9d,   853,  276},
+  {0xac2820d9623bf429,   880,  284},
+  {0x80444b5e7aa7cf85,   907,  292},
+  {0xbf21e44003acdd2d,   933,  300},
+  {0x8e679c2f5e44ff8f,   960,  308},
+  {0xd433179d9c8cb841,   986,  316},
+  {0x9e19db92b4e31ba9,  1013,  324},
+  {0xeb96bf6ebadf77d9,  1039,  332},
+  {0xaf87023b9bf0ee6b,  1066,  340},
+};
+
+constexpr bool __round_weed(char* __buf, int __n, std::uint64_t __dist_high_w,
+                            std::uint64_t __unsafe, std::uint64_t __rest,
+                            std::uint64_t __ten_kappa, std::uint64_t __unit)
+{
+  const std::uint64_t __small = __dist_high_w - __unit;
+  const std::uint64_t __big   = __dist_high_w + __unit;
+  while (__rest < __small && __unsafe - __rest >= __ten_kappa &&
+         (__rest + __ten_kappa < __small ||
+          __small - __rest >= __rest + __ten_kappa - __small))
+  {
+    --__buf[__n - 1];
+    __rest += __ten_kappa;
+  }
+  if (__rest < __big && __unsafe - __rest >= __ten_kappa &&
+      (__rest + __ten_kappa < __big ||
+       __big - __rest > __rest + __ten_kappa - __big))
+    return false;
+  return 2 * __unit <= __rest && __rest <= __unsafe - 4 * __unit;
+}
+
+// Loitsch's Grisu3: the shortest digits of a positive __v, using only 64-bit
+// arithmetic. It returns false, for about 0.5% of doubles, when it can't be
+// sure that the result is the shortest and closest.
+constexpr bool __grisu3(const __fp_decoded& __v, __fp_digits& __out)
+{
+  const std::uint64_t __f = __v._M_f;
+  const int __e = __v._M_e;
+  const __diy_fp __w  = __normalize({__f, __e});
+  const __diy_fp __mp = __normalize({(__f << 1) + 1, __e - 1});
+  __diy_fp __mm = __v._M_lower_closer ? __diy_fp{(__f << 2) - 1, __e - 2}
+                                      : __diy_fp{(__f << 1) - 1, __e - 1};
+  __mm._M_f <<= __mm._M_e - __mp._M_e;
+  __mm._M_e = __mp._M_e;
+
+  // A power of ten, c, such that -60 <= w.e + c.e + 64 <= -32
+  const int __min_e = -60 - (__w._M_e + 64), __max_e = -32 - (__w._M_e + 64);
+  constexpr int __last = sizeof(__cached_powers) / sizeof(__cached_powers[0]) - 1;
+  int __i = (__ceil_log10_pow2(__min_e + 63) + 347) / 8 + 1;
+  __i = __i < 0 ? 0 : __i > __last ? __last : __i;
+  while (__i > 0 && __cached_powers[__i]._M_e > __max_e)
+    --__i;
+  while (__i < __last && __cached_powers[__i]._M_e < __min_e)
+    ++__i;
+  const __cached_power& __cp = __cached_powers[__i];
+  const __diy_fp __c{__cp._M_f, __cp._M_e};
+
+  const __diy_fp __sw = __multiply(__w, __c);
+  const __diy_fp __low = __multiply(__mm, __c);
+  const __diy_fp __high = __multiply(__mp, __c);
+
+  // from double-conversion's DigitGen
+  std::uint64_t __unit = 1;
+  const std::uint64_t __too_low = __low._M_f - __unit;
+  const std::uint64_t __too_high = __high._M_f + __unit;
+  std::uint64_t __unsafe = __too_high - __too_low;
+  const int __shift = -__sw._M_e;
+  const std::uint64_t __one = std::uint64_t(1) << __shift;
+  std::uint32_t __integrals = static_cast<std::uint32_t>(__too_high >> __shift);
+  std::uint64_t __fractionals = __too_high & (__one - 1);
+
+  std::uint32_t __divisor = 1;
+  int __kappa = 0;
+  if (__integrals)
+  {
+    __kappa = 1;
+    while (__integrals / __divisor >= 10)
+    {
+      __divisor *= 10;
+      ++__kappa;
+    }
+  }
+
+  char* const __buf = __out._M_d;
+  int __n = 0;
+  bool __ok = false;
+  while (__kappa > 0)
+  {
+    __buf[__n++] = char('0' + __integrals / __divisor);
+    __integrals %= __divisor;
+    --__kappa;
+    const std::uint64_t __rest = (std::uint64_t(__integrals) << __shift)
+                               + __fractionals;
+    if (__rest < __unsafe)
+    {
+      __ok = __round_weed(__buf, __n, __too_high - __sw._M_f, __unsafe, __rest,
+                          std::uint64_t(__divisor) << __shift, __unit);
+      break;
+    }
+    __divisor /= 10;
+  }
+  if (__kappa == 0 && !__ok && (__n == 0 || __divisor == 0 ||
+      ((std::uint64_t(__integrals) << __shift) + __fractionals) >= __unsafe))
+  {
+    for (;;)
+    {
+      __fractionals *= 10;
+      __unit *= 10;
+      __unsafe *= 10;
+      __buf[__n++] = char('0' + (__fractionals >> __shift));
+      __fractionals &= __one - 1;
+      --__kappa;
+      if (__fractionals < __unsafe)
+      {
+        __ok = __round_weed(__buf, __n, (__too_high - __sw._M_f) * __unit,
+                            __unsafe, __fractionals, __one, __unit);
+        break;
+      }
+    }
+  }
+  if (!__ok)
+    return false;
+  __out._M_n = __n;
+  __out._M_k = __n + __kappa - __cp._M_k;
+  __out._M_trim();
+  return true;
+}
+
+// The shortest digits which read back as the positive, finite __v
+constexpr void __shortest_digits(const __fp_decoded& __v, __fp_digits& __out)
+{
+  if (!__grisu3(__v, __out))
+    __dragon4_shortest(__v, __out);
+}
+
+// As __dragon4_exact. For a normal double, when the shortest digits are no
+// more than those requested, and 15 or fewer are, they are already correctly
+// rounded; and are found without bignums.
+constexpr void __exact_digits(const __fp_decoded& __v, bool __fixed,
+                              int __count, __fp_digits& __out)
+{
+  if (__v._M_normal)
+  {
+    __shortest_digits(__v, __out);
+    const int __sig = __fixed ? __out._M_k + __count : __count;
+    if (__sig >= 1 && __sig <= 15 && __out._M_n <= __sig)
+      return;
+  }
+  __dragon4_exact(__v, __fixed, __count, __out);
+}
+
+// shortest is std::to_chars(first, last, value): the shortest digits, as
+// fixed or scientific; whichever is shorter, or fixed on a tie
+enum class __fp_style : unsigned char
+{ general, fixed, scientific, hex, shortest };
+
+struct __fp_spec
+{
+  __fp_style _M_style = __fp_style::general;
+  int  _M_precision = -1; // if negative: the shortest which reads back as
+                          // the value; or, with hex, every significant digit
+  bool _M_upper = false;
+  bool _M_alt = false;    // as printf's # flag: keep the point (and, with
+                          // general, trailing zeros)
+  char _M_plus = 0;       // the sign of non-negative values: 0, '+' or ' '
+  bool _M_prefix = true;  // hex: a leading 0x, as printf; not as to_chars
+};
+
+// An output iterator; each character assigned is passed to _M_put of _M_sink
+template <typename _Sink, typename _CharT>
+struct __put_iterator
+{
+  using iterator_category = std::output_iterator_tag;
+  using value_type = _CharT;
+  using difference_type = std::ptrdiff_t;
+  using pointer = void;
+  using reference = void;
+
+  constexpr __put_iterator& operator*() { return *this; }
+  constexpr __put_iterator& operator++() { return *this; }
+  constexpr __put_iterator& operator++(int) { return *this; }
+  constexpr __put_iterator& operator=(_CharT __c)
+  {
+    _M_sink->_M_put(__c);
+    return *this;
+  }
+
+  _Sink* _M_sink;
+};
+
+// Formats a double as would printf's %f %e %g or %a, given the precision;
+// or with the shortest digits. size() is known before the characters are
+// written, so that a caller can pad the output or allocate for it.
+class __fp_formatter
+{
+public:
+  constexpr __fp_formatter(double __val, const __fp_spec& __spec)
+  : __fp_formatter(__val, __spec, false)
+  { }
+
+  // The shortest digits are those which read back as the float
+  constexpr __fp_formatter(float __val, const __fp_spec& __spec)
+  : __fp_formatter(__val, __spec, true)
+  { }
+
+  constexpr std::size_t size() const { return _M_size; }
+
+  // False for an infinity or a NaN; which aren't padded with zeros
+  constexpr bool finite() const { return _M_kind < _S_inf; }
+
+  // The characters which precede any padding added by ios_base::internal:
+  // a sign, then any 0x or 0X
+  constexpr std::size_t prefix_size() const
+  { return (_M_sign != 0) + (_M_kind == _S_hex && _M_prefix ? 2 : 0); }
+
+  // Writes size() characters to __out; a pointer, or an output iterator with
+  // a value_type
+  template <typename _OutIt>
+  constexpr _OutIt write(_OutIt __out) const
+  {
+    using _CharT = typename std::iterator_traits<_OutIt>::value_type;
+    if (_M_sign)
+      *__out++ = _CharT(_M_sign);
+    switch (_M_kind)
+    {
+      case _S_nan: return _M_write_text(__out, _M_upper ? "NAN" : "nan");
+      case _S_inf: return _M_write_text(__out, _M_upper ? "INF" : "inf");
+      case _S_hex: return _M_write_hex(__out);
+      case _S_fixed: return _M_write_fixed(__out);
+      default: return _M_write_scientific(__out);
+    }
+  }
+
+private:
+  enum _Kind : unsigned char { _S_fixed, _S_scientific, _S_hex, _S_inf, _S_nan };
+
+  constexpr __fp_formatter(double __val, const __fp_spec& __spec, bool __float)
+  : _M_upper(__spec._M_upper), _M_alt(__spec._M_alt),
+    _M_prefix(__spec._M_prefix)
+  {
+    const __fp_decoded __v = __decode(__val);
+    _M_sign = __v._M_neg ? '-' : __spec._M_plus;
+    const std::uint64_t __bits = std::bit_cast<std::uint64_t>(__val);
+    if (((__bits >> 52) & 0x7ff) == 0x7ff)
+    {
+      const bool __nan = __bits & ((std::uint64_t(1) << 52) - 1);
+      _M_kind = __nan ? _S_nan : _S_inf;
+      _M_size = 3;
+    }
+    else if (__spec._M_style == __fp_style::hex)
+      _M_init_hex(__float ? __decode(float(__val)) : __v, __spec._M_precision,
+                  __float);
+    else
+      _M_init_decimal(__v, __float ? __decode(float(__val)) : __v, __spec);
+    _M_size += _M_sign != 0;
+  }
+
+  constexpr char _M_digit(int __i) const
+  { return __i < 0 || __i >= _M_dig._M_n ? '0' : _M_dig._M_d[__i]; }
+
+  static constexpr int _S_exp_len(int __e, int __min)
+  {
+    int __n = 1;
+    for (__e = __e < 0 ? -__e : __e; __e >= 10; __e /= 10)
+      ++__n;
+    return __n < __min ? __min : __n;
+  }
+
+  // The shortest digits are those of __vs; exact digits, those of __v
+  constexpr void _M_init_decimal(const __fp_decoded& __v,
+                                 const __fp_decoded& __vs,
+                                 const __fp_spec& __spec)
+  {
+    const int __p = __spec._M_precision;
+    const bool __zero = __v._M_f == 0;
+    bool __strip = false;
+    switch (__spec._M_style)
+    {
+      case __fp_style::fixed:
+        _M_kind = _S_fixed;
+        if (__p < 0) {
+          if (!__zero) __shortest_digits(__vs, _M_dig);
+          _M_frac = _M_dig._M_n - _M_dig._M_k;
+        }
+        else {
+          __exact_digits(__v, true, __p, _M_dig);
+          _M_frac = __p;
+        }
+        break;
+      case __fp_style::scientific:
+        _M_kind = _S_scientific;
+        if (__p < 0) {
+          if (!__zero) __shortest_digits(__vs, _M_dig);
+          _M_frac = _M_dig._M_n - 1;
+        }
+        else {
+          __exact_digits(__v, false, __p + 1, _M_dig);
+          _M_frac = __p;
+        }
+        break;
+      case __fp_style::shortest:
+        if (__p < 0) {
+          if (!__zero) __shortest_digits(__vs, _M_dig);
+          const int __n = _M_dig._M_n, __k = _M_dig._M_k;
+          const int __fixed = __n == 0 ? 1 : __k >= __n ? __k
+                            : __k > 0 ? __n + 1 : 2 - __k + __n;
+          const int __sci = __n + (__n > 1) + 2 + _S_exp_len(__k - 1, 2);
+          _M_kind = __fixed <= __sci ? _S_fixed : _S_scientific;
+          _M_frac = _M_kind == _S_fixed ? __n - __k : __n - 1;
+          break;
+        }
+        [[fallthrough]]; // with a precision, as general
+      default:
+      {
+        // As std::to_chars, the shortest digits are fixed if, with %g's
+        // default precision of 6, they would be
+        int __prec = __p, __limit = __p;
+        if (__p < 0) {
+          if (!__zero) __shortest_digits(__vs, _M_dig);
+          __prec = _M_dig._M_n;
+          __limit = 6;
+        }
+        else
+          __exact_digits(__v, false, __p == 0 ? 1 : __p, _M_dig);
+        if (__prec == 0)
+          __prec = 1;
+        if (__limit == 0)
+          __limit = 1;
+        const int __x = _M_dig._M_n ? _M_dig._M_k - 1 : 0;
+        if (__limit > __x && __x >= -4) {
+          _M_kind = _S_fixed;
+          _M_frac = __prec - 1 - __x;
+        }
+        else {
+          _M_kind = _S_scientific;
+          _M_frac = __prec - 1;
+        }
+        __strip = !__spec._M_alt;
+      }
+    }
+    if (_M_frac < 0)
+      _M_frac = 0;
+    // As %f, the shortest digits of an integer are its exact digits; rather
+    // than digits padded with zeros
+    if (_M_kind == _S_fixed && __p < 0 && _M_dig._M_k > _M_dig._M_n)
+      __exact_digits(__v, true, 0, _M_dig);
+
+    const int __n = _M_dig._M_n, __k = _M_dig._M_k;
+    if (_M_kind == _S_fixed)
+    {
+      if (__strip) {
+        const int __f = __n - __k;
+        _M_frac = __f < 0 ? 0 : __f < _M_frac ? __f : _M_frac;
+      }
+      _M_int = __n && __k > 0 ? __k : 1;
+      _M_size = _M_int;
+    }
+    else
+    {
+      if (__strip) {
+        const int __f = __n - 1;
+        _M_frac = __f < 0 ? 0 : __f < _M_frac ? __f : _M_frac;
+      }
+      _M_exp = __n ? __k - 1 : 0;
+      _M_size = 1 + 2 + _S_exp_len(_M_exp, 2);
+    }
+    _M_size += _M_frac + (_M_frac > 0 || _M_alt);
+  }
+
+  // A float has 23 fraction bits: 6 hex digits, the last of them padded
+  constexpr void _M_init_hex(const __fp_decoded& __v, int __p, bool __float)
+  {
+    const int __bits = __float ? 23 : 52;
+    const int __digits = __float ? 6 : 13;
+    _M_kind = _S_hex;
+    std::uint64_t __mant = (__v._M_f & ((std::uint64_t(1) << __bits) - 1))
+                         << (4 * __digits - __bits);
+    _M_lead = __v._M_normal ? 1 : 0;
+    _M_exp = __v._M_normal ? __v._M_e + __bits
+                           : __mant ? (__float ? -126 : -1022) : 0;
+    _M_frac = __digits;
+    if (__p >= 0 && __p < __digits)
+    {
+      const int __shift = 4 * (__digits - __p);
+      const std::uint64_t __rem = __mant & ((std::uint64_t(1) << __shift) - 1);
+      const std::uint64_t __half = std::uint64_t(1) << (__shift - 1);
+      __mant >>= __shift;
+      const bool __odd = __p == 0 ? _M_lead & 1 : __mant & 1;
+      if (__rem > __half || (__rem == __half && __odd))
+      {
+        ++__mant;
+        if (__mant >> (4 * __p))
+        {
+          ++_M_lead;
+          __mant &= (std::uint64_t(1) << (4 * __p)) - 1;
+        }
+      }
+      _M_frac = __p;
+    }
+    else if (__p < 0)
+      for (; _M_frac > 0 && (__mant & 0xf) == 0; --_M_frac)
+        __mant >>= 4;
+    _M_mant = __mant;
+    _M_hex_zeros = __p > __digits ? __p - __digits : 0;
+    _M_size = 2 * _M_prefix + 1 + (_M_frac + _M_hex_zeros > 0 || _M_alt)
+            + _M_frac + _M_hex_zeros + 2 + _S_exp_len(_M_exp, 1);
+  }
+
+  template <typename _OutIt>
+  static constexpr _OutIt _M_write_text(_OutIt __out, const char* __s)
+  {
+    using _CharT = typename std::iterator_traits<_OutIt>::value_type;
+    while (*__s)
+      *__out++ = _CharT(*__s++);
+    return __out;
+  }
+
+  template <typename _OutIt>
+  constexpr _OutIt _M_write_exp(_OutIt __out, char __c, int __min) const
+  {
+    using _CharT = typename std::iterator_traits<_OutIt>::value_type;
+    *__out++ = _CharT(_M_upper ? __c - 'a' + 'A' : __c);
+    *__out++ = _CharT(_M_exp < 0 ? '-' : '+');
+    const unsigned __e = _M_exp < 0 ? -_M_exp : _M_exp;
+    char __buf[8];
+    const char* __first = __uint_to_chars(__buf + 8, __e);
+    if (__e < 10 && __min == 2)
+      *__out++ = _CharT('0');
+    for (; __first != __buf + 8; ++__first)
+      *__out++ = _CharT(*__first);
+    return __out;
+  }
+
+  template <typename _OutIt>
+  constexpr _OutIt _M_write_fixed(_OutIt __out) const
+  {
+    using _CharT = typename std::iterator_traits<_OutIt>::value_type;
+    if (_M_dig._M_n && _M_dig._M_k > 0)
+      for (int __i = 0; __i < _M_int; ++__i)
+        *__out++ = _CharT(_M_digit(__i));
+    else
+      *__out++ = _CharT('0');
+    if (_M_frac > 0 || _M_alt)
+      *__out++ = _CharT('.');
+    for (int __j = 0; __j < _M_frac; ++__j)
+      *__out++ = _CharT(_M_digit(_M_dig._M_k + __j));
+    return __out;
+  }
+
+  template <typename _OutIt>
+  constexpr _OutIt _M_write_scientific(_OutIt __out) const
+  {
+    using _CharT = typename std::iterator_traits<_OutIt>::value_type;
+    *__out++ = _CharT(_M_digit(0));
+    if (_M_frac > 0 || _M_alt)
+      *__out++ = _CharT('.');
+    for (int __j = 1; __j <= _M_frac; ++__j)
+      *__out++ = _CharT(_M_digit(__j));
+    return _M_write_exp(__out, 'e', 2);
+  }
+
+  template <typename _OutIt>
+  constexpr _OutIt _M_write_hex(_OutIt __out) const
+  {
+    using _CharT = typename std::iterator_traits<_OutIt>::value_type;
+    const char* __digits = _M_upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    if (_M_prefix)
+    {
+      *__out++ = _CharT('0');
+      *__out++ = _CharT(_M_upper ? 'X' : 'x');
+    }
+    *__out++ = _CharT(__digits[_M_lead]);
+    if (_M_frac + _M_hex_zeros > 0 || _M_alt)
+      *__out++ = _CharT('.');
+    for (int __i = _M_frac - 1; __i >= 0; --__i)
+      *__out++ = _CharT(__digits[(_M_mant >> (4 * __i)) & 0xf]);
+    for (int __i = 0; __i < _M_hex_zeros; ++__i)
+      *__out++ = _CharT('0');
+    return _M_write_exp(__out, 'p', 1);
+  }
+
+  __fp_digits   _M_dig;
+  std::size_t   _M_size = 0;
+  _Kind         _M_kind = _S_fixed;
+  char          _M_sign = 0;
+  bool          _M_upper;
+  bool          _M_alt;
+  bool          _M_prefix;
+  int           _M_int = 0;  // fixed: the digits before the point
+  int           _M_frac = 0; // the digits after the point
+  int           _M_exp = 0;
+  int           _M_lead = 0; // hex: the digit before the point
+  int           _M_hex_zeros = 0;
+  std::uint64_t _M_mant = 0;
+};
+
+} // namespace impl
+
+} // namespace cest
+
+#endif // _CEST_TO_CHARS_HPP_
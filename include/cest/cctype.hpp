@@ -1,23 +1,195 @@
 #ifndef _CEST_CCTYPE_HPP_
 #define _CEST_CCTYPE_HPP_
 
-#include "cest/string.hpp"
-#include <algorithm>
+// Classification as in the "C" locale. Each function looks up one entry of
+// a 256-entry table of masks; which has the bit values of glibc's table, so
+// a non-zero result is as from glibc (e.g. 8 from isalnum).
+
+#include <array>
+#include <cstring>      // std::memcpy
+#include <cstdint>      // std::uint64_t
+#include <type_traits>  // std::is_constant_evaluated
 
 namespace cest {
 
-// returns 8 (non-zero) on a successful find; as do libstdc++ and libc++
-constexpr int isalnum(int ch) {
-  string str("0123456789"
-             "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-             "abcdefghijklmnopqrstuvwxyz"); // a raw string array includes \0
-  return std::find(str.cbegin(), str.cend(), ch) != str.cend() ? 8 : 0;
+// As std::ctype_base; with the values of the glibc _IS* bits
+struct ctype_base
+{
+  typedef unsigned short mask;
+  static constexpr mask upper  = 1 << 8;
+  static constexpr mask lower  = 1 << 9;
+  static constexpr mask alpha  = 1 << 10;
+  static constexpr mask digit  = 1 << 11;
+  static constexpr mask xdigit = 1 << 12;
+  static constexpr mask space  = 1 << 13;
+  static constexpr mask print  = 1 << 14;
+  static constexpr mask graph  = 1 << 15;
+  static constexpr mask blank  = 1 << 0;
+  static constexpr mask cntrl  = 1 << 1;
+  static constexpr mask punct  = 1 << 2;
+  static constexpr mask alnum  = 1 << 3;
+};
+
+namespace impl {
+
+constexpr std::array<ctype_base::mask, 256> __make_ctype_table()
+{
+  using __b = ctype_base;
+  std::array<ctype_base::mask, 256> __t{};
+  for (int __c = 0; __c < 128; ++__c)
+  {
+    ctype_base::mask __m = 0;
+    const bool __up = __c >= 'A' && __c <= 'Z';
+    const bool __lo = __c >= 'a' && __c <= 'z';
+    const bool __dig = __c >= '0' && __c <= '9';
+    if (__up)  __m |= __b::upper;
+    if (__lo)  __m |= __b::lower;
+    if (__up || __lo) __m |= __b::alpha | __b::alnum;
+    if (__dig) __m |= __b::digit | __b::alnum;
+    if (__dig || (__c >= 'A' && __c <= 'F') || (__c >= 'a' && __c <= 'f'))
+      __m |= __b::xdigit;
+    if (__c == ' ' || (__c >= '\t' && __c <= '\r')) __m |= __b::space;
+    if (__c == ' ' || __c == '\t') __m |= __b::blank;
+    if (__c < ' ' || __c == 0x7f) __m |= __b::cntrl;
+    if (__c >= ' ' && __c < 0x7f)  __m |= __b::print;
+    if (__c > ' ' && __c < 0x7f)   __m |= __b::graph;
+    if (__c > ' ' && __c < 0x7f && !__up && !__lo && !__dig)
+      __m |= __b::punct;
+    __t[__c] = __m;
+  }
+  return __t;  // no character above 0x7f is classified
+}
+
+inline constexpr std::array<ctype_base::mask, 256> __ctype_table =
+  __make_ctype_table();
+
+// EOF, and any other value outside of unsigned char, has no class
+constexpr ctype_base::mask __ctype_lookup(int __ch)
+{
+  return static_cast<unsigned>(__ch) < 256 ? __ctype_table[__ch] : 0;
+}
+
+#if defined(__GNUC__)
+// 16 bytes at a time; at runtime. Each lane of the result is all ones if its
+// character has a class in __m. A character's classes are unions of ranges,
+// each tested with one unsigned subtraction and comparison.
+typedef unsigned char __ctype_v16 __attribute__((vector_size(16)));
+typedef signed char   __ctype_b16 __attribute__((vector_size(16)));
+
+inline __ctype_b16 __ctype_in(__ctype_v16 __v, unsigned char __lo,
+                              unsigned char __hi)
+{
+  return (__ctype_b16)((__ctype_v16)(__v - __lo) <= (unsigned char)(__hi - __lo));
+}
+
+inline __ctype_b16 __ctype_match16(__ctype_v16 __v, ctype_base::mask __m)
+{
+  using __b = ctype_base;
+  __ctype_b16 __r{};
+  if (__m & (__b::upper | __b::alpha | __b::alnum))
+    __r |= __ctype_in(__v, 'A', 'Z');
+  if (__m & (__b::lower | __b::alpha | __b::alnum))
+    __r |= __ctype_in(__v, 'a', 'z');
+  if (__m & (__b::digit | __b::xdigit | __b::alnum))
+    __r |= __ctype_in(__v, '0', '9');
+  if (__m & __b::xdigit)
+    __r |= __ctype_in(__v, 'A', 'F') | __ctype_in(__v, 'a', 'f');
+  if (__m & (__b::space | __b::blank))
+    __r |= __v == ' ';
+  if (__m & __b::space)
+    __r |= __ctype_in(__v, '\t', '\r');
+  if (__m & __b::blank)
+    __r |= __v == '\t';
+  if (__m & __b::cntrl)
+    __r |= __ctype_in(__v, 0, 0x1f) | (__v == 0x7f);
+  if (__m & __b::print)
+    __r |= __ctype_in(__v, ' ', 0x7e);
+  if (__m & __b::graph)
+    __r |= __ctype_in(__v, '!', 0x7e);
+  if (__m & __b::punct)
+    __r |= __ctype_in(__v, '!', '/') | __ctype_in(__v, ':', '@') |
+           __ctype_in(__v, '[', '`') | __ctype_in(__v, '{', '~');
+  return __r;
+}
+
+// The first character from __lo, with (__is) or without a class in __m
+inline const char*
+__ctype_scan16(ctype_base::mask __m, const char* __lo, const char* __hi,
+               bool __is)
+{
+  for (; __hi - __lo >= 16; __lo += 16)
+  {
+    __ctype_v16 __v;
+    std::memcpy(&__v, __lo, 16);
+    __ctype_b16 __r = __ctype_match16(__v, __m);
+    if (!__is)
+      __r = ~__r;
+    std::uint64_t __w[2];
+    std::memcpy(__w, &__r, 16);
+    if (__w[0] | __w[1])
+      break;  // a match is within these 16; find it below
+  }
+  return __lo;
+}
+#endif
+
+} // namespace impl
+
+// returns 8 (non-zero) for an alphanumeric; as do libstdc++ and libc++
+constexpr int isalnum(int ch)  { return impl::__ctype_lookup(ch) & ctype_base::alnum; }
+constexpr int isalpha(int ch)  { return impl::__ctype_lookup(ch) & ctype_base::alpha; }
+constexpr int isblank(int ch)  { return impl::__ctype_lookup(ch) & ctype_base::blank; }
+constexpr int iscntrl(int ch)  { return impl::__ctype_lookup(ch) & ctype_base::cntrl; }
+constexpr int isdigit(int ch)  { return impl::__ctype_lookup(ch) & ctype_base::digit; }
+constexpr int isgraph(int ch)  { return impl::__ctype_lookup(ch) & ctype_base::graph; }
+constexpr int islower(int ch)  { return impl::__ctype_lookup(ch) & ctype_base::lower; }
+constexpr int isprint(int ch)  { return impl::__ctype_lookup(ch) & ctype_base::print; }
+constexpr int ispunct(int ch)  { return impl::__ctype_lookup(ch) & ctype_base::punct; }
+constexpr int isspace(int ch)  { return impl::__ctype_lookup(ch) & ctype_base::space; }
+// returns 256 (non-zero) for an upper case letter; as do libstdc++ and libc++
+constexpr int isupper(int ch)  { return impl::__ctype_lookup(ch) & ctype_base::upper; }
+constexpr int isxdigit(int ch) { return impl::__ctype_lookup(ch) & ctype_base::xdigit; }
+
+constexpr int tolower(int ch) { return ch >= 'A' && ch <= 'Z' ? ch + ('a' - 'A') : ch; }
+constexpr int toupper(int ch) { return ch >= 'a' && ch <= 'z' ? ch - ('a' - 'A') : ch; }
+
+// Bulk classification of a range; as the members of std::ctype<char>
+
+// Stores the mask of each character in [__lo,__hi) to __vec
+constexpr const char*
+is(const char* __lo, const char* __hi, ctype_base::mask* __vec)
+{
+  for (; __lo < __hi; ++__lo, ++__vec)
+    *__vec = impl::__ctype_table[static_cast<unsigned char>(*__lo)];
+  return __hi;
+}
+
+// The first character in [__lo,__hi) with a class in __m; or __hi
+constexpr const char*
+scan_is(ctype_base::mask __m, const char* __lo, const char* __hi)
+{
+#if defined(__GNUC__)
+  if (!std::is_constant_evaluated())
+    __lo = impl::__ctype_scan16(__m, __lo, __hi, true);
+#endif
+  while (__lo < __hi &&
+         !(impl::__ctype_table[static_cast<unsigned char>(*__lo)] & __m))
+    ++__lo;
+  return __lo;
 }
 
-// returns 256 (non-zero) on a successful find; as do libstdc++ and libc++
-constexpr int isupper(int ch) {
-  string str("ABCDEFGHIJKLMNOPQRSTUVWXYZ");
-  return std::find(str.cbegin(), str.cend(), ch) != str.cend() ? 256 : 0;
+// The first character in [__lo,__hi) with no class in __m; or __hi
+constexpr const char*
+scan_not(ctype_base::mask __m, const char* __lo, const char* __hi)
+{
+#if defined(__GNUC__)
+  if (!std::is_constant_evaluated())
+    __lo = impl::__ctype_scan16(__m, __lo, __hi, false);
+#endif
+  while (__lo < __hi &&
+         (impl::__ctype_table[static_cast<unsigned char>(*__lo)] & __m))
+    ++__lo;
+  return __lo;
 }
 
 } // namespace cest
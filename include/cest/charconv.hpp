@@ -0,0 +1,393 @@
+#ifndef _CEST_CHARCONV_HPP_
+#define _CEST_CHARCONV_HPP_
+
+// A constexpr <charconv>: to_chars and from_chars for the integer types, and
+// for float and double; over bits/to_chars.hpp and bits/from_chars.hpp, as are
+// cest's ostream, istream, printf and format. The result types, and
+// chars_format, are those of std. Output is as libstdc++'s: the shortest
+// representation which reads back as the value, unless a precision is given;
+// input is correctly rounded.
+
+#include "bits/to_chars.hpp"   // cest::impl::__uint_to_chars, __fp_formatter
+#include "bits/from_chars.hpp" // cest::impl::__fp_scanner, __digit_value
+#include <bit>                 // std::bit_cast, std::bit_width
+#include <charconv>            // std::chars_format, std::to_chars_result
+#include <cstdint>             // std::uint64_t
+#include <limits>              // std::numeric_limits
+#include <system_error>        // std::errc
+#include <type_traits>         // std::is_integral_v, std::make_unsigned_t
+
+namespace cest {
+
+using std::chars_format;
+using std::to_chars_result;
+using std::from_chars_result;
+
+namespace impl {
+
+template <typename _Tp>
+concept __charconv_integer = std::is_integral_v<_Tp> &&
+                             !std::is_same_v<std::remove_cv_t<_Tp>, bool>;
+
+template <typename _Tp>
+concept __charconv_float = std::is_same_v<_Tp, float> ||
+                           std::is_same_v<_Tp, double>;
+
+// The number of digits of __u in base __base; found four at a time
+template <typename _UValueT>
+constexpr unsigned __to_chars_len(_UValueT __u, unsigned __base)
+{
+  const unsigned long __b2 = __base * __base;
+  const unsigned long __b3 = __b2 * __base;
+  const unsigned long __b4 = __b3 * __base;
+  for (unsigned __n = 1; ; __n += 4)
+  {
+    if (__u < __base) return __n;
+    if (__u < __b2) return __n + 1;
+    if (__u < __b3) return __n + 2;
+    if (__u < __b4) return __n + 3;
+    __u /= __b4;
+  }
+}
+
+constexpr __fp_spec __to_chars_spec(chars_format __fmt, int __precision)
+{
+  __fp_spec __spec;
+  switch (__fmt)
+  {
+    case chars_format::fixed:      __spec._M_style = __fp_style::fixed; break;
+    case chars_format::scientific: __spec._M_style = __fp_style::scientific;
+                                   break;
+    case chars_format::hex:        __spec._M_style = __fp_style::hex; break;
+    default:                       __spec._M_style = __fp_style::general;
+  }
+  __spec._M_precision = __precision;
+  __spec._M_prefix = false;
+  return __spec;
+}
+
+template <typename _Tp>
+constexpr to_chars_result
+__fp_to_chars(char* __first, char* __last, _Tp __value, const __fp_spec& __spec)
+{
+  const __fp_formatter __fmt(__value, __spec);
+  if (static_cast<std::size_t>(__last - __first) < __fmt.size())
+    return {__last, std::errc::value_too_large};
+  return {__fmt.write(__first), std::errc{}};
+}
+
+// Matches __s, ignoring case; returning the end of the match, or nullptr
+constexpr const char*
+__match_nocase(const char* __first, const char* __last, const char* __s)
+{
+  for (; *__s; ++__s, ++__first)
+    if (__first == __last || (*__first | 0x20) != *__s)
+      return nullptr;
+  return __first;
+}
+
+// The _Tp nearest to __m * 2^__e; where, if __sticky, non-zero bits followed
+// those of __m. False if that is infinite, or zero though __m isn't.
+template <typename _Tp>
+constexpr bool __binary_to_float(std::uint64_t __m, int __e, bool __sticky,
+                                 _Tp& __value)
+{
+  using _Fmt = __binary_format<_Tp>;
+  constexpr int __mbits = _Fmt::_S_mantissa_bits;
+  constexpr int __emin = _Fmt::_S_min_exponent + 1;  // of a normal value
+  constexpr int __emax = -_Fmt::_S_min_exponent;
+  if (__m == 0)
+  {
+    __value = _Tp(0);
+    return true;
+  }
+
+  // __m * 2^__e = 1.f * 2^__x
+  const int __w = std::bit_width(__m);
+  const int __x = __w - 1 + __e;
+  if (__x > __emax)
+    return false;
+  int __shift = __w - (__mbits + 1);
+  if (__x < __emin)
+    __shift += __emin - __x;
+
+  std::uint64_t __q;
+  if (__shift <= 0)
+    __q = __m << -__shift;
+  else if (__shift > 64)
+    __q = 0;
+  else
+  {
+    const std::uint64_t __rem = __shift == 64 ? __m
+                              : __m & ((std::uint64_t(1) << __shift) - 1);
+    const std::uint64_t __half = std::uint64_t(1) << (__shift - 1);
+    __q = __shift == 64 ? 0 : __m >> __shift;
+    if (__rem > __half || (__rem == __half && (__sticky || (__q & 1))))
+      ++__q;
+  }
+
+  std::uint64_t __bits;
+  if (__x < __emin)  // subnormal; or, if rounded up to it, the least normal
+    __bits = __q;
+  else
+  {
+    int __biased = __x - _Fmt::_S_min_exponent;
+    if (__q >> (__mbits + 1))
+    {
+      __q >>= 1;
+      ++__biased;
+    }
+    if (__biased >= _Fmt::_S_infinite_power)
+      return false;
+    __bits = (std::uint64_t(__biased) << __mbits)
+           | (__q & ((std::uint64_t(1) << __mbits) - 1));
+  }
+  if (__bits == 0)
+    return false;
+  __value = std::bit_cast<_Tp>(static_cast<typename _Fmt::_Bits>(__bits));
+  return true;
+}
+
+// As strtod's hexadecimal form, but without 0x: hex digits with an optional
+// point, then an optional binary exponent
+template <typename _Tp>
+constexpr from_chars_result
+__hex_from_chars(const char* __first, const char* __p, const char* __last,
+                 bool __neg, _Tp& __value)
+{
+  constexpr int __elim = 100000;  // far beyond the range of any _Tp
+  std::uint64_t __m = 0;
+  int __e = 0;
+  bool __sticky = false, __digits = false, __point = false;
+  for (; __p != __last; ++__p)
+  {
+    if (*__p == '.' && !__point)
+    {
+      __point = true;
+      continue;
+    }
+    const unsigned __d = __digit_value(*__p);
+    if (__d >= 16)
+      break;
+    __digits = true;
+    if (__m >> 60 == 0)
+    {
+      __m = __m * 16 + __d;
+      if (__point && __e > -__elim)
+        __e -= 4;
+    }
+    else
+    {
+      __sticky |= __d != 0;
+      if (!__point && __e < __elim)
+        __e += 4;
+    }
+  }
+  if (!__digits)
+    return {__first, std::errc::invalid_argument};
+
+  if (__p != __last && (*__p == 'p' || *__p == 'P'))
+  {
+    const char* __q = __p + 1;
+    const bool __eneg = __q != __last && *__q == '-';
+    if (__q != __last && (*__q == '-' || *__q == '+'))
+      ++__q;
+    int __x = 0;
+    const char* const __xdigits = __q;
+    for (; __q != __last && *__q >= '0' && *__q <= '9'; ++__q)
+      if (__x < __elim)
+        __x = __x * 10 + (*__q - '0');
+    if (__q != __xdigits)
+    {
+      __e += __eneg ? -__x : __x;
+      __p = __q;
+    }
+  }
+
+  _Tp __v{};
+  if (!__binary_to_float(__m, __e, __sticky, __v))
+    return {__p, std::errc::result_out_of_range};
+  __value = __neg ? -__v : __v;
+  return {__p, std::errc{}};
+}
+
+template <typename _Tp>
+constexpr from_chars_result
+__fp_from_chars(const char* __first, const char* __last, _Tp& __value,
+                chars_format __fmt)
+{
+  using _Lim = std::numeric_limits<_Tp>;
+  const char* __p = __first;
+  const bool __neg = __p != __last && *__p == '-';
+  if (__neg)
+    ++__p;
+  if (__p == __last || *__p == '+' || *__p == '-')
+    return {__first, std::errc::invalid_argument};
+
+  // inf, infinity, nan and nan(n-char-sequence); in any case
+  if (const char* __q = __match_nocase(__p, __last, "inf"))
+  {
+    if (const char* __r = __match_nocase(__q, __last, "inity"))
+      __q = __r;
+    __value = __neg ? -_Lim::infinity() : _Lim::infinity();
+    return {__q, std::errc{}};
+  }
+  if (const char* __q = __match_nocase(__p, __last, "nan"))
+  {
+    if (__q != __last && *__q == '(')
+    {
+      const char* __r = __q + 1;
+      while (__r != __last && (__digit_value(*__r) < 36 || *__r == '_'))
+        ++__r;
+      if (__r != __last && *__r == ')')
+        __q = __r + 1;
+    }
+    __value = __neg ? -_Lim::quiet_NaN() : _Lim::quiet_NaN();
+    return {__q, std::errc{}};
+  }
+
+  if (__fmt == chars_format::hex)
+    return __hex_from_chars(__first, __p, __last, __neg, __value);
+
+  // The longest prefix which is a number. With fixed, there is no exponent;
+  // with scientific, there must be one.
+  const bool __exp_allowed = (__fmt & chars_format::scientific) != chars_format{};
+  const bool __exp_needed = __fmt == chars_format::scientific;
+  __fp_scanner __s;
+  const char* __end = nullptr;
+  for (; __p != __last; ++__p)
+  {
+    if (!__exp_allowed && (*__p == 'e' || *__p == 'E'))
+      break;
+    if (!__s._M_feed(*__p))
+      break;
+    if (__s._M_valid() && (!__exp_needed || __s._M_exponent()))
+      __end = __p + 1;
+  }
+  if (!__end)
+    return {__first, std::errc::invalid_argument};
+
+  const _Tp __v = __s.template _M_value<_Tp>();
+  if (__v > _Lim::max() || (__v == 0 && __s._M_nonzero()))
+    return {__end, std::errc::result_out_of_range};
+  __value = __neg ? -__v : __v;
+  return {__end, std::errc{}};
+}
+
+} // namespace impl
+
+// The base is from 2 to 36; letters are lower case
+template <impl::__charconv_integer _Tp>
+constexpr to_chars_result
+to_chars(char* __first, char* __last, _Tp __value, int __base = 10)
+{
+  using _Up = std::make_unsigned_t<_Tp>;
+  _Up __u = static_cast<_Up>(__value);
+  if constexpr (std::is_signed_v<_Tp>)
+    if (__value < 0)
+    {
+      if (__first == __last)
+        return {__last, std::errc::value_too_large};
+      *__first++ = '-';
+      __u = _Up(0) - __u;
+    }
+  const unsigned __len = impl::__to_chars_len(__u, unsigned(__base));
+  if (static_cast<unsigned long>(__last - __first) < __len)
+    return {__last, std::errc::value_too_large};
+  impl::__uint_to_chars(__first + __len, __u, unsigned(__base));
+  return {__first + __len, std::errc{}};
+}
+
+// The shortest of the fixed and scientific representations
+template <impl::__charconv_float _Tp>
+constexpr to_chars_result
+to_chars(char* __first, char* __last, _Tp __value)
+{
+  impl::__fp_spec __spec;
+  __spec._M_style = impl::__fp_style::shortest;
+  return impl::__fp_to_chars(__first, __last, __value, __spec);
+}
+
+// The shortest representation in the format; general is fixed if the
+// exponent is from -4 to 5, as with %g
+template <impl::__charconv_float _Tp>
+constexpr to_chars_result
+to_chars(char* __first, char* __last, _Tp __value, chars_format __fmt)
+{
+  return impl::__fp_to_chars(__first, __last, __value,
+                             impl::__to_chars_spec(__fmt, -1));
+}
+
+// As printf's %f, %e, %g or %a (without 0x), given the precision
+template <impl::__charconv_float _Tp>
+constexpr to_chars_result
+to_chars(char* __first, char* __last, _Tp __value, chars_format __fmt,
+         int __precision)
+{
+  if (__precision < 0)  // as printf, as if there were none
+    __precision = __fmt == chars_format::hex ? -1 : 6;
+  return impl::__fp_to_chars(__first, __last, __value,
+                             impl::__to_chars_spec(__fmt, __precision));
+}
+
+to_chars_result to_chars(char*, char*, bool, int = 10) = delete;
+
+// An optional minus sign (for a signed type), then digits; no 0x or +
+template <impl::__charconv_integer _Tp>
+constexpr from_chars_result
+from_chars(const char* __first, const char* __last, _Tp& __value,
+           int __base = 10)
+{
+  using _Up = std::make_unsigned_t<_Tp>;
+  const char* __p = __first;
+  bool __neg = false;
+  if constexpr (std::is_signed_v<_Tp>)
+    if (__p != __last && *__p == '-')
+    {
+      __neg = true;
+      ++__p;
+    }
+
+  // So many digits can't overflow; and need no check
+  const unsigned __b = unsigned(__base);
+  int __safe = 0;
+  for (_Up __m = std::numeric_limits<_Up>::max(); __m >= __b; __m /= __b)
+    ++__safe;
+
+  const char* const __digits = __p;
+  _Up __u = 0;
+  bool __overflow = false;
+  for (; __p != __last; ++__p)
+  {
+    const unsigned __d = impl::__digit_value(*__p);
+    if (__d >= __b)
+      break;
+    if (__p - __digits < __safe)
+      __u = static_cast<_Up>(__u * __b + __d);
+    else if (!__overflow && !impl::__accumulate_digit(__u, __b, __d))
+      __overflow = true;
+  }
+  if (__p == __digits)
+    return {__first, std::errc::invalid_argument};
+
+  using _Lim = std::numeric_limits<_Tp>;
+  const _Up __max = __neg ? _Up(0) - _Up(_Lim::min()) : _Up(_Lim::max());
+  if (__overflow || __u > __max)
+    return {__p, std::errc::result_out_of_range};
+  __value = static_cast<_Tp>(__neg ? _Up(0) - __u : __u);
+  return {__p, std::errc{}};
+}
+
+// As strtod, but without leading whitespace or a plus sign; and as the
+// format: with fixed there is no exponent, with scientific there must be;
+// and with hex there is no 0x. A value which is too large, or too small to
+// be other than zero, is out of range.
+template <impl::__charconv_float _Tp>
+constexpr from_chars_result
+from_chars(const char* __first, const char* __last, _Tp& __value,
+           chars_format __fmt = chars_format::general)
+{ return impl::__fp_from_chars(__first, __last, __value, __fmt); }
+
+} // namespace cest
+
+#endif // _CEST_CHARCONV_HPP_
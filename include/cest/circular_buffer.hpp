@@ -0,0 +1,332 @@
+#ifndef _CEST_CIRCULAR_BUFFER_HPP_
+#define _CEST_CIRCULAR_BUFFER_HPP_
+
+#include <memory>   // std::allocator, std::construct_at, std::destroy_at
+#include <iterator> // std::random_access_iterator_tag, std::reverse_iterator
+#include <utility>  // std::move, std::swap
+#include <cstddef>  // std::size_t, std::ptrdiff_t
+#include <compare>  // operator<=>
+#include <type_traits>
+#include <initializer_list>
+
+namespace cest {
+
+// A double-ended queue held in a single contiguous ring of storage. The
+// capacity is always a power of two, so the physical index of an element is
+// found by masking, rather than by division. When full, the ring doubles in
+// size; reserve() up front for a queue which never reallocates. Usable as the
+// Container of cest::queue, cest::stack and cest::priority_queue.
+template <
+  class T,
+  class Allocator = std::allocator<T>
+>
+class circular_buffer {
+public:
+
+  template <bool Const>
+  struct iter_t;
+
+  using value_type             = T;
+  using allocator_type         = Allocator;
+  using size_type              = std::size_t;
+  using difference_type        = std::ptrdiff_t;
+  using reference              = value_type&;
+  using const_reference        = const value_type&;
+  using pointer                = typename std::allocator_traits<Allocator>::pointer;
+  using const_pointer          = typename std::allocator_traits<Allocator>::const_pointer;
+  using iterator               = iter_t<false>;
+  using const_iterator         = iter_t<true>;
+  using reverse_iterator       = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  // An iterator holds a position in the same unbounded (modulo 2^N) sequence as
+  // m_front; so, as with deque, pop_front and pop_back leave other iterators
+  // valid.
+  template <bool Const>
+  struct iter_t
+  {
+    using buffer_type       = std::conditional_t<Const, const circular_buffer,
+                                                        circular_buffer>;
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = circular_buffer::value_type;
+    using reference         = std::conditional_t<Const, const T&, T&>;
+    using pointer           = std::conditional_t<Const, const T*, T*>;
+    using iterator_category = std::random_access_iterator_tag;
+
+    constexpr iter_t() = default;
+    constexpr iter_t(buffer_type* b, size_type i) : m_b(b), m_i(i) {}
+    template <bool C, typename = std::enable_if_t<Const && !C>>
+    constexpr iter_t(const iter_t<C>& it) : m_b(it.m_b), m_i(it.m_i) {}
+
+    constexpr reference operator*()  const noexcept {
+      return m_b->m_p[m_i & m_b->m_mask];
+    }
+    constexpr pointer   operator->() const noexcept { return &**this; }
+    constexpr reference operator[](difference_type n) const noexcept {
+      return m_b->m_p[(m_i + n) & m_b->m_mask];
+    }
+
+    constexpr iter_t& operator++()    noexcept { ++m_i; return *this; }
+    constexpr iter_t  operator++(int) noexcept { auto t = *this; ++m_i; return t; }
+    constexpr iter_t& operator--()    noexcept { --m_i; return *this; }
+    constexpr iter_t  operator--(int) noexcept { auto t = *this; --m_i; return t; }
+
+    constexpr iter_t& operator+=(difference_type n) noexcept {
+      m_i += n; return *this;
+    }
+    constexpr iter_t& operator-=(difference_type n) noexcept {
+      m_i -= n; return *this;
+    }
+
+    friend constexpr iter_t operator+(iter_t it, difference_type n) noexcept {
+      return it += n;
+    }
+    friend constexpr iter_t operator+(difference_type n, iter_t it) noexcept {
+      return it += n;
+    }
+    friend constexpr iter_t operator-(iter_t it, difference_type n) noexcept {
+      return it -= n;
+    }
+    friend constexpr difference_type
+    operator-(const iter_t& x, const iter_t& y) noexcept {
+      return difference_type(x.m_i - y.m_i);
+    }
+
+    friend constexpr bool
+    operator==(const iter_t& x, const iter_t& y) noexcept {
+      return x.m_i == y.m_i;
+    }
+    friend constexpr auto
+    operator<=>(const iter_t& x, const iter_t& y) noexcept {
+      return x - y <=> 0;
+    }
+
+    buffer_type* m_b = nullptr;
+    size_type    m_i = 0;
+  };
+
+  constexpr circular_buffer() noexcept(noexcept(Allocator()))
+    : m_p{}, m_mask{}, m_front{}, m_size{}, m_alloc{} {}
+
+  explicit constexpr circular_buffer(const Allocator& alloc) noexcept
+    : m_p{}, m_mask{}, m_front{}, m_size{}, m_alloc(alloc) {}
+
+  constexpr circular_buffer(std::initializer_list<T> init,
+                            const Allocator& alloc = Allocator())
+    : circular_buffer(alloc)
+  {
+    reserve(init.size());
+    for (const auto& x : init)
+      push_back(x);
+  }
+
+  constexpr circular_buffer(const circular_buffer& other)
+    : circular_buffer(std::allocator_traits<Allocator>::
+                        select_on_container_copy_construction(other.m_alloc))
+  {
+    reserve(other.size());
+    for (const auto& x : other)
+      push_back(x);
+  }
+
+  constexpr circular_buffer(circular_buffer&& other) noexcept
+    : circular_buffer(other.m_alloc)
+  {
+    swap(other);
+  }
+
+  constexpr ~circular_buffer()
+  {
+    clear();
+    if (m_p) m_alloc.deallocate(m_p, capacity());
+  }
+
+  constexpr circular_buffer& operator=(const circular_buffer& other)
+  {
+    if (this != &other) {
+      clear();
+      reserve(other.size());
+      for (const auto& x : other)
+        push_back(x);
+    }
+    return *this;
+  }
+
+  constexpr circular_buffer& operator=(circular_buffer&& other) noexcept
+  {
+    circular_buffer(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  constexpr void swap(circular_buffer& other) noexcept
+  {
+    using std::swap;
+    swap(m_p,     other.m_p);
+    swap(m_mask,  other.m_mask);
+    swap(m_front, other.m_front);
+    swap(m_size,  other.m_size);
+    swap(m_alloc, other.m_alloc);
+  }
+
+  constexpr allocator_type get_allocator() const noexcept { return m_alloc; }
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
+  constexpr size_type size()     const noexcept { return m_size; }
+  constexpr size_type capacity() const noexcept { return m_p ? m_mask + 1 : 0; }
+
+  // The capacity is rounded up to the next power of two
+  constexpr void reserve(size_type new_cap)
+  {
+    if (new_cap > capacity()) {
+      size_type cap = 1;
+      while (cap < new_cap)
+        cap *= 2;
+      reallocate(cap);
+    }
+  }
+
+  constexpr void clear() noexcept
+  {
+    for (size_type i = 0; i < m_size; ++i)
+      std::destroy_at(&(*this)[i]);
+    m_front = 0;
+    m_size  = 0;
+  }
+
+  constexpr       reference operator[](size_type pos)       noexcept {
+    return m_p[(m_front + pos) & m_mask];
+  }
+  constexpr const_reference operator[](size_type pos) const noexcept {
+    return m_p[(m_front + pos) & m_mask];
+  }
+
+  constexpr       reference front()       { return (*this)[0];          }
+  constexpr const_reference front() const { return (*this)[0];          }
+  constexpr       reference  back()       { return (*this)[m_size - 1]; }
+  constexpr const_reference  back() const { return (*this)[m_size - 1]; }
+
+  constexpr void push_back(const T& value)  { emplace_back(value);            }
+  constexpr void push_back(T&& value)       { emplace_back(std::move(value)); }
+  constexpr void push_front(const T& value) { emplace_front(value);           }
+  constexpr void push_front(T&& value)      { emplace_front(std::move(value));}
+
+  template <class... Args>
+  constexpr reference emplace_back(Args&&... args)
+  {
+    grow_if_full();
+    T* p = std::construct_at(&m_p[(m_front + m_size) & m_mask],
+                             std::forward<Args>(args)...);
+    ++m_size;
+    return *p;
+  }
+
+  template <class... Args>
+  constexpr reference emplace_front(Args&&... args)
+  {
+    grow_if_full();
+    T* p = std::construct_at(&m_p[(m_front - 1) & m_mask],
+                             std::forward<Args>(args)...);
+    --m_front;
+    ++m_size;
+    return *p;
+  }
+
+  constexpr void pop_front()
+  {
+    if (!empty()) {
+      std::destroy_at(&front());
+      ++m_front;
+      --m_size;
+    }
+  }
+
+  constexpr void pop_back()
+  {
+    if (!empty()) {
+      std::destroy_at(&back());
+      --m_size;
+    }
+  }
+
+  constexpr       iterator  begin()       noexcept { return {this, m_front}; }
+  constexpr const_iterator  begin() const noexcept { return {this, m_front}; }
+  constexpr const_iterator cbegin() const noexcept { return {this, m_front}; }
+  constexpr       iterator    end()       noexcept {
+    return {this, m_front + m_size};
+  }
+  constexpr const_iterator    end() const noexcept {
+    return {this, m_front + m_size};
+  }
+  constexpr const_iterator   cend() const noexcept {
+    return {this, m_front + m_size};
+  }
+
+  constexpr       reverse_iterator  rbegin()       noexcept {
+    return reverse_iterator(end());
+  }
+  constexpr const_reverse_iterator  rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  constexpr       reverse_iterator    rend()       noexcept {
+    return reverse_iterator(begin());
+  }
+  constexpr const_reverse_iterator    rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+private:
+
+  static constexpr size_type initial_capacity = 16;
+
+  constexpr void grow_if_full()
+  {
+    if (m_size == capacity())
+      reallocate(m_p ? 2 * capacity() : initial_capacity);
+  }
+
+  // cap is a power of two. m_front is unchanged; so iterators remain valid.
+  constexpr void reallocate(size_type cap)
+  {
+    value_type* p = m_alloc.allocate(cap);
+    for (size_type i = 0; i < m_size; ++i) {
+      std::construct_at(&p[(m_front + i) & (cap - 1)], std::move((*this)[i]));
+      std::destroy_at(&(*this)[i]);
+    }
+    if (m_p) m_alloc.deallocate(m_p, capacity());
+    m_p    = p;
+    m_mask = cap - 1;
+  }
+
+  value_type*    m_p;
+  size_type      m_mask;  // capacity() - 1
+  size_type      m_front; // the front element is at m_p[m_front & m_mask]
+  size_type      m_size;
+  allocator_type m_alloc;
+};
+
+template <class T, class Alloc>
+constexpr void swap(circular_buffer<T, Alloc>& a,
+                    circular_buffer<T, Alloc>& b) noexcept
+{
+  a.swap(b);
+}
+
+template <class T, class Alloc>
+constexpr bool operator==(const circular_buffer<T, Alloc>& a,
+                          const circular_buffer<T, Alloc>& b)
+{
+  if (a.size() != b.size())
+    return false;
+  for (std::size_t i = 0; i < a.size(); ++i)
+    if (!(a[i] == b[i]))
+      return false;
+  return true;
+}
+
+// A circular_buffer is a deque without chunks
+template <class T, class Allocator = std::allocator<T>>
+using ring_deque = circular_buffer<T, Allocator>;
+
+} // namespace cest
+
+#endif // _CEST_CIRCULAR_BUFFER_HPP_
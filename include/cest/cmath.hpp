@@ -1,172 +1,1692 @@
 #ifndef _CEST_CMATH_HPP_
 #define _CEST_CMATH_HPP_
 
+// Within a constant expression, each function below is evaluated by the
+// algorithms of fdlibm (as in FreeBSD's libm): a reduction of the argument,
+// then a minimax polynomial; and is within 1 ulp. At runtime, the std
+// function is called instead; and so libm, or the hardware.
+//
+// Each function has an overload for double, and a template for float, long
+// double, and the integer types (as double); as <cmath>. In a constant
+// expression, a float or long double argument is evaluated in double. The
+// exact functions (ceil, floor, round, trunc, fmod and fma) are exact for
+// each type; bar fma for a long double, as a double-double.
+
 #include "cest/bits/abs.hpp"
+#include <bit>          // std::bit_cast, std::countl_zero
+#include <cmath>
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <limits>       // std::numeric_limits
+#include <type_traits>  // std::is_constant_evaluated
 
 namespace cest {
 
-#define CEST_M_PI   3.141592653589793
-#define CEST_M_PI_2 1.570796326794897
-#define CEST_M_E    2.718281828459045
-
   // some forward declarations so the function ordering below doesn't matter
   // mainly so they can be put in alphabetical order or shuffled as required
+  constexpr double exp(double);
+  constexpr double pow(double, double);
   constexpr double pow(double, int);
   constexpr double sqrt(double);
   constexpr double sin(double);
   constexpr double sinh(double);
 
-  namespace {
-    constexpr double tol = 0.001;
+  namespace impl {
+
+    constexpr std::uint64_t __to_bits(double __x)
+    { return std::bit_cast<std::uint64_t>(__x); }
+
+    constexpr double __from_bits(std::uint64_t __b)
+    { return std::bit_cast<double>(__b); }
+
+    // The most significant 32 bits; as fdlibm's GET_HIGH_WORD
+    constexpr std::uint32_t __high_word(double __x)
+    { return __to_bits(__x) >> 32; }
+
+    // 2^__k, for a normal result
+    constexpr double __pow2(int __k)
+    { return __from_bits(std::uint64_t(__k + 1023) << 52); }
+
+    // NaN or infinity
+    constexpr bool __nonfinite(double __x)
+    { return (__high_word(__x) & 0x7ff00000) == 0x7ff00000; }
+
+    inline constexpr double __inf = std::numeric_limits<double>::infinity();
+    inline constexpr double __nan = std::numeric_limits<double>::quiet_NaN();
+
+    // Unevaluated sums of two doubles, __hi + __lo; with __lo no more than
+    // half an ulp of __hi. A product is exact by Veltkamp's splitting.
+    struct __dd { double _M_hi, _M_lo; };
+
+    constexpr __dd __fast_two_sum(double __a, double __b)
+    {
+      const double __s = __a + __b;
+      return {__s, __b - (__s - __a)};
+    }
+
+    constexpr __dd __two_sum(double __a, double __b)
+    {
+      const double __s = __a + __b;
+      const double __bb = __s - __a;
+      return {__s, (__a - (__s - __bb)) + (__b - __bb)};
+    }
+
+    constexpr __dd __split(double __a)
+    {
+      const double __c = 134217729.0 * __a;  // 2^27 + 1
+      const double __hi = __c - (__c - __a);
+      return {__hi, __a - __hi};
+    }
+
+    constexpr __dd __two_prod(double __a, double __b)
+    {
+      const double __p = __a * __b;
+      const __dd __as = __split(__a), __bs = __split(__b);
+      return {__p, ((__as._M_hi * __bs._M_hi - __p) + __as._M_hi * __bs._M_lo
+                    + __as._M_lo * __bs._M_hi) + __as._M_lo * __bs._M_lo};
+    }
+
+    constexpr __dd __dd_add(__dd __a, __dd __b)
+    {
+      const __dd __s = __two_sum(__a._M_hi, __b._M_hi);
+      return __fast_two_sum(__s._M_hi, __s._M_lo + __a._M_lo + __b._M_lo);
+    }
+
+    constexpr __dd __dd_mul(__dd __a, __dd __b)
+    {
+      const __dd __p = __two_prod(__a._M_hi, __b._M_hi);
+      return __fast_two_sum(__p._M_hi, __p._M_lo + (__a._M_hi * __b._M_lo
+                                                  + __a._M_lo * __b._M_hi));
+    }
+
+    // Correctly rounded; the root is found one bit at a time, as fdlibm's
+    // e_sqrt.c, though with one 64-bit remainder
+    constexpr double __sqrt(double __x)
+    {
+      const std::uint64_t __b = __to_bits(__x);
+      if (__x != __x || __x == 0 || __x == __inf)
+        return __x;
+      if (__b >> 63)
+        return __nan;
+
+      std::uint64_t __m = __b & ((std::uint64_t(1) << 52) - 1);
+      int __e = static_cast<int>(__b >> 52);
+      if (__e == 0)  // subnormal
+      {
+        const int __s = std::countl_zero(__m) - 11;
+        __m <<= __s;
+        __e = 1 - __s;
+      }
+      else
+        __m |= std::uint64_t(1) << 52;
+      __e -= 1075;   // x = m * 2^e, with 2^52 <= m < 2^53
+      if (__e & 1)
+      {
+        __m <<= 1;
+        --__e;
+      }
+
+      // q = floor(sqrt(m * 2^54)): 53 bits, and one more to round with
+      std::uint64_t __q = 0, __r = 0;
+      for (int __i = 53; __i >= 0; --__i)
+      {
+        const int __s = 2 * __i - 54;
+        __r = __r << 2 | (__s >= 0 ? (__m >> __s) & 3 : 0);
+        const std::uint64_t __t = __q << 2 | 1;
+        __q <<= 1;
+        if (__r >= __t)
+        {
+          __r -= __t;
+          __q |= 1;
+        }
+      }
+      const bool __up = (__q & 1) && (__r != 0 || (__q & 2));
+      __q = (__q >> 1) + __up;
+
+      // q's implicit bit adds one to the exponent; as does a carry out of it
+      return __from_bits((std::uint64_t(__e / 2 - 26 + 1074) << 52) + __q);
+    }
+
+    // Each of the kernels below is from fdlibm; with __x + __y, |__x| <= pi/4
+    constexpr double __kernel_sin(double __x, double __y, bool __iy)
+    {
+      constexpr double __S1 = -1.66666666666666324348e-01,
+                       __S2 =  8.33333333332248946124e-03,
+                       __S3 = -1.98412698298579493134e-04,
+                       __S4 =  2.75573137070700676789e-06,
+                       __S5 = -2.50507602534068634195e-08,
+                       __S6 =  1.58969099521155010221e-10;
+      const double __z = __x * __x, __w = __z * __z, __v = __z * __x;
+      const double __r = __S2 + __z * (__S3 + __z * __S4)
+                       + __z * __w * (__S5 + __z * __S6);
+      if (!__iy)
+        return __x + __v * (__S1 + __z * __r);
+      return __x - ((__z * (0.5 * __y - __v * __r) - __y) - __v * __S1);
+    }
+
+    constexpr double __kernel_cos(double __x, double __y)
+    {
+      constexpr double __C1 =  4.16666666666666019037e-02,
+                       __C2 = -1.38888888888741095749e-03,
+                       __C3 =  2.48015872894767294178e-05,
+                       __C4 = -2.75573143513906633035e-07,
+                       __C5 =  2.08757232129817482790e-09,
+                       __C6 = -1.13596475577881948265e-11;
+      const double __z = __x * __x, __w = __z * __z;
+      const double __r = __z * (__C1 + __z * (__C2 + __z * __C3))
+                       + __w * __w * (__C4 + __z * (__C5 + __z * __C6));
+      const double __hz = 0.5 * __z;
+      const double __v = 1.0 - __hz;
+      return __v + (((1.0 - __v) - __hz) + (__z * __r - __x * __y));
+    }
+
+    // The bits of 2/pi, from the first after the binary point
+    inline constexpr std::uint64_t __two_over_pi[] = {
+      0xa2f9836e4e441529, 0xfc2757d1f534ddc0, 0xdb6295993c439041,
+      0xfe5163abdebbc561, 0xb7246e3a424dd2e0, 0x06492eea09d1921c,
+      0xfe1deb1cb129a73e, 0xe88235f52ebb4484, 0xe99c7026b45f7e41,
+      0x3991d639835339f4, 0x9c845f8bbdf9283b, 0x1ff897ffde05980f,
+      0xef2f118b5a0a6d1f, 0x6d367ecf27cb09b7, 0x4f463f669e5fea2d,
+      0x7527bac7ebe5f17b, 0x3d0739f78a5292ea, 0x6bfb5fb11f8d5d08,
+      0x56033046fc7b6bab
+    };
+
+    // pi/2 * 2^126
+    inline constexpr std::uint64_t __pi_over_2[] = {
+      0x6487ed5110b4611a, 0x62633145c06e0e68
+    };
+
+    // 64 bits of 2/pi, from the __i'th (the first is 1) after the point
+    constexpr std::uint64_t __two_over_pi_bits(int __i)
+    {
+      constexpr int __n = sizeof(__two_over_pi) / sizeof(__two_over_pi[0]);
+      const int __w = (__i - 1) / 64, __s = (__i - 1) % 64;
+      const std::uint64_t __hi = __w < __n ? __two_over_pi[__w] : 0;
+      const std::uint64_t __lo = __w + 1 < __n ? __two_over_pi[__w + 1] : 0;
+      return __s ? __hi << __s | __lo >> (64 - __s) : __hi;
+    }
+
+    // __out = __a * __b; each of 64-bit words, least significant first
+    constexpr void __mul_words(const std::uint64_t* __a, int __na,
+                               const std::uint64_t* __b, int __nb,
+                               std::uint64_t* __out)
+    {
+      std::uint32_t __al[8]{}, __bl[8]{}, __p[16]{};
+      for (int __i = 0; __i < __na; ++__i)
+      {
+        __al[2 * __i] = static_cast<std::uint32_t>(__a[__i]);
+        __al[2 * __i + 1] = static_cast<std::uint32_t>(__a[__i] >> 32);
+      }
+      for (int __i = 0; __i < __nb; ++__i)
+      {
+        __bl[2 * __i] = static_cast<std::uint32_t>(__b[__i]);
+        __bl[2 * __i + 1] = static_cast<std::uint32_t>(__b[__i] >> 32);
+      }
+      for (int __i = 0; __i < 2 * __na; ++__i)
+      {
+        std::uint64_t __carry = 0;
+        for (int __j = 0; __j < 2 * __nb; ++__j)
+        {
+          const std::uint64_t __t = std::uint64_t(__al[__i]) * __bl[__j]
+                                  + __p[__i + __j] + __carry;
+          __p[__i + __j] = static_cast<std::uint32_t>(__t);
+          __carry = __t >> 32;
+        }
+        __p[__i + 2 * __nb] = static_cast<std::uint32_t>(__carry);
+      }
+      for (int __i = 0; __i < __na + __nb; ++__i)
+        __out[__i] = std::uint64_t(__p[2 * __i + 1]) << 32 | __p[2 * __i];
+    }
+
+    // 64 bits of the 256-bit __p, from bit __i
+    constexpr std::uint64_t __window(const std::uint64_t* __p, int __i)
+    {
+      const int __w = __i / 64, __s = __i % 64;
+      const std::uint64_t __hi = __w + 1 < 4 ? __p[__w + 1] : 0;
+      return __s ? __p[__w] >> __s | __hi << (64 - __s) : __p[__w];
+    }
+
+    struct __reduced { __dd _M_y; int _M_n; };
+
+    // x = n * pi/2 + y, with |y| <= pi/4; as Payne and Hanek. Only the 192
+    // bits of 2/pi from those which contribute to n mod 4 are multiplied
+    // by x's significand, exactly. For a finite x.
+    constexpr __reduced __rem_pio2(double __x)
+    {
+      const std::uint64_t __b = __to_bits(__x);
+      const std::uint64_t __m[1] = {
+        (__b & ((std::uint64_t(1) << 52) - 1)) | std::uint64_t(1) << 52
+      };
+      const int __e = static_cast<int>((__b >> 52) & 0x7ff) - 1075;
+      const int __s = __e - 1 > 1 ? __e - 1 : 1;
+      const std::uint64_t __c[3] = {
+        __two_over_pi_bits(__s + 128), __two_over_pi_bits(__s + 64),
+        __two_over_pi_bits(__s)
+      };
+      std::uint64_t __p[4]{};
+      __mul_words(__m, 1, __c, 3, __p);
+
+      // |x| * 2/pi mod 4 is __p / 2^__point
+      const int __point = __s + 191 - __e;
+      int __n = static_cast<int>(__window(__p, __point) & 3);
+      std::uint64_t __fhi = __window(__p, __point - 64);
+      std::uint64_t __flo = __window(__p, __point - 128);
+      const bool __neg = __fhi >> 63;
+      if (__neg)  // to the nearest n; so the fraction is negative
+      {
+        ++__n;
+        __flo = ~__flo + 1;
+        __fhi = ~__fhi + (__flo == 0);
+      }
+      if (__fhi == 0 && __flo == 0)
+        return {{0.0, 0.0}, (__b >> 63 ? -__n : __n) & 3};
+
+      const int __lz = __fhi ? std::countl_zero(__fhi)
+                             : 64 + std::countl_zero(__flo);
+      if (__lz >= 64)
+      {
+        __fhi = __flo << (__lz - 64);
+        __flo = 0;
+      }
+      else if (__lz > 0)
+      {
+        __fhi = __fhi << __lz | __flo >> (64 - __lz);
+        __flo <<= __lz;
+      }
+
+      // y = fraction * pi/2 = h * 2^(-126-lz), where h is the top 128 bits
+      const std::uint64_t __f[2] = {__flo, __fhi};
+      const std::uint64_t __pio2[2] = {__pi_over_2[1], __pi_over_2[0]};
+      std::uint64_t __h[4]{};
+      __mul_words(__f, 2, __pio2, 2, __h);
+      const double __scale = __pow2(-62 - __lz);
+      const double __hi = double(__h[3] & ~std::uint64_t(0x7ff)) * __scale;
+      const double __lo = (double(__h[3] & 0x7ff) + double(__h[2]) * 0x1p-64)
+                        * __scale;
+      __dd __y = __fast_two_sum(__hi, __lo);
+      if (__neg != bool(__b >> 63))
+        __y = {-__y._M_hi, -__y._M_lo};
+      return {__y, (__b >> 63 ? -__n : __n) & 3};
+    }
+
+    constexpr double __sin(double __x)
+    {
+      if (__nonfinite(__x))
+        return __nan;
+      const double __ax = abs(__x);
+      if (__ax < 0x1p-27)
+        return __x;
+      if (__ax <= 0.78539816339744828)
+        return __kernel_sin(__x, 0.0, false);
+      const __reduced __r = __rem_pio2(__x);
+      const double __hi = __r._M_y._M_hi, __lo = __r._M_y._M_lo;
+      switch (__r._M_n)
+      {
+        case 0:  return  __kernel_sin(__hi, __lo, true);
+        case 1:  return  __kernel_cos(__hi, __lo);
+        case 2:  return -__kernel_sin(__hi, __lo, true);
+        default: return -__kernel_cos(__hi, __lo);
+      }
+    }
+
+    constexpr double __cos(double __x)
+    {
+      if (__nonfinite(__x))
+        return __nan;
+      const double __ax = abs(__x);
+      if (__ax < 0x1p-27)
+        return 1.0;
+      if (__ax <= 0.78539816339744828)
+        return __kernel_cos(__x, 0.0);
+      const __reduced __r = __rem_pio2(__x);
+      const double __hi = __r._M_y._M_hi, __lo = __r._M_y._M_lo;
+      switch (__r._M_n)
+      {
+        case 0:  return  __kernel_cos(__hi, __lo);
+        case 1:  return -__kernel_sin(__hi, __lo, true);
+        case 2:  return -__kernel_cos(__hi, __lo);
+        default: return  __kernel_sin(__hi, __lo, true);
+      }
+    }
+
+    // fdlibm's s_atan.c; as a double-double. The reduced argument is the
+    // quotient of double-doubles, so that pi - atan(x) in atan2 is rounded
+    // only once.
+    constexpr __dd __atan_dd(double __x)
+    {
+      constexpr double __atanhi[] = {
+        4.63647609000806093515e-01, 7.85398163397448278999e-01,
+        9.82793723247329054082e-01, 1.57079632679489655800e+00
+      };
+      constexpr double __atanlo[] = {
+        2.26987774529616870924e-17, 3.06161699786838301793e-17,
+        1.39033110312309984516e-17, 6.12323399573676603587e-17
+      };
+      constexpr double __aT[] = {
+         3.33333333333329318027e-01, -1.99999999998764832476e-01,
+         1.42857142725034663711e-01, -1.11111104054623557880e-01,
+         9.09088713343650656196e-02, -7.69187620504482999495e-02,
+         6.66107313738753120669e-02, -5.83357013379057348645e-02,
+         4.97687799461593236017e-02, -3.65315727442169155270e-02,
+         1.62858201153657823623e-02
+      };
+
+      const std::uint32_t __ix = __high_word(__x) & 0x7fffffff;
+      const bool __neg = __x < 0;
+      if (__ix >= 0x44100000)  // |x| >= 2^66
+      {
+        if (__x != __x)
+          return {__x, 0.0};
+        return __neg ? __dd{-__atanhi[3], -__atanlo[3]}
+                     : __dd{__atanhi[3], __atanlo[3]};
+      }
+      int __id = -1;
+      double __n = __x;    // x is reduced to __n / __d
+      __dd __d = {1.0, 0.0};
+      if (__ix < 0x3fdc0000)  // |x| < 0.4375
+      {
+        if (__ix < 0x3e400000)  // |x| < 2^-27
+          return {__x, 0.0};
+      }
+      else
+      {
+        __x = abs(__x);
+        if (__ix < 0x3ff30000)  // |x| < 1.1875
+        {
+          if (__ix < 0x3fe60000)  // 7/16 <= |x| < 11/16
+          {
+            __id = 0;
+            __n = 2.0 * __x - 1.0;
+            __d = __two_sum(2.0, __x);
+          }
+          else                    // 11/16 <= |x| < 19/16
+          {
+            __id = 1;
+            __n = __x - 1.0;
+            __d = __two_sum(__x, 1.0);
+          }
+        }
+        else if (__ix < 0x40038000)  // |x| < 2.4375
+        {
+          __id = 2;
+          __n = __x - 1.5;
+          __d = __dd_add(__dd{1.0, 0.0}, __two_prod(1.5, __x));
+        }
+        else                         // 2.4375 <= |x| < 2^66
+        {
+          __id = 3;
+          __n = -1.0;
+          __d = {__x, 0.0};
+        }
+      }
+      // __x + __xlo = __n / __d; the subtractions forming __n are exact
+      double __xlo = 0.0;
+      if (__id >= 0)
+      {
+        __x = __n / __d._M_hi;
+        const __dd __p = __two_prod(__x, __d._M_hi);
+        __xlo = (((__n - __p._M_hi) - __p._M_lo) - __x * __d._M_lo) / __d._M_hi;
+      }
+      const double __z = __x * __x, __w = __z * __z;
+      const double __s1 = __z * (__aT[0] + __w * (__aT[2] + __w * (__aT[4]
+                        + __w * (__aT[6] + __w * (__aT[8] + __w * __aT[10])))));
+      const double __s2 = __w * (__aT[1] + __w * (__aT[3] + __w * (__aT[5]
+                        + __w * (__aT[7] + __w * __aT[9]))));
+      if (__id < 0)
+        return __fast_two_sum(__x, -__x * (__s1 + __s2));
+      // atan(x + xlo) is atan(x) + xlo/(1 + x^2), nearly
+      const __dd __h = __two_sum(__atanhi[__id], __x);
+      const __dd __r = __fast_two_sum(__h._M_hi, __h._M_lo + (__atanlo[__id]
+                       + __xlo / (1.0 + __z) - __x * (__s1 + __s2)));
+      return __neg ? __dd{-__r._M_hi, -__r._M_lo} : __r;
+    }
+
+    constexpr double __atan(double __x)
+    {
+      const __dd __r = __atan_dd(__x);
+      return __r._M_hi + __r._M_lo;
+    }
+
+    // fdlibm's e_atan2.c; though the quotient y/x is found to twice the
+    // precision of a double, and its error corrects atan's argument. For a
+    // negative x, pi - atan(|y/x|) is found as a double-double.
+    constexpr double __atan2(double __y, double __x)
+    {
+      constexpr double __pi_o_4 = 7.8539816339744827900e-01,
+                       __pi_o_2 = 1.5707963267948965580e+00,
+                       __pi     = 3.1415926535897931160e+00,
+                       __pi_lo  = 1.2246467991473531772e-16;
+      if (__x != __x || __y != __y)
+        return __x != __x ? __x : __y;
+      if (__x == 1.0)
+        return __atan(__y);
+
+      const int __m = (__to_bits(__y) >> 63) | ((__to_bits(__x) >> 62) & 2);
+      if (__y == 0)
+        switch (__m)
+        {
+          case 0:
+          case 1:  return __y;
+          case 2:  return __pi;
+          default: return -__pi;
+        }
+      if (__x == 0)
+        return __m & 1 ? -__pi_o_2 : __pi_o_2;
+      if (__x == __inf || __x == -__inf)
+      {
+        if (__y == __inf || __y == -__inf)
+          switch (__m)
+          {
+            case 0:  return __pi_o_4;
+            case 1:  return -__pi_o_4;
+            case 2:  return 3.0 * __pi_o_4;
+            default: return -3.0 * __pi_o_4;
+          }
+        switch (__m)
+        {
+          case 0:  return 0.0;
+          case 1:  return -0.0;
+          case 2:  return __pi;
+          default: return -__pi;
+        }
+      }
+      if (__y == __inf || __y == -__inf)
+        return __m & 1 ? -__pi_o_2 : __pi_o_2;
+
+      const int __k = static_cast<int>((__high_word(__y) >> 20) & 0x7ff)
+                    - static_cast<int>((__high_word(__x) >> 20) & 0x7ff);
+      // atan(|y/x|) = __z + __zlo; with __zlo the correction for the
+      // rounding of y/x, kept apart so that pi - __z is rounded only once
+      double __z, __zlo = 0.0;
+      if (__k > 60)                  // |y/x| > 2^60
+      {
+        __z = __pi_o_2;
+        __zlo = 0.5 * __pi_lo;
+      }
+      else if ((__m & 2) && __k < -60)  // |y|/x < -2^-60
+        __z = 0.0;
+      else
+      {
+        // |k| <= 60; so scaled both by 2^600 or 2^-600, as need be, the
+        // remainder of y/x below neither overflows nor underflows
+        double __ax = abs(__x), __ay = abs(__y);
+        if (__ax > 0x1p996 || __ay > 0x1p996)
+        {
+          __ax *= 0x1p-600;
+          __ay *= 0x1p-600;
+        }
+        else if (__ax < 0x1p-900 || __ay < 0x1p-900)
+        {
+          __ax *= 0x1p600;
+          __ay *= 0x1p600;
+        }
+        const double __q = __ay / __ax;
+        const __dd __p = __two_prod(__q, __ax);
+        __zlo = ((__ay - __p._M_hi) - __p._M_lo) / __ax / (1.0 + __q * __q);
+        const __dd __t = __atan_dd(__q);
+        __z = __t._M_hi;
+        __zlo += __t._M_lo;
+      }
+      if (__m < 2)
+        return __m == 0 ? __z + __zlo : -(__z + __zlo);
+      // pi - atan(|y/x|), as a double-double
+      const __dd __d = __two_sum(__pi, -__z);
+      const double __r = __d._M_hi + (__d._M_lo + (__pi_lo - __zlo));
+      return __m == 2 ? __r : -__r;
+    }
+
+    // exp(__hi + __lo), with |__lo| much less than |__hi|; as fdlibm's
+    // e_exp.c, whose argument is split in the same way
+    constexpr double __exp_kernel(double __x, double __xlo)
+    {
+      constexpr double __ln2hi  = 6.93147180369123816490e-01,
+                       __ln2lo  = 1.90821492927058770002e-10,
+                       __invln2 = 1.44269504088896338700e+00,
+                       __P1 =  1.66666666666666019037e-01,
+                       __P2 = -2.77777777770155933842e-03,
+                       __P3 =  6.61375632143793436117e-05,
+                       __P4 = -1.65339022054652515390e-06,
+                       __P5 =  4.13813679705723846039e-08;
+      if (__x > 7.09782712893383973096e+02)
+        return __inf;
+      if (__x < -7.45133219101941108420e+02)
+        return 0.0;
+
+      int __k = 0;
+      double __hi = __x, __lo = -__xlo;
+      if (abs(__x) > 0.5 * __ln2hi)
+      {
+        __k = static_cast<int>(__invln2 * __x + (__x < 0 ? -0.5 : 0.5));
+        __hi = __x - __k * __ln2hi;  // exact
+        __lo = __k * __ln2lo - __xlo;
+      }
+      else if (abs(__x) < 0x1p-28)
+        return 1.0 + (__x + __xlo);
+      const double __r = __hi - __lo;
+      const double __t = __r * __r;
+      const double __c = __r - __t * (__P1 + __t * (__P2 + __t * (__P3
+                       + __t * (__P4 + __t * __P5))));
+      const double __y = 1.0 - ((__lo - (__r * __c) / (2.0 - __c)) - __hi);
+      if (__k >= -1021)
+        return __k == 1024 ? __y * 2.0 * 0x1p1023 : __y * __pow2(__k);
+      return __y * __pow2(__k + 1000) * 0x1p-1000;
+    }
+
+    constexpr double __exp(double __x)
+    {
+      if (__x != __x)
+        return __x;
+      return __exp_kernel(__x, 0.0);
+    }
+
+    // fdlibm's e_log.c
+    constexpr double __log(double __x)
+    {
+      constexpr double __ln2hi = 6.93147180369123816490e-01,
+                       __ln2lo = 1.90821492927058770002e-10,
+                       __Lg1 = 6.666666666666735130e-01,
+                       __Lg2 = 3.999999999940941908e-01,
+                       __Lg3 = 2.857142874366239149e-01,
+                       __Lg4 = 2.222219843214978396e-01,
+                       __Lg5 = 1.818357216161805012e-01,
+                       __Lg6 = 1.531383769920937332e-01,
+                       __Lg7 = 1.479819860511658591e-01;
+      if (__x != __x || __x == __inf)
+        return __x;
+      if (__x == 0)
+        return -__inf;
+      if (__x < 0)
+        return __nan;
+
+      int __k = 0;
+      if (__x < 0x1p-1022)  // subnormal
+      {
+        __k -= 54;
+        __x *= 0x1p54;
+      }
+      std::uint32_t __hx = __high_word(__x);
+      __k += static_cast<int>(__hx >> 20) - 1023;
+      __hx &= 0x000fffff;
+      const std::uint32_t __i = (__hx + 0x95f64) & 0x100000;
+      // x, or x/2, so that sqrt(2)/2 <= x < sqrt(2)
+      __x = __from_bits((__to_bits(__x) & 0xffffffff)
+                        | std::uint64_t(__hx | (__i ^ 0x3ff00000)) << 32);
+      __k += __i >> 20;
+      const double __f = __x - 1.0;
+      const double __dk = __k;
+      if ((0x000fffff & (2 + __hx)) < 3)  // -2^-20 <= f < 2^-20
+      {
+        if (__f == 0)
+          return __dk * __ln2hi + __dk * __ln2lo;
+        const double __R = __f * __f * (0.5 - 0.33333333333333333 * __f);
+        if (__k == 0)
+          return __f - __R;
+        return __dk * __ln2hi - ((__R - __dk * __ln2lo) - __f);
+      }
+      const double __s = __f / (2.0 + __f);
+      const double __z = __s * __s, __w = __z * __z;
+      const int __j = (static_cast<int>(__hx) - 0x6147a)
+                    | (0x6b851 - static_cast<int>(__hx));
+      const double __t1 = __w * (__Lg2 + __w * (__Lg4 + __w * __Lg6));
+      const double __t2 = __z * (__Lg1 + __w * (__Lg3 + __w * (__Lg5
+                        + __w * __Lg7)));
+      const double __R = __t2 + __t1;
+      if (__j > 0)
+      {
+        const double __hfsq = 0.5 * __f * __f;
+        if (__k == 0)
+          return __f - (__hfsq - __s * (__hfsq + __R));
+        return __dk * __ln2hi
+             - ((__hfsq - (__s * (__hfsq + __R) + __dk * __ln2lo)) - __f);
+      }
+      if (__k == 0)
+        return __f - __s * (__f - __R);
+      return __dk * __ln2hi - ((__s * (__f - __R) - __dk * __ln2lo) - __f);
+    }
+
+    // log(x) to twice the precision of a double; for pow. With x = 2^k * m,
+    // sqrt(2)/2 <= m < sqrt(2), log(m) = 2 atanh(s), s = (m-1)/(m+1), and
+    // the first three terms of its series are summed as double-doubles.
+    constexpr __dd __log_dd(double __x)
+    {
+      constexpr __dd __ln2 = {6.93147180559945286227e-01,
+                              2.31904681384629955842e-17};
+      constexpr __dd __third = {3.33333333333333314830e-01,
+                                1.85037170770859413132e-17};
+      constexpr __dd __fifth = {2.00000000000000011102e-01,
+                                -1.11022302462515657925e-17};
+      int __k = 0;
+      if (__x < 0x1p-1022)
+      {
+        __k -= 54;
+        __x *= 0x1p54;
+      }
+      const std::uint64_t __b = __to_bits(__x);
+      __k += static_cast<int>(__b >> 52) - 1023;
+      double __m = __from_bits((__b & ((std::uint64_t(1) << 52) - 1))
+                               | (std::uint64_t(1023) << 52));
+      if (__m > 1.4142135623730951)
+      {
+        __m *= 0.5;
+        ++__k;
+      }
+
+      const double __num = __m - 1.0;  // exact
+      const __dd __den = __two_sum(__m, 1.0);
+      const double __shi = __num / __den._M_hi;
+      const __dd __p = __two_prod(__shi, __den._M_hi);
+      const double __slo = ((__num - __p._M_hi) - __p._M_lo
+                            - __shi * __den._M_lo) / __den._M_hi;
+      const __dd __s = __fast_two_sum(__shi, __slo);
+      const __dd __s2 = __dd_mul(__s, __s);
+      const __dd __s3 = __dd_mul(__s2, __s);
+      const __dd __s5 = __dd_mul(__s3, __s2);
+      const double __z = __s2._M_hi;
+      double __tail = 1.0 / 27;
+      for (int __i = 25; __i >= 7; __i -= 2)
+        __tail = 1.0 / __i + __z * __tail;
+      __tail *= __s5._M_hi * __z;  // s^7 (1/7 + s^2/9 + ...)
+
+      __dd __r = __dd_add(__dd_mul(__s3, __third), __dd_mul(__s5, __fifth));
+      __r = __dd_add(__r, __dd{__tail, 0.0});
+      __r = __dd_add(__s, __r);
+      __r = {2.0 * __r._M_hi, 2.0 * __r._M_lo};
+      return __dd_add(__dd_mul(__ln2, __dd{double(__k), 0.0}), __r);
+    }
+
+    // Whether __y is an integer, and if so, whether it's odd
+    constexpr int __integer_kind(double __y)  // 0: not; 1: odd; 2: even
+    {
+      const double __a = abs(__y);
+      if (__a >= 0x1p53)
+        return 2;
+      const double __t = static_cast<double>(static_cast<std::int64_t>(__a));
+      if (__t != __a)
+        return 0;
+      return static_cast<std::int64_t>(__a) & 1 ? 1 : 2;
+    }
+
+    // exp(y log(x)); with log(x), and then y log(x), as double-doubles.
+    // The special cases are those of C99's Annex F.
+    constexpr double __pow(double __x, double __y)
+    {
+      if (__y == 0 || __x == 1.0)
+        return 1.0;
+      if (__x != __x || __y != __y)
+        return __x != __x ? __x : __y;
 
-    constexpr double square(const double x) {
-      return x*x;
+      const int __yint = __integer_kind(__y);
+      const bool __yodd = __yint == 1;
+      const bool __xneg = __to_bits(__x) >> 63;
+      const double __ax = abs(__x);
+      if (__y == __inf || __y == -__inf)
+      {
+        if (__ax == 1.0)
+          return 1.0;
+        return (__ax > 1.0) == (__y > 0) ? __inf : 0.0;
+      }
+      if (__x == 0 || __ax == __inf)
+      {
+        const bool __big = (__x == 0) == (__y < 0);
+        const double __r = __big ? __inf : 0.0;
+        return __xneg && __yodd ? -__r : __r;
+      }
+      if (__xneg && !__yint)
+        return __nan;
+
+      const __dd __l = __log_dd(__ax);
+      const __dd __z = __dd_mul(__l, __dd{__y, 0.0});
+      double __r;
+      if (__z._M_hi > 7.09782712893383973096e+02)
+        __r = __inf;
+      else if (__z._M_hi < -7.45133219101941108420e+02)
+        __r = 0.0;
+      else
+        __r = __exp_kernel(__z._M_hi, __z._M_lo);
+      return __xneg && __yodd ? -__r : __r;
+    }
+
+    // exp(__x) to twice the precision of a double: exp(x) is e (1 + d),
+    // where d = x - log(e), is small, and so is found from log_dd(e)
+    constexpr __dd __exp_dd(double __x)
+    {
+      const double __e = __exp(__x);
+      const __dd __l = __log_dd(__e);
+      return {__e, __e * ((__x - __l._M_hi) - __l._M_lo)};
+    }
+
+    // 1/__a; the remainder of the leading quotient gives the correction
+    constexpr __dd __dd_recip(__dd __a)
+    {
+      const double __q = 1.0 / __a._M_hi;
+      const __dd __p = __two_prod(__q, __a._M_hi);
+      return __fast_two_sum(__q, ((1.0 - __p._M_hi) - __p._M_lo
+                                  - __q * __a._M_lo) / __a._M_hi);
+    }
+
+    // Beyond which, sinh and cosh overflow
+    inline constexpr double __hyperbolic_max = 7.10475860073943863426e+02;
+    // Beyond which, e^-|x| is below 2^-106 of e^|x|; and is ignored
+    inline constexpr double __hyperbolic_recip_max = 40.0;
+
+    constexpr double __sinh(double __x)
+    {
+      if (__nonfinite(__x))
+        return __x;
+      const double __ax = abs(__x);
+      if (__ax < 0x1p-28)
+        return __x;
+      double __r;
+      if (__ax > __hyperbolic_max)
+        __r = __inf;
+      else if (__ax < __hyperbolic_recip_max)
+      {
+        // The cancellation of e^-|x| costs at most 28 of the 106 bits
+        const __dd __e = __exp_dd(__ax);
+        const __dd __i = __dd_recip(__e);
+        const __dd __d = __dd_add(__e, __dd{-__i._M_hi, -__i._M_lo});
+        __r = 0.5 * (__d._M_hi + __d._M_lo);
+      }
+      else if (__ax < 709.0)
+      {
+        const __dd __e = __exp_dd(__ax);
+        __r = 0.5 * (__e._M_hi + __e._M_lo);
+      }
+      else  // exp(|x|) overflows before sinh(x)
+      {
+        const __dd __e = __exp_dd(0.5 * __ax);
+        const __dd __h = __dd_mul(__dd{0.5 * __e._M_hi, 0.5 * __e._M_lo}, __e);
+        __r = __h._M_hi + __h._M_lo;
+      }
+      return __x < 0 ? -__r : __r;
+    }
+
+    constexpr double __cosh(double __x)
+    {
+      if (__x != __x)
+        return __x;
+      const double __ax = abs(__x);
+      if (__ax > __hyperbolic_max)
+        return __inf;
+      if (__ax < __hyperbolic_recip_max)
+      {
+        const __dd __e = __exp_dd(__ax);
+        const __dd __s = __dd_add(__e, __dd_recip(__e));
+        return 0.5 * (__s._M_hi + __s._M_lo);
+      }
+      if (__ax < 709.0)
+      {
+        const __dd __e = __exp_dd(__ax);
+        return 0.5 * (__e._M_hi + __e._M_lo);
+      }
+      const __dd __e = __exp_dd(0.5 * __ax);
+      const __dd __h = __dd_mul(__dd{0.5 * __e._M_hi, 0.5 * __e._M_lo}, __e);
+      return __h._M_hi + __h._M_lo;
+    }
+
+    // fdlibm's k_tan.c; -1/tan(x + y) if __iy is -1
+    constexpr double __kernel_tan(double __x, double __y, int __iy)
+    {
+      constexpr double __T[] = {
+         3.33333333333334091986e-01,  1.33333333333201242699e-01,
+         5.39682539762260521377e-02,  2.18694882948595424599e-02,
+         8.86323982359930005737e-03,  3.59207910759131235356e-03,
+         1.45620945432529025516e-03,  5.88041240820264096874e-04,
+         2.46463134818469906812e-04,  7.81794442939557092300e-05,
+         7.14072491382608190305e-05, -1.85586374855275456654e-05,
+         2.59073051863633712884e-05
+      };
+      constexpr double __pio4 = 7.85398163397448278999e-01,
+                       __pio4lo = 3.06161699786838301793e-17;
+      auto __low_zeroed = [](double __d) {
+        return __from_bits(__to_bits(__d) & 0xffffffff00000000);
+      };
+
+      const std::uint32_t __ix = __high_word(__x) & 0x7fffffff;
+      const bool __neg = __x < 0;
+      if (__ix < 0x3e300000)  // |x| < 2^-28
+        return __iy == 1 ? __x : -1.0 / (__x + __y);
+      const bool __big = __ix >= 0x3fe59428;  // |x| >= 0.6744
+      if (__big)
+      {
+        if (__neg)
+        {
+          __x = -__x;
+          __y = -__y;
+        }
+        __x = (__pio4 - __x) + (__pio4lo - __y);
+        __y = 0.0;
+      }
+      double __z = __x * __x;
+      double __w = __z * __z;
+      double __r = __T[1] + __w * (__T[3] + __w * (__T[5] + __w * (__T[7]
+                 + __w * (__T[9] + __w * __T[11]))));
+      double __v = __z * (__T[2] + __w * (__T[4] + __w * (__T[6] + __w * (__T[8]
+                 + __w * (__T[10] + __w * __T[12])))));
+      double __s = __z * __x;
+      __r = __y + __z * (__s * (__r + __v) + __y);
+      __r += __T[0] * __s;
+      __w = __x + __r;
+      if (__big)
+      {
+        __v = __iy;
+        const double __t = __v - 2.0 * (__x - (__w * __w / (__w + __v) - __r));
+        return __neg ? -__t : __t;
+      }
+      if (__iy == 1)
+        return __w;
+      // -1/(x + r), accurately
+      __z = __low_zeroed(__w);
+      __v = __r - (__z - __x);
+      const double __a = -1.0 / __w;
+      const double __t = __low_zeroed(__a);
+      __s = 1.0 + __t * __z;
+      return __t + __a * (__s + __t * __v);
     }
 
-    constexpr double cube(const double x) {
-      return x*x*x;
+    constexpr double __tan(double __x)
+    {
+      if (__nonfinite(__x))
+        return __nan;
+      if (abs(__x) <= 0.78539816339744828)
+        return __kernel_tan(__x, 0.0, 1);
+      const __reduced __r = __rem_pio2(__x);
+      return __kernel_tan(__r._M_y._M_hi, __r._M_y._M_lo,
+                          1 - ((__r._M_n & 1) << 1));
     }
 
-    // https://www.cse.wustl.edu/~ychen/131/Notes/SquareRoot/sqrt.html
-    constexpr double sqrt_helper(const double x, const double g) {
-      return abs(g-x/g) < (tol*g) ? g : sqrt_helper(x,(g+x/g)/2.0);
+    // The rational approximation of asin shared by asin and acos, in
+    // fdlibm's e_asin.c and e_acos.c: asin(x) = x + x^3 R(x^2)
+    constexpr double __asin_r(double __t)
+    {
+      constexpr double __pS0 =  1.66666666666666657415e-01,
+                       __pS1 = -3.25565818622400915405e-01,
+                       __pS2 =  2.01212532134862925881e-01,
+                       __pS3 = -4.00555345006794114027e-02,
+                       __pS4 =  7.91534994289814532176e-04,
+                       __pS5 =  3.47933107596021167570e-05,
+                       __qS1 = -2.40339491173441421878e+00,
+                       __qS2 =  2.02094576023350569471e+00,
+                       __qS3 = -6.88283971605453293030e-01,
+                       __qS4 =  7.70381505559019352791e-02;
+      const double __p = __t * (__pS0 + __t * (__pS1 + __t * (__pS2
+                       + __t * (__pS3 + __t * (__pS4 + __t * __pS5)))));
+      const double __q = 1.0 + __t * (__qS1 + __t * (__qS2 + __t * (__qS3
+                       + __t * __qS4)));
+      return __p / __q;
     }
 
-    constexpr double sin_helper(const double x) {
-      return x < tol ? x : 3*(sin_helper(x/3.0)) - 4*cube(sin_helper(x/3.0));
+    inline constexpr double __pio2_hi = 1.57079632679489655800e+00,
+                            __pio2_lo = 6.12323399573676603587e-17;
+
+    constexpr double __asin(double __x)
+    {
+      constexpr double __pio4_hi = 7.85398163397448278999e-01;
+      const double __ax = abs(__x);
+      if (!(__ax <= 1.0))  // NaN too
+        return __nan;
+      if (__ax == 1.0)
+        return __x * __pio2_hi + __x * __pio2_lo;
+      if (__ax < 0.5)
+      {
+        if (__ax < 0x1p-26)
+          return __x;
+        return __x + __x * __asin_r(__x * __x);
+      }
+      // asin(x) = pi/2 - 2 asin(sqrt((1 - |x|)/2))
+      const double __t = (1.0 - __ax) * 0.5;
+      const double __s = __sqrt(__t);
+      const double __r = __asin_r(__t);
+      double __y;
+      if (__ax >= 0.975)
+        __y = __pio2_hi - (2.0 * (__s + __s * __r) - __pio2_lo);
+      else
+      {
+        const double __w = __from_bits(__to_bits(__s) & 0xffffffff00000000);
+        const double __c = (__t - __w * __w) / (__s + __w);
+        const double __p = 2.0 * __s * __r - (__pio2_lo - 2.0 * __c);
+        const double __q = __pio4_hi - 2.0 * __w;
+        __y = __pio4_hi - (__p - __q);
+      }
+      return __x < 0 ? -__y : __y;
     }
 
-    constexpr double sinh_helper(const double x) {
-      return x < tol ? x : 3*(sinh_helper(x/3.0)) + 4*cube(sinh_helper(x/3.0));
+    constexpr double __acos(double __x)
+    {
+      constexpr double __pi = 3.14159265358979311600e+00;
+      const double __ax = abs(__x);
+      if (!(__ax <= 1.0))
+        return __nan;
+      if (__x == 1.0)
+        return 0.0;
+      if (__x == -1.0)
+        return __pi + 2.0 * __pio2_lo;
+      if (__ax < 0.5)
+      {
+        if (__ax < 0x1p-57)
+          return __pio2_hi + __pio2_lo;
+        return __pio2_hi - (__x - (__pio2_lo - __x * __asin_r(__x * __x)));
+      }
+      if (__x < 0)  // acos(x) = pi - 2 asin(sqrt((1 + x)/2))
+      {
+        const double __z = (1.0 + __x) * 0.5;
+        const double __s = __sqrt(__z);
+        const double __w = __asin_r(__z) * __s - __pio2_lo;
+        return __pi - 2.0 * (__s + __w);
+      }
+      const double __z = (1.0 - __x) * 0.5;  // acos(x) = 2 asin(sqrt((1 - x)/2))
+      const double __s = __sqrt(__z);
+      const double __df = __from_bits(__to_bits(__s) & 0xffffffff00000000);
+      const double __c = (__z - __df * __df) / (__s + __df);
+      const double __w = __asin_r(__z) * __s + __c;
+      return 2.0 * (__df + __w);
     }
 
-    // atan formulae from http://mathonweb.com/algebra_e-book.htm
-    // x - x^3/3 + x^5/5 - x^7/7+x^9/9  etc.
-    constexpr double atan_poly_helper(const double res,  const double num1,
-                                      const double den1, const double delta) {
-      return res < tol ? res :
-             res + atan_poly_helper((num1*delta)/(den1+2.)-num1/den1,
-                                     num1*delta*delta,den1+4.,delta);
+    inline constexpr __dd __ln2_dd = {6.93147180559945286227e-01,
+                                      2.31904681384629955842e-17};
+
+    // exp(x log(2)); with x log(2) as a double-double
+    constexpr double __exp2(double __x)
+    {
+      if (__x != __x)
+        return __x;
+      if (__x >= 1024.0)
+        return __inf;
+      if (__x <= -1075.0)
+        return 0.0;
+      const __dd __z = __dd_mul(__ln2_dd, __dd{__x, 0.0});
+      return __exp_kernel(__z._M_hi, __z._M_lo);
     }
 
-    constexpr double atan_poly(const double x) {
-      return x + atan_poly_helper(pow(x,5)/5.-pow(x,3)/3., pow(x,7), 7., x*x);
+    // log(x) / log(__base); the quotient of double-doubles
+    constexpr double __log_base(double __x, __dd __inv_log_base)
+    {
+      if (__x != __x || __x == __inf)
+        return __x;
+      if (__x == 0)
+        return -__inf;
+      if (__x < 0)
+        return __nan;
+      return __dd_mul(__log_dd(__x), __inv_log_base)._M_hi;
     }
 
-    constexpr double atan_identity(const double x) {
-      return x <= (2. - sqrt(3.)) ? atan_poly(x) :
-             (CEST_M_PI_2 / 3.) + atan_poly((sqrt(3.)*x-1)/(sqrt(3.)+x));
+    constexpr double __log2(double __x)
+    {
+      return __log_base(__x, {1.44269504088896338700e+00,
+                              2.03552737409310331050e-17});
     }
 
-    constexpr double atan_cmplmntry(const double x) {
-      return (x < 1) ? atan_identity(x) : CEST_M_PI_2 - atan_identity(1/x);
+    constexpr double __log10(double __x)
+    {
+      return __log_base(__x, {4.34294481903251816668e-01,
+                              1.09882896699258601787e-17});
     }
 
-    constexpr double exp_helper(const double r) {
-      return 1.0 + r + pow(r,2)/2.0   + pow(r,3)/6.0   +
-                       pow(r,4)/24.0  + pow(r,5)/120.0 +
-                       pow(r,6)/720.0 + pow(r,7)/5040.0;
+    // x = m 2^(3q), 1 <= m < 8; so cbrt(x) = cbrt(m) 2^q. cbrt(m) is found by
+    // Newton's method, then corrected by the residual m - t^3, found exactly
+    constexpr double __cbrt(double __x)
+    {
+      if (__nonfinite(__x) || __x == 0)
+        return __x;
+      double __ax = abs(__x);
+      int __e = 0;
+      if (__ax < 0x1p-1022)
+      {
+        __ax *= 0x1p54;
+        __e -= 54;
+      }
+      const std::uint64_t __b = __to_bits(__ax);
+      __e += static_cast<int>(__b >> 52) - 1023;
+      const int __r = ((__e % 3) + 3) % 3;
+      const int __q = (__e - __r) / 3;
+      const double __m = __from_bits((__b & ((std::uint64_t(1) << 52) - 1))
+                                     | std::uint64_t(1023 + __r) << 52);
+      double __t = 1.0 + (__m - 1.0) / 7.0;
+      for (int __i = 0; __i < 5; ++__i)
+        __t -= (__t * __t * __t - __m) / (3.0 * __t * __t);
+      const __dd __t3 = __dd_mul(__two_prod(__t, __t), __dd{__t, 0.0});
+      __t += ((__m - __t3._M_hi) - __t3._M_lo) / (3.0 * __t * __t);
+      __t *= __pow2(__q);
+      return __x < 0 ? -__t : __t;
     }
 
-    constexpr int exponent_helper(const double x, const int e) {
-      return x >= 10.0 ? exponent_helper(x *  0.1, e+1) :
-             x <  1.0  ? exponent_helper(x * 10.0, e-1) :
-             e;
+    // sqrt(x^2 + y^2) with the sum of squares as a double-double, scaled so
+    // that neither overflows nor underflows; corrected by its residual
+    constexpr double __hypot(double __x, double __y)
+    {
+      double __ax = abs(__x), __ay = abs(__y);
+      if (__ax == __inf || __ay == __inf)
+        return __inf;
+      if (__ax != __ax || __ay != __ay)
+        return __nan;
+      if (__ax < __ay)
+      {
+        const double __t = __ax;
+        __ax = __ay;
+        __ay = __t;
+      }
+      if (__ay == 0)
+        return __ax;
+      const int __ex = static_cast<int>(__high_word(__ax) >> 20);
+      const int __ey = static_cast<int>(__high_word(__ay) >> 20);
+      if (__ex - __ey > 60)
+        return __ax + __ay;
+
+      int __scale = 0;
+      if (__ax > 0x1p500)
+        __scale = 600;
+      else if (__ay < 0x1p-500)
+        __scale = -600;
+      if (__scale)
+      {
+        __ax *= __pow2(-__scale);
+        __ay *= __pow2(-__scale);
+      }
+      const __dd __s = __dd_add(__two_prod(__ax, __ax), __two_prod(__ay, __ay));
+      double __r = __sqrt(__s._M_hi);
+      const __dd __r2 = __two_prod(__r, __r);
+      __r += (((__s._M_hi - __r2._M_hi) - __r2._M_lo) + __s._M_lo) / (2.0 * __r);
+      if (__scale > 0 && __r > 0x1.fffffffffffffp+423)
+        return __inf;
+      return __scale ? __r * __pow2(__scale) : __r;
     }
 
-    constexpr int exponent(const double x) { 
-      return exponent_helper(x,0);
+    enum class __round_to { _S_zero, _S_down, _S_up, _S_nearest };
+
+    template <typename _Tp> struct __float_bits;
+
+    template <>
+    struct __float_bits<float>
+    {
+      using _Bits = std::uint32_t;
+      static constexpr int _S_mantissa = 23, _S_bias = 127;
+    };
+
+    template <>
+    struct __float_bits<double>
+    {
+      using _Bits = std::uint64_t;
+      static constexpr int _S_mantissa = 52, _S_bias = 1023;
+    };
+
+    // trunc, floor, ceil and round; exactly, on the bits of a float or
+    // double. The fraction's bits are cleared; after, for floor and ceil, a
+    // carry of one into the integral bits, or for round, a half.
+    template <typename _Tp>
+    constexpr _Tp __round_bits(_Tp __x, __round_to __mode)
+    {
+      using _Bits = typename __float_bits<_Tp>::_Bits;
+      constexpr int __mbits = __float_bits<_Tp>::_S_mantissa;
+      constexpr int __bias = __float_bits<_Tp>::_S_bias;
+      _Bits __b = std::bit_cast<_Bits>(__x);
+      const bool __neg = __b >> (sizeof(_Bits) * 8 - 1);
+      const int __e = static_cast<int>((__b >> __mbits) & (2 * __bias + 1))
+                    - __bias;
+      if (__e >= __mbits)  // integral; or infinite or NaN
+        return __x;
+      if (__e < 0)         // |x| < 1
+      {
+        const _Tp __zero = __neg ? -_Tp(0) : _Tp(0);
+        const _Tp __one = __neg ? _Tp(-1) : _Tp(1);
+        if (__x == 0)
+          return __x;
+        switch (__mode)
+        {
+          case __round_to::_S_down:    return __neg ? __one : __zero;
+          case __round_to::_S_up:      return __neg ? __zero : __one;
+          case __round_to::_S_nearest: return __e == -1 ? __one : __zero;
+          default:                     return __zero;
+        }
+      }
+      const _Bits __frac = (_Bits(1) << (__mbits - __e)) - 1;
+      if ((__b & __frac) == 0)
+        return __x;
+      if ((__mode == __round_to::_S_down && __neg)
+          || (__mode == __round_to::_S_up && !__neg))
+        __b += __frac + 1;
+      else if (__mode == __round_to::_S_nearest)
+        __b += (__frac + 1) >> 1;
+      return std::bit_cast<_Tp>(_Bits(__b & ~__frac));
     }
 
-    constexpr double mantissa(const double x) {
-      return x >= 10.0 ? mantissa(x *  0.1) :
-             x <  1.0  ? mantissa(x * 10.0) :
-             x;
+    // As above, for a long double; without its bits. Below 2^(digits-1),
+    // adding and subtracting that rounds |x| to an integer, to nearest.
+    constexpr long double __round_bits(long double __x, __round_to __mode)
+    {
+      constexpr long double __big =
+        static_cast<long double>(std::uint64_t(1) << 62)
+        * static_cast<long double>(std::uint64_t(1)
+                                   << (std::numeric_limits<long double>::digits - 63));
+      const long double __ax = __x < 0 ? -__x : __x;
+      if (!(__ax < __big) || __x == 0)  // integral, infinite, NaN, or zero
+        return __x;
+      long double __t = (__ax + __big) - __big;
+      if (__t > __ax)
+        __t -= 1;  // trunc(|x|)
+      const long double __f = __ax - __t;
+      const bool __neg = __x < 0;
+      if ((__mode == __round_to::_S_down && __neg && __f != 0)
+          || (__mode == __round_to::_S_up && !__neg && __f != 0)
+          || (__mode == __round_to::_S_nearest && __f >= 0.5L))
+        __t += 1;
+      return __neg ? -__t : __t;
     }
 
-    constexpr double log_helper2(const double y) {
-      return 2.0 * (y + pow(y,3)/3.0 + pow(y,5)/5.0 +
-                        pow(y,7)/7.0 + pow(y,9)/9.0 + pow(y,11)/11.0);
+    // Exactly: each step subtracts, exactly, the greatest of |y| 2^k which
+    // is no more than the remainder
+    template <typename _Tp>
+    constexpr _Tp __fmod(_Tp __x, _Tp __y)
+    {
+      constexpr _Tp __inf_t = std::numeric_limits<_Tp>::infinity();
+      if (__x != __x || __y != __y || __y == 0 || __x == __inf_t
+          || __x == -__inf_t)
+        return std::numeric_limits<_Tp>::quiet_NaN();
+      _Tp __ax = __x < 0 ? -__x : __x;
+      const _Tp __ay = __y < 0 ? -__y : __y;
+      if (__ax < __ay)
+        return __x;
+      _Tp __d = __ay;
+      while (__d <= __ax / 2)
+        __d *= 2;
+      for (; __d >= __ay; __d /= 2)
+      {
+        if (__ax >= __d)
+          __ax -= __d;
+        if (__d == __ay)
+          break;
+      }
+      return __x < 0 ? -__ax : __ax;
     }
 
-    // log in the range 1-sqrt(10)
-    constexpr double log_helper(const double x) { 
-      return log_helper2((x-1.0)/(x+1.0));
+    // A 128-bit unsigned integer; for fma
+    struct __u128 { std::uint64_t _M_hi, _M_lo; };
+
+    constexpr bool __less(__u128 __a, __u128 __b)
+    { return __a._M_hi < __b._M_hi || (__a._M_hi == __b._M_hi && __a._M_lo < __b._M_lo); }
+
+    constexpr __u128 __add(__u128 __a, __u128 __b)
+    {
+      const std::uint64_t __lo = __a._M_lo + __b._M_lo;
+      return {__a._M_hi + __b._M_hi + (__lo < __a._M_lo), __lo};
     }
 
-    constexpr double nearest(double x) {
-      return (x-0.5) > (int)x ? (int)(x+0.5) : (int)x;
+    constexpr __u128 __sub(__u128 __a, __u128 __b)
+    { return {__a._M_hi - __b._M_hi - (__a._M_lo < __b._M_lo), __a._M_lo - __b._M_lo}; }
+
+    constexpr __u128 __shl(__u128 __a, int __n)
+    {
+      if (__n == 0)
+        return __a;
+      if (__n >= 64)
+        return {__a._M_lo << (__n - 64), 0};
+      return {__a._M_hi << __n | __a._M_lo >> (64 - __n), __a._M_lo << __n};
     }
 
-    constexpr double fraction(double x) {
-      return (x-0.5) > (int)x ? -(((double)(int)(x+0.5))-x) : 
-                                x-((double)(int)(x));
+    // With any bits shifted out kept as one, the least significant
+    constexpr __u128 __shr_sticky(__u128 __a, int __n)
+    {
+      if (__n == 0)
+        return __a;
+      if (__n >= 128)
+        return {0, (__a._M_hi | __a._M_lo) != 0};
+      const __u128 __r = __n >= 64 ? __u128{0, __a._M_hi >> (__n - 64)}
+                       : __u128{__a._M_hi >> __n,
+                                __a._M_lo >> __n | __a._M_hi << (64 - __n)};
+      const __u128 __back = __shl(__r, __n);
+      return {__r._M_hi, __r._M_lo | (__back._M_hi != __a._M_hi
+                                      || __back._M_lo != __a._M_lo)};
     }
 
-  } // anonymous namespace
+    constexpr int __countl_zero(__u128 __a)
+    {
+      return __a._M_hi ? std::countl_zero(__a._M_hi)
+                       : 64 + std::countl_zero(__a._M_lo);
+    }
+
+    // fma(x, y, z) for finite, non-zero x and y: rounded once, as the sum of
+    // the 106-bit product of the significands, and that of z
+    constexpr double __fma_finite(double __x, double __y, double __z)
+    {
+      struct __unpacked { std::uint64_t _M_m; int _M_e; bool _M_neg; };
+      auto __unpack = [](double __d) {  // |d| = m 2^e, 2^52 <= m < 2^53
+        const std::uint64_t __b = __to_bits(__d);
+        std::uint64_t __m = __b & ((std::uint64_t(1) << 52) - 1);
+        int __e = static_cast<int>((__b >> 52) & 0x7ff);
+        if (__e == 0)
+        {
+          const int __s = std::countl_zero(__m) - 11;
+          __m <<= __s;
+          __e = 1 - __s;
+        }
+        else
+          __m |= std::uint64_t(1) << 52;
+        return __unpacked{__m, __e - 1075, bool(__b >> 63)};
+      };
+      const __unpacked __ux = __unpack(__x), __uy = __unpack(__y);
+      const std::uint64_t __mx[1] = {__ux._M_m}, __my[1] = {__uy._M_m};
+      std::uint64_t __p[2]{};
+      __mul_words(__mx, 1, __my, 1, __p);
+
+      // Each operand of the sum has its most significant bit at 125
+      __u128 __a = {__p[1], __p[0]};
+      const int __ps = __countl_zero(__a) - 2;
+      __a = __shl(__a, __ps);
+      int __ea = __ux._M_e + __uy._M_e - __ps;
+      bool __na = __ux._M_neg != __uy._M_neg;
+      __u128 __b = {0, 0};
+      int __eb = __ea;
+      bool __nb = __na;
+      if (__z != 0)
+      {
+        const __unpacked __uz = __unpack(__z);
+        __b = __shl(__u128{0, __uz._M_m}, 73);
+        __eb = __uz._M_e - 73;
+        __nb = __uz._M_neg;
+      }
+      if (__eb > __ea || (__eb == __ea && __less(__a, __b)))
+      {
+        const __u128 __t = __a;
+        __a = __b;
+        __b = __t;
+        const int __te = __ea;
+        __ea = __eb;
+        __eb = __te;
+        const bool __tn = __na;
+        __na = __nb;
+        __nb = __tn;
+      }
+      __b = __shr_sticky(__b, __ea - __eb);
+      __u128 __r = __na == __nb ? __add(__a, __b) : __sub(__a, __b);
+      if (__r._M_hi == 0 && __r._M_lo == 0)
+        return 0.0;
+
+      const int __lz = __countl_zero(__r);
+      __r = __shl(__r, __lz);
+      const int __er = __ea - __lz;           // r 2^er, r's top bit at 127
+      const int __lead = __er + 127;          // the exponent of that bit
+      const std::uint64_t __sign = std::uint64_t(__na) << 63;
+      if (__lead > 1023)
+        return __na ? -__inf : __inf;
+      const int __keep = __lead >= -1022 ? 53 : 53 - (-1022 - __lead);
+      if (__keep < 0 || (__keep == 0 && __r._M_hi == std::uint64_t(1) << 63
+                                     && __r._M_lo == 0))
+        return __from_bits(__sign);  // below half the least subnormal
+      std::uint64_t __m = 0;
+      bool __up;
+      if (__keep == 0)
+        __up = true;
+      else
+      {
+        const int __shift = 128 - __keep;  // at least 75
+        __m = __r._M_hi >> (__shift - 64);
+        const std::uint64_t __rem_hi = __r._M_hi & ((std::uint64_t(1) << (__shift - 64)) - 1);
+        const std::uint64_t __half = std::uint64_t(1) << (__shift - 65);
+        __up = __rem_hi > __half || (__rem_hi == __half && (__r._M_lo != 0 || (__m & 1)));
+      }
+      __m += __up;
+      if (__keep < 53)  // subnormal; or rounded up to the least normal
+        return __from_bits(__sign | __m);
+      const int __biased = __er + (128 - 53) + 1075;
+      if (__biased + (__m >> 53) >= 2047)
+        return __na ? -__inf : __inf;
+      return __from_bits(__sign | ((std::uint64_t(__biased - 1) << 52) + __m));
+    }
+
+    constexpr double __fma(double __x, double __y, double __z)
+    {
+      if (__x != __x || __y != __y || __z != __z)
+        return __nan;
+      const bool __xyinf = __nonfinite(__x) || __nonfinite(__y);
+      if (__xyinf)
+      {
+        if (__x == 0 || __y == 0)
+          return __nan;   // inf * 0
+        const bool __neg = (__x < 0) != (__y < 0);
+        if (__nonfinite(__z) && (__z < 0) != __neg)
+          return __nan;   // inf - inf
+        return __neg ? -__inf : __inf;
+      }
+      if (__nonfinite(__z))
+        return __z;
+      if (__x == 0 || __y == 0)
+        return __x * __y + __z;
+      return __fma_finite(__x, __y, __z);
+    }
+
+    // The product is exact as a double. Their sum is rounded to odd, so that
+    // its rounding to float is as that of the exact sum.
+    constexpr float __fma(float __x, float __y, float __z)
+    {
+      const double __p = double(__x) * double(__y);
+      if (__p != __p || __nonfinite(__p) || __nonfinite(__z) || __p == 0)
+        return float(__fma(double(__x), double(__y), double(__z)));
+      const __dd __s = __two_sum(__p, double(__z));
+      std::uint64_t __b = __to_bits(__s._M_hi);
+      if (__s._M_lo != 0 && !(__b & 1))
+        __b += (__s._M_lo > 0) == (__s._M_hi > 0) ? 1 : -1;
+      return float(__from_bits(__b));
+    }
+
+    // A long double, as the sum of an exact product, and z; as double-doubles
+    constexpr long double __fma(long double __x, long double __y,
+                                long double __z)
+    {
+      constexpr int __half = (std::numeric_limits<long double>::digits + 1) / 2;
+      struct __ld_pair { long double _M_hi, _M_lo; };
+      auto __split = [](long double __a) {
+        const long double __c = (static_cast<long double>(std::uint64_t(1)
+                                                          << __half) + 1) * __a;
+        const long double __hi = __c - (__c - __a);
+        return __ld_pair{__hi, __a - __hi};
+      };
+      const long double __p = __x * __y;
+      if (__p != __p || __p == 0 || __z == 0
+          || !((__p < 0 ? -__p : __p)
+               < std::numeric_limits<long double>::max() / 0x1p40L))
+        return __p + __z;
+      const auto [__xh, __xl] = __split(__x);
+      const auto [__yh, __yl] = __split(__y);
+      const long double __plo = ((__xh * __yh - __p) + __xh * __yl
+                                + __xl * __yh) + __xl * __yl;
+      const long double __s = __p + __z;
+      const long double __bb = __s - __p;
+      const long double __slo = (__p - (__s - __bb)) + (__z - __bb);
+      return __s + (__slo + __plo);
+    }
+
+    template <typename _Tp>
+    concept __cmath_arithmetic = std::is_arithmetic_v<_Tp>;
+
+    // float, long double, or an integer; those of <cmath> besides double
+    template <typename _Tp>
+    concept __cmath_other = std::is_arithmetic_v<_Tp>
+                            && !std::is_same_v<_Tp, double>;
+
+    // The type of the result: double for an integer
+    template <typename... _Tps>
+    using __cmath_t = decltype((std::conditional_t<std::is_integral_v<_Tps>,
+                                                   double, _Tps>() + ...));
+
+  } // namespace impl
+
+  constexpr double acos(double x) {
+    return std::is_constant_evaluated() ? impl::__acos(x) : std::acos(x);
+  }
+
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> acos(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return std::is_constant_evaluated() ? _Rp(impl::__acos(double(x)))
+                                        : std::acos(x);
+  }
+
+  constexpr double asin(double x) {
+    return std::is_constant_evaluated() ? impl::__asin(x) : std::asin(x);
+  }
+
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> asin(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return std::is_constant_evaluated() ? _Rp(impl::__asin(double(x)))
+                                        : std::asin(x);
+  }
 
   constexpr double atan(double x) {
-    return (x >= 0) ? atan_cmplmntry(x) : -atan_cmplmntry(-x);
+    return std::is_constant_evaluated() ? impl::__atan(x) : std::atan(x);
+  }
+
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> atan(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return std::is_constant_evaluated() ? _Rp(impl::__atan(double(x)))
+                                        : std::atan(x);
   }
 
   constexpr double atan2(double y, double x) {
-    return           x >  0 ? atan(y/x)        :
-           y >= 0 && x <  0 ? atan(y/x) + CEST_M_PI :
-           y <  0 && x <  0 ? atan(y/x) - CEST_M_PI :
-           y >  0 && x == 0 ?  CEST_M_PI_2          :
-           y <  0 && x == 0 ? -CEST_M_PI_2          : 0;   // 0 == undefined
+    return std::is_constant_evaluated() ? impl::__atan2(y, x)
+                                        : std::atan2(y, x);
   }
 
-  constexpr int ceil(double v) {
-    return ((double)(int)v != v && v > 0) ?  v + 1 : v;
+  template <impl::__cmath_arithmetic _Tp, impl::__cmath_arithmetic _Up>
+  constexpr impl::__cmath_t<_Tp, _Up> atan2(_Tp y, _Up x) {
+    using _Rp = impl::__cmath_t<_Tp, _Up>;
+    return std::is_constant_evaluated()
+           ? _Rp(impl::__atan2(double(y), double(x)))
+           : std::atan2(_Rp(y), _Rp(x));
+  }
+
+  constexpr double cbrt(double x) {
+    return std::is_constant_evaluated() ? impl::__cbrt(x) : std::cbrt(x);
+  }
+
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> cbrt(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return std::is_constant_evaluated() ? _Rp(impl::__cbrt(double(x)))
+                                        : std::cbrt(x);
+  }
+
+  constexpr double ceil(double x) {
+    return impl::__round_bits(x, impl::__round_to::_S_up);
+  }
+
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> ceil(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return impl::__round_bits(_Rp(x), impl::__round_to::_S_up);
   }
 
   constexpr double cos(double x) {
-    return sin(CEST_M_PI_2 - x);
+    return std::is_constant_evaluated() ? impl::__cos(x) : std::cos(x);
+  }
+
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> cos(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return std::is_constant_evaluated() ? _Rp(impl::__cos(double(x)))
+                                        : std::cos(x);
   }
 
   constexpr double cosh(double x) {
-    return sqrt(1.0 + square(sinh(x)));
+    return std::is_constant_evaluated() ? impl::__cosh(x) : std::cosh(x);
+  }
+
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> cosh(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return std::is_constant_evaluated() ? _Rp(impl::__cosh(double(x)))
+                                        : std::cosh(x);
   }
 
-  constexpr int floor(double v) {
-    return ((double)(int)v != v && v < 0) ?  v - 1 : v;
+  constexpr double exp(double x) {
+    return std::is_constant_evaluated() ? impl::__exp(x) : std::exp(x);
+  }
+
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> exp(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return std::is_constant_evaluated() ? _Rp(impl::__exp(double(x)))
+                                        : std::exp(x);
+  }
+
+  constexpr double exp2(double x) {
+    return std::is_constant_evaluated() ? impl::__exp2(x) : std::exp2(x);
+  }
+
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> exp2(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return std::is_constant_evaluated() ? _Rp(impl::__exp2(double(x)))
+                                        : std::exp2(x);
+  }
+
+  // abs(double) and fabs(double) are in cest/bits/abs.hpp
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> fabs(_Tp x) {
+    return x < 0 ? -impl::__cmath_t<_Tp>(x) : impl::__cmath_t<_Tp>(x);
   }
 
+  constexpr double floor(double x) {
+    return impl::__round_bits(x, impl::__round_to::_S_down);
+  }
+
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> floor(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return impl::__round_bits(_Rp(x), impl::__round_to::_S_down);
+  }
+
+  constexpr double fma(double x, double y, double z) {
+    return std::is_constant_evaluated() ? impl::__fma(x, y, z)
+                                        : std::fma(x, y, z);
+  }
+
+  template <impl::__cmath_arithmetic _Tp, impl::__cmath_arithmetic _Up,
+            impl::__cmath_arithmetic _Vp>
+  constexpr impl::__cmath_t<_Tp, _Up, _Vp> fma(_Tp x, _Up y, _Vp z) {
+    using _Rp = impl::__cmath_t<_Tp, _Up, _Vp>;
+    return std::is_constant_evaluated() ? impl::__fma(_Rp(x), _Rp(y), _Rp(z))
+                                        : std::fma(_Rp(x), _Rp(y), _Rp(z));
+  }
+
+  constexpr double fmod(double x, double y) {
+    return std::is_constant_evaluated() ? impl::__fmod(x, y)
+                                        : std::fmod(x, y);
+  }
+
+  template <impl::__cmath_arithmetic _Tp, impl::__cmath_arithmetic _Up>
+  constexpr impl::__cmath_t<_Tp, _Up> fmod(_Tp x, _Up y) {
+    using _Rp = impl::__cmath_t<_Tp, _Up>;
+    return std::is_constant_evaluated() ? impl::__fmod(_Rp(x), _Rp(y))
+                                        : std::fmod(_Rp(x), _Rp(y));
+  }
+
+  constexpr double hypot(double x, double y) {
+    return std::is_constant_evaluated() ? impl::__hypot(x, y)
+                                        : std::hypot(x, y);
+  }
+
+  template <impl::__cmath_arithmetic _Tp, impl::__cmath_arithmetic _Up>
+  constexpr impl::__cmath_t<_Tp, _Up> hypot(_Tp x, _Up y) {
+    using _Rp = impl::__cmath_t<_Tp, _Up>;
+    return std::is_constant_evaluated()
+           ? _Rp(impl::__hypot(double(x), double(y)))
+           : std::hypot(_Rp(x), _Rp(y));
+  }
+
+  constexpr double log(double x) {
+    return std::is_constant_evaluated() ? impl::__log(x) : std::log(x);
+  }
+
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> log(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return std::is_constant_evaluated() ? _Rp(impl::__log(double(x)))
+                                        : std::log(x);
+  }
+
+  constexpr double log10(double x) {
+    return std::is_constant_evaluated() ? impl::__log10(x) : std::log10(x);
+  }
+
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> log10(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return std::is_constant_evaluated() ? _Rp(impl::__log10(double(x)))
+                                        : std::log10(x);
+  }
+
+  constexpr double log2(double x) {
+    return std::is_constant_evaluated() ? impl::__log2(x) : std::log2(x);
+  }
+
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> log2(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return std::is_constant_evaluated() ? _Rp(impl::__log2(double(x)))
+                                        : std::log2(x);
+  }
+
+  constexpr double pow(double base, double exponent) {
+    return std::is_constant_evaluated() ? impl::__pow(base, exponent)
+                                        : std::pow(base, exponent);
+  }
+
+  // As std::pow(double, int) since C++11: the int is converted to a double
   constexpr double pow(double base, int exponent) {
-    return exponent <  0 ? 1.0 / pow(base,-exponent) :
-           exponent == 0 ? 1.                        :
-           exponent == 1 ? base                      :
-           base * pow(base,exponent-1);
+    return pow(base, static_cast<double>(exponent));
   }
 
-  constexpr double sqrt(double x) {
-    return sqrt_helper(x,1.0);
+  template <impl::__cmath_arithmetic _Tp, impl::__cmath_arithmetic _Up>
+  constexpr impl::__cmath_t<_Tp, _Up> pow(_Tp base, _Up exponent) {
+    using _Rp = impl::__cmath_t<_Tp, _Up>;
+    return std::is_constant_evaluated()
+           ? _Rp(impl::__pow(double(base), double(exponent)))
+           : std::pow(_Rp(base), _Rp(exponent));
+  }
+
+  constexpr double round(double x) {
+    return impl::__round_bits(x, impl::__round_to::_S_nearest);
+  }
+
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> round(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return impl::__round_bits(_Rp(x), impl::__round_to::_S_nearest);
   }
 
-  constexpr double sin(double x) { 
-    return sin_helper(x < 0 ? -x+CEST_M_PI : x);
+  constexpr double sin(double x) {
+    return std::is_constant_evaluated() ? impl::__sin(x) : std::sin(x);
+  }
+
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> sin(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return std::is_constant_evaluated() ? _Rp(impl::__sin(double(x)))
+                                        : std::sin(x);
   }
 
   constexpr double sinh(double x) {
-    return x < 0 ? -sinh_helper(-x) : sinh_helper(x);
+    return std::is_constant_evaluated() ? impl::__sinh(x) : std::sinh(x);
   }
 
-  // exp(x) = e^n . e^r (where n is an integer, and -0.5 > r < 0.5
-  // exp(r) = e^r = 1 + r + r^2/2 + r^3/6 + r^4/24 + r^5/120
-  constexpr double exp(double x) {
-    return pow(CEST_M_E,nearest(x)) * exp_helper(fraction(x));
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> sinh(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return std::is_constant_evaluated() ? _Rp(impl::__sinh(double(x)))
+                                        : std::sinh(x);
   }
 
-  constexpr double log(double x) {
-    return x == 0 ? -std::numeric_limits<double>::infinity() :
-           x <  0 ?  std::numeric_limits<double>::quiet_NaN() :
-           2.0 * log_helper(sqrt(mantissa(x))) + 2.3025851 * exponent(x);
+  constexpr double sqrt(double x) {
+    return std::is_constant_evaluated() ? impl::__sqrt(x) : std::sqrt(x);
+  }
+
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> sqrt(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return std::is_constant_evaluated() ? _Rp(impl::__sqrt(double(x)))
+                                        : std::sqrt(x);
+  }
+
+  constexpr double tan(double x) {
+    return std::is_constant_evaluated() ? impl::__tan(x) : std::tan(x);
   }
 
-#undef CEST_M_PI
-#undef CEST_M_PI_2
-#undef CEST_M_E
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> tan(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return std::is_constant_evaluated() ? _Rp(impl::__tan(double(x)))
+                                        : std::tan(x);
+  }
+
+  constexpr double trunc(double x) {
+    return impl::__round_bits(x, impl::__round_to::_S_zero);
+  }
+
+  template <impl::__cmath_other _Tp>
+  constexpr impl::__cmath_t<_Tp> trunc(_Tp x) {
+    using _Rp = impl::__cmath_t<_Tp>;
+    return impl::__round_bits(_Rp(x), impl::__round_to::_S_zero);
+  }
 
 } // namespace cest
 
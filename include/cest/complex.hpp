@@ -9,6 +9,7 @@
 
 #include <type_traits>
 #include "cest/algorithm.hpp"
+#include "cest/sstream.hpp"
 
 // Get rid of a macro possibly defined in <complex.h>
 #undef complex
@@ -460,7 +461,7 @@ namespace cest
 
   ///  Extraction operator for complex values.
   template<typename _Tp, typename _CharT, class _Traits>
-    basic_istream<_CharT, _Traits>&
+    constexpr basic_istream<_CharT, _Traits>&
     operator>>(basic_istream<_CharT, _Traits>& __is, complex<_Tp>& __x)
     {
       bool __fail = true;
@@ -513,18 +514,16 @@ namespace cest
     }
 
   ///  Insertion operator for complex values.
-  // PGK: Commented out as C'est has no basic_ostringstream
-  /*template<typename _Tp, typename _CharT, class _Traits>
-    basic_ostream<_CharT, _Traits>&
+  template<typename _Tp, typename _CharT, class _Traits>
+    constexpr basic_ostream<_CharT, _Traits>&
     operator<<(basic_ostream<_CharT, _Traits>& __os, const complex<_Tp>& __x)
     {
       basic_ostringstream<_CharT, _Traits> __s;
       __s.flags(__os.flags());
-      __s.imbue(__os.getloc());
       __s.precision(__os.precision());
-      __s << '(' << __x.real() << ',' << __x.imag() << ')';
+      __s << _CharT('(') << __x.real() << _CharT(',') << __x.imag() << _CharT(')');
       return __os << __s.str();
-    }*/
+    }
 
   // Values
 #if __cplusplus >= 201103L
@@ -0,0 +1,275 @@
+#ifndef _CEST_CONCURRENT_QUEUE_HPP_
+#define _CEST_CONCURRENT_QUEUE_HPP_
+
+#include <memory>      // std::allocator, std::construct_at, std::destroy_at
+#include <atomic>      // std::atomic_ref
+#include <type_traits>
+#include <utility>     // std::move, std::forward
+#include <cstddef>     // std::size_t, std::ptrdiff_t
+
+// The head and tail indices of the concurrent queues are each given a cache
+// line of their own; so the producer and consumer threads don't contend for
+// one. std::hardware_destructive_interference_size isn't used as its value
+// may vary between compiler flags.
+#ifndef CEST_CACHE_LINE_SIZE
+#define CEST_CACHE_LINE_SIZE 64
+#endif
+
+namespace cest {
+
+namespace impl {
+
+// As with the counts of an atomic_shared_ptr: the indices are plain integers,
+// accessed through std::atomic_ref at runtime. In a constant expression there
+// is only one thread; and the operations are sequential.
+constexpr std::size_t load_acquire(const std::size_t& n) noexcept
+{
+  if (std::is_constant_evaluated())
+    return n;
+  return std::atomic_ref<std::size_t>(const_cast<std::size_t&>(n)).load(
+           std::memory_order_acquire);
+}
+
+constexpr std::size_t load_relaxed(const std::size_t& n) noexcept
+{
+  if (std::is_constant_evaluated())
+    return n;
+  return std::atomic_ref<std::size_t>(const_cast<std::size_t&>(n)).load(
+           std::memory_order_relaxed);
+}
+
+constexpr void store_release(std::size_t& n, std::size_t x) noexcept
+{
+  if (std::is_constant_evaluated())
+    n = x;
+  else
+    std::atomic_ref<std::size_t>(n).store(x, std::memory_order_release);
+}
+
+// On failure, expected is updated with the current value of n
+constexpr bool cas_relaxed(std::size_t& n, std::size_t& expected,
+                           std::size_t desired) noexcept
+{
+  if (std::is_constant_evaluated()) {
+    if (n != expected) {
+      expected = n;
+      return false;
+    }
+    n = desired;
+    return true;
+  }
+  return std::atomic_ref<std::size_t>(n).compare_exchange_weak(
+           expected, desired, std::memory_order_relaxed);
+}
+
+constexpr std::size_t round_up_pow2(std::size_t n) noexcept
+{
+  std::size_t cap = 1;
+  while (cap < n)
+    cap *= 2;
+  return cap;
+}
+
+} // namespace impl
+
+// A bounded, lock-free queue for one producer thread and one consumer thread.
+// The capacity is rounded up to a power of two. Each side keeps a cached copy
+// of the other's index, and only reloads it when the queue looks full (or
+// empty); so the shared cache lines are seldom touched.
+template <
+  class T,
+  class Allocator = std::allocator<T>
+>
+class spsc_queue {
+public:
+
+  using value_type     = T;
+  using allocator_type = Allocator;
+  using size_type      = std::size_t;
+
+  explicit constexpr spsc_queue(size_type capacity,
+                                const Allocator& alloc = Allocator())
+    : m_alloc(alloc), m_mask(impl::round_up_pow2(capacity) - 1),
+      m_p(m_alloc.allocate(m_mask + 1)) {}
+
+  spsc_queue(const spsc_queue&) = delete;
+  spsc_queue& operator=(const spsc_queue&) = delete;
+
+  constexpr ~spsc_queue()
+  {
+    for (size_type i = m_head; i != m_tail; ++i)
+      std::destroy_at(&m_p[i & m_mask]);
+    m_alloc.deallocate(m_p, m_mask + 1);
+  }
+
+  // Called only by the producer
+  template <class... Args>
+  constexpr bool try_emplace(Args&&... args)
+  {
+    const size_type tail = m_tail;
+    if (tail - m_head_cache > m_mask) {
+      m_head_cache = impl::load_acquire(m_head);
+      if (tail - m_head_cache > m_mask)
+        return false;
+    }
+    std::construct_at(&m_p[tail & m_mask], std::forward<Args>(args)...);
+    impl::store_release(m_tail, tail + 1);
+    return true;
+  }
+
+  constexpr bool try_push(const T& value) { return try_emplace(value); }
+  constexpr bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+  // Called only by the consumer
+  constexpr bool try_pop(T& value)
+  {
+    const size_type head = m_head;
+    if (head == m_tail_cache) {
+      m_tail_cache = impl::load_acquire(m_tail);
+      if (head == m_tail_cache)
+        return false;
+    }
+    T* p = &m_p[head & m_mask];
+    value = std::move(*p);
+    std::destroy_at(p);
+    impl::store_release(m_head, head + 1);
+    return true;
+  }
+
+  // Exact only when called by the producer or consumer, with the other idle
+  constexpr size_type size() const noexcept {
+    return impl::load_acquire(m_tail) - impl::load_acquire(m_head);
+  }
+  [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+  constexpr size_type capacity() const noexcept { return m_mask + 1; }
+
+private:
+
+  [[no_unique_address]] allocator_type m_alloc;
+  size_type m_mask;
+  T*        m_p;
+
+  // written by the consumer
+  alignas(CEST_CACHE_LINE_SIZE) size_type m_head = 0;
+  size_type m_tail_cache = 0;
+
+  // written by the producer
+  alignas(CEST_CACHE_LINE_SIZE) size_type m_tail = 0;
+  size_type m_head_cache = 0; // n.b. sizeof is a multiple of the alignment
+};
+
+// A bounded, lock-free queue for any number of producers and consumers;
+// Dmitry Vyukov's algorithm. Each cell holds a sequence number which tells a
+// producer (or consumer) whether the cell it has claimed is free (or full).
+template <
+  class T,
+  class Allocator = std::allocator<T>
+>
+class mpmc_queue {
+
+  struct cell
+  {
+    constexpr cell(std::size_t seq) : m_seq(seq) {}
+    constexpr ~cell() {}
+
+    std::size_t m_seq;
+    union { T m_value; };
+  };
+
+  using cell_alloc_t =
+    typename std::allocator_traits<Allocator>::template rebind_alloc<cell>;
+
+public:
+
+  using value_type     = T;
+  using allocator_type = Allocator;
+  using size_type      = std::size_t;
+
+  explicit constexpr mpmc_queue(size_type capacity,
+                                const Allocator& alloc = Allocator())
+    : m_alloc(alloc), m_mask(impl::round_up_pow2(capacity) - 1),
+      m_cells(m_alloc.allocate(m_mask + 1))
+  {
+    for (size_type i = 0; i <= m_mask; ++i)
+      std::construct_at(&m_cells[i], i);
+  }
+
+  mpmc_queue(const mpmc_queue&) = delete;
+  mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+  constexpr ~mpmc_queue()
+  {
+    for (size_type i = m_head; i != m_tail; ++i)
+      std::destroy_at(&m_cells[i & m_mask].m_value);
+    for (size_type i = 0; i <= m_mask; ++i)
+      std::destroy_at(&m_cells[i]);
+    m_alloc.deallocate(m_cells, m_mask + 1);
+  }
+
+  template <class... Args>
+  constexpr bool try_emplace(Args&&... args)
+  {
+    size_type pos = impl::load_relaxed(m_tail);
+    for (;;) {
+      cell& c = m_cells[pos & m_mask];
+      const auto dif = std::ptrdiff_t(impl::load_acquire(c.m_seq) - pos);
+      if (dif == 0) {
+        if (impl::cas_relaxed(m_tail, pos, pos + 1)) {
+          std::construct_at(&c.m_value, std::forward<Args>(args)...);
+          impl::store_release(c.m_seq, pos + 1);
+          return true;
+        }
+      } else if (dif < 0) {
+        return false; // full
+      } else {
+        pos = impl::load_relaxed(m_tail);
+      }
+    }
+  }
+
+  constexpr bool try_push(const T& value) { return try_emplace(value); }
+  constexpr bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+  constexpr bool try_pop(T& value)
+  {
+    size_type pos = impl::load_relaxed(m_head);
+    for (;;) {
+      cell& c = m_cells[pos & m_mask];
+      const auto dif = std::ptrdiff_t(impl::load_acquire(c.m_seq) - (pos + 1));
+      if (dif == 0) {
+        if (impl::cas_relaxed(m_head, pos, pos + 1)) {
+          value = std::move(c.m_value);
+          std::destroy_at(&c.m_value);
+          impl::store_release(c.m_seq, pos + m_mask + 1);
+          return true;
+        }
+      } else if (dif < 0) {
+        return false; // empty
+      } else {
+        pos = impl::load_relaxed(m_head);
+      }
+    }
+  }
+
+  // Approximate while other threads push or pop
+  constexpr size_type size() const noexcept {
+    const size_type head = impl::load_relaxed(m_head);
+    const size_type tail = impl::load_relaxed(m_tail);
+    return std::ptrdiff_t(tail - head) > 0 ? tail - head : 0;
+  }
+  [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+  constexpr size_type capacity() const noexcept { return m_mask + 1; }
+
+private:
+
+  [[no_unique_address]] cell_alloc_t m_alloc;
+  size_type m_mask;
+  cell*     m_cells;
+
+  alignas(CEST_CACHE_LINE_SIZE) size_type m_tail = 0; // producers
+  alignas(CEST_CACHE_LINE_SIZE) size_type m_head = 0; // consumers
+};
+
+} // namespace cest
+
+#endif // _CEST_CONCURRENT_QUEUE_HPP_
@@ -5,70 +5,218 @@
 #include <cassert>
 #include "cest/iostream.hpp"
 #include "cest/string.hpp"
+#include "cest/spanstream.hpp"
+#include "cest/bits/printf.hpp" // cest::impl::__printf_to, __check_printf
+#include <algorithm>            // std::min
+#include <concepts>             // std::convertible_to
+#include <string>               // std::char_traits
+#include <type_traits>          // std::type_identity_t
 
 namespace cest {
 
-// Here, we have istream, not iostream, as iostream misleadingly only inherits
-// from istream due to the prohibition of constexpr virtual inheritance.
+// Here, we have istream, not iostream, as a FILE* is only read from; and as
+// iostream, without a virtual base, has two basic_ios subobjects.
 // (In libstdc++ FILE is a typedef of _IO_FILE struct.)
 using FILE = istream;
 
-constexpr FILE* stdin = &cest::cin;
-constexpr ostream* stdout = &cest::cout;
-constexpr ostream* stderr = &cest::cerr;
+namespace impl {
 
-// avoid warning: format string is not a string literal (-Wformat-security)
-constexpr int printf(const char* format)
+// As std::printf: characters accumulate in an array on the stack, and are
+// written to the C stream with std::fwrite when it is full, and at the end
+class __cfile_sink
 {
-  if (!std::is_constant_evaluated())
+public:
+  explicit __cfile_sink(std::FILE* __f) : _M_file(__f) { }
+
+  void _M_put(const char* __s, std::size_t __n)
   {
-    return std::printf("%s", format);
+    for (std::size_t __k; __n; __s += __k, __n -= __k)
+    {
+      if (_M_n == sizeof _M_buf)
+        _M_flush();
+      __k = std::min(__n, sizeof _M_buf - _M_n);
+      std::char_traits<char>::copy(_M_buf + _M_n, __s, __k);
+      _M_n += __k;
+    }
   }
 
-  return 0;
-}
+  void _M_fill(char __c, std::size_t __n)
+  {
+    for (std::size_t __k; __n; __n -= __k)
+    {
+      if (_M_n == sizeof _M_buf)
+        _M_flush();
+      __k = std::min(__n, sizeof _M_buf - _M_n);
+      std::char_traits<char>::assign(_M_buf + _M_n, __k, __c);
+      _M_n += __k;
+    }
+  }
 
-template <typename... Ts>
-constexpr int printf(const char* format, Ts&&... xs)
+  // false if a write failed
+  bool _M_flush()
+  {
+    if (_M_n && std::fwrite(_M_buf, 1, _M_n, _M_file) != _M_n)
+      _M_failed = true;
+    _M_n = 0;
+    return !_M_failed;
+  }
+
+private:
+  std::FILE*  _M_file;
+  std::size_t _M_n = 0;
+  bool        _M_failed = false;
+  char        _M_buf[256];
+};
+
+// Writes to the streambuf of an ostream, which has a sentry
+template <typename _Ostream>
+struct __ostream_sink
 {
-  if (!std::is_constant_evaluated())
+  _Ostream& _M_os;
+
+  constexpr void _M_put(const char* __s, std::size_t __n)
+  {
+    if (_M_os.good())
+      _M_os._M_write(__s, static_cast<streamsize>(__n));
+  }
+
+  constexpr void _M_fill(char __c, std::size_t __n)
   {
-    return std::printf(format, std::forward<Ts>(xs)...);
+    char __buf[32];
+    std::char_traits<char>::assign(__buf, sizeof __buf, __c);
+    for (std::size_t __k; __n; __n -= __k)
+    {
+      __k = std::min(__n, sizeof __buf);
+      _M_put(__buf, __k);
+    }
   }
+};
 
-  return 0; // positive; not an error; 0 characters output (constexpr)
+// At runtime only; so also std::printf's stdout, before cest::stdout hides it.
+// cest::cout is flushed first; as if stdout were tied to it.
+template <typename... _Args>
+int __printf_stdout(const char* __fmt, const _Args&... __args)
+{
+  cest::cout.flush();
+  __cfile_sink __sink(stdout);
+  const int __n = __printf_to(__sink, __fmt, __args...);
+  return __sink._M_flush() ? __n : -1;
 }
 
-constexpr int fprintf(ostream* stream, const char* format)
+// A format string returned by runtime_printf_format; which isn't checked
+// until it is used, when an invalid one gives -1
+struct __runtime_printf_format
+{
+  const char* _M_str;
+};
+
+} // namespace impl
+
+// A format string of the printf family; checked against the argument types
+// by the consteval constructor, as is cest::basic_format_string. A format
+// which is only known at runtime is given by runtime_printf_format.
+template <typename... _Args>
+class basic_printf_string
 {
-  if (!std::is_constant_evaluated())
+public:
+  template <typename _Tp>
+    requires std::convertible_to<const _Tp&, const char*>
+  consteval basic_printf_string(const _Tp& __s)
+  : _M_str(__s)
+  { impl::__check_printf<_Args...>(_M_str); }
+
+  constexpr basic_printf_string(impl::__runtime_printf_format __s) noexcept
+  : _M_str(__s._M_str)
+  { }
+
+  constexpr const char* get() const noexcept { return _M_str; }
+
+private:
+  const char* _M_str;
+};
+
+template <typename... _Args>
+using printf_string = basic_printf_string<std::type_identity_t<_Args>...>;
+
+// As std::runtime_format: the format is not checked at compile time
+constexpr impl::__runtime_printf_format
+runtime_printf_format(const char* __s) noexcept
+{ return {__s}; }
+
+constexpr FILE* stdin = &cest::cin;
+constexpr ostream* stdout = &cest::cout;
+constexpr ostream* stderr = &cest::cerr;
+
+// The conversions are those of cest/bits/printf.hpp: %d %i %u %o %x %X %c
+// %s %p %f %F %e %E %g %G %a %A and %%; with flags, width and precision. The
+// arguments, and so their types, are known; so a length modifier is only
+// significant as hh or h. Within a constant expression, the characters are
+// only counted. An invalid format string is a compile-time error.
+template <typename... Ts>
+constexpr int printf(printf_string<Ts...> format, Ts&&... xs)
+{
+  if (std::is_constant_evaluated())
   {
-    (*stream) << format;
+    impl::__count_sink sink;
+    return impl::__printf_to(sink, format.get(), xs...);
   }
 
-  return 0;
+  return impl::__printf_stdout(format.get(), xs...);
 }
 
-// FILE* for param 1 would itroduce the issues described above. 
+// FILE* for param 1 would itroduce the issues described above. The output is
+// formatted directly into the stream's buffer; within a constant expression,
+// output to cest::cout, cerr or clog is discarded, and only counted.
 template <typename... Ts>
-constexpr int fprintf(ostream* stream, const char* format, Ts&&... xs)
+constexpr int fprintf(ostream* stream, printf_string<Ts...> format,
+                      Ts&&... xs)
 {
-  if (!std::is_constant_evaluated())
+  if (stream->_M_discard())
   {
-    int nbytes = std::snprintf(nullptr, 0, format, std::forward<Ts>(xs)...);
-    char *psz = new char[nbytes+1];
-    std::snprintf(psz, nbytes+1, format, std::forward<Ts>(xs)...);
-    (*stream) << psz;
-    delete [] psz;
-    return nbytes;
+    impl::__count_sink sink;
+    return impl::__printf_to(sink, format.get(), xs...);
   }
 
-  return 0;
+  int n = -1;
+  ostream::sentry cerb(*stream);
+  if (cerb)
+  {
+    __try
+    {
+      impl::__ostream_sink<ostream> sink{*stream};
+      n = impl::__printf_to(sink, format.get(), xs...);
+    }
+#if !defined(_LIBCPP_VERSION)
+    __catch(__cxxabiv1::__forced_unwind&)
+    {
+      stream->_M_setstate(ios_base::badbit);
+      __throw_exception_again;
+    }
+#endif
+    __catch(...)
+    { stream->_M_setstate(ios_base::badbit); }
+  }
+  return stream->bad() ? -1 : n;
+}
+
+// At most bufsz - 1 characters are written, followed by a null; the result
+// is the number of characters which the whole output would have
+template <typename... Ts>
+constexpr int snprintf(char* buffer, std::size_t bufsz,
+                       printf_string<Ts...> format, Ts&&... xs)
+{
+  impl::__array_sink sink{buffer, bufsz ? buffer + bufsz - 1 : buffer};
+  const int n = impl::__printf_to(sink, format.get(), xs...);
+  if (bufsz)
+    *sink._M_p = '\0';
+  return n;
 }
 
+// As with POSIX fmemopen, the stream reads the caller's buffer in place; it
+// is not copied, and must outlive the stream.
 constexpr FILE* fmemopen(char* buf, size_t size, const char* /*mode*/)
 {
-  return new stringstream(string(buf,size));
+  return new ispanstream(std::span<char>(buf, size));
 }
 
 // Param #1 of fmemopen and fread is char* (instead of void*) because:
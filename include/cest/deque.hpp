@@ -150,8 +150,12 @@ public:
     value_type* const* m_ppchunk = nullptr; // address of the vector element
   };
 
-  constexpr deque()
+  constexpr deque() : deque(Allocator()) {}
+
+  explicit constexpr deque(const Allocator& alloc)
+    : m_alloc(alloc), m_chunks(chunk_alloc_type(alloc))
   {
+    impl::count(m_alloc, &alloc_stats::chunk_allocations);
     value_type *p = m_alloc.allocate(CHUNK_SIZE);
     m_front = CHUNK_SIZE / 2;
     m_back  = CHUNK_SIZE / 2 - 1;
@@ -160,14 +164,16 @@ public:
     m_size = 0;
   }
 
-  constexpr deque(const deque& other) : deque()
+  constexpr deque(const deque& other)
+    : deque(std::allocator_traits<Allocator>::
+              select_on_container_copy_construction(other.m_alloc))
   {
     for (size_type i = 0; i < other.size(); ++i)
       push_back(other[i]);
   }
 
   constexpr deque(std::initializer_list<T> init,
-                  const Allocator& alloc = Allocator()) : deque()
+                  const Allocator& alloc = Allocator()) : deque(alloc)
   {
     for (const auto &x : init) { push_back(x); }
   }
@@ -187,6 +193,8 @@ public:
     return *this;
   }
 
+  constexpr allocator_type get_allocator() const noexcept { return m_alloc; }
+
   constexpr void clear() noexcept
   {
     for (size_type i = 0; i < size(); ++i)
@@ -222,6 +230,14 @@ public:
     std::construct_at(&m_chunks[m_back_chunk][m_back],   std::move(value));
   }
 
+  template <class... Args>
+  constexpr reference emplace_back( Args&&... args )
+  {
+    push_back_helper();
+    return *std::construct_at(&m_chunks[m_back_chunk][m_back],
+                              std::forward<Args>(args)...);
+  }
+
   constexpr void pop_back()
   {
     if (!empty()) {
@@ -304,6 +320,7 @@ private:
     {
       if (m_front_chunk == 0)
       {
+        impl::count(m_alloc, &alloc_stats::chunk_allocations);
         value_type *p = m_alloc.allocate(CHUNK_SIZE);
         m_chunks.push_back(p);
         std::rotate(m_chunks.rbegin(), m_chunks.rbegin() + 1, m_chunks.rend());
@@ -329,6 +346,7 @@ private:
     {
       if (m_back_chunk == m_chunks.size() - 1)
       {
+        impl::count(m_alloc, &alloc_stats::chunk_allocations);
         value_type *p = m_alloc.allocate(CHUNK_SIZE);
         m_chunks.push_back(p);
         ++m_back_chunk;
@@ -344,15 +362,24 @@ private:
     m_size++;
   }
 
+  using chunk_alloc_type = typename std::allocator_traits<Allocator>::
+                             template rebind_alloc<value_type*>;
+
   allocator_type      m_alloc;
   size_type           m_front;
   size_type           m_back;
   size_type           m_front_chunk;
   size_type           m_back_chunk;
   size_type           m_size;
-  vector<value_type*> m_chunks;
+  vector<value_type*, chunk_alloc_type> m_chunks;
 };
 
+namespace pmr {
+template <typename T> class polymorphic_allocator; // cest/memory_resource.hpp
+template <class T>
+using deque = cest::deque<T, polymorphic_allocator<T>>;
+} // namespace pmr
+
 } // namespace cest
 
 #endif // _CEST_DEQUE_HPP_
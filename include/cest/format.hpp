@@ -0,0 +1,1024 @@
+#ifndef _CEST_FORMAT_HPP_
+#define _CEST_FORMAT_HPP_
+
+// A <format> subset: format, format_to and formatted_size; with formatters
+// for the integer, character, bool, floating-point, string and pointer types;
+// and cest::complex. As with std::format, the format string is checked against
+// the argument types at compile time, by the consteval constructor of
+// basic_format_string; an invalid format string does not compile. There is
+// no locale, and nothing is allocated but the result of cest::format; even a
+// long floating-point value is written through a buffer on the stack.
+//
+// The argument types are known, so the arguments are not type-erased. Instead,
+// a basic_format_context is parameterised on the output iterator; and so a
+// user-defined formatter's format member should be a template on its
+// context. Widths count code units. A long double is formatted as a double.
+
+#include "string.hpp"           // cest::basic_string
+#include "bits/to_chars.hpp"    // cest::impl::__uint_to_chars, __fp_formatter
+#include <algorithm>            // std::copy_n, std::fill_n
+#include <climits>              // LLONG_MAX, INT_MAX
+#include <concepts>             // std::floating_point, std::convertible_to
+#include <cstddef>              // std::size_t, std::nullptr_t
+#include <cstdint>              // std::uintptr_t
+#include <iterator>             // std::output_iterator_tag
+#include <limits>               // std::numeric_limits
+#include <stdexcept>            // std::runtime_error
+#include <string>               // std::basic_string
+#include <string_view>
+#include <type_traits>
+#include <utility>              // std::cmp_less, std::cmp_greater
+
+namespace cest {
+
+template <typename _Tp> struct complex;
+
+class format_error : public std::runtime_error
+{
+public:
+  using std::runtime_error::runtime_error;
+};
+
+template <typename _Tp, typename _CharT = char>
+struct formatter
+{
+  formatter() = delete;  // disabled: _Tp is not formattable
+};
+
+template <typename _CharT>
+class basic_format_parse_context
+{
+public:
+  using char_type      = _CharT;
+  using const_iterator = const _CharT*;
+  using iterator       = const_iterator;
+
+  constexpr explicit
+  basic_format_parse_context(std::basic_string_view<_CharT> __fmt,
+                             std::size_t __num_args = 0) noexcept
+  : _M_begin(__fmt.data()), _M_end(__fmt.data() + __fmt.size()),
+    _M_num_args(__num_args)
+  { }
+
+  basic_format_parse_context(const basic_format_parse_context&) = delete;
+  void operator=(const basic_format_parse_context&) = delete;
+
+  constexpr const_iterator begin() const noexcept { return _M_begin; }
+  constexpr const_iterator end() const noexcept { return _M_end; }
+  constexpr void advance_to(const_iterator __it) { _M_begin = __it; }
+
+  constexpr std::size_t next_arg_id()
+  {
+    if (_M_indexing == _S_manual)
+      throw format_error("format error: automatic and manual argument "
+                         "indexing are mixed");
+    _M_indexing = _S_auto;
+    if (_M_next >= _M_num_args)
+      throw format_error("format error: too few arguments");
+    return _M_next++;
+  }
+
+  constexpr void check_arg_id(std::size_t __id)
+  {
+    if (_M_indexing == _S_auto)
+      throw format_error("format error: automatic and manual argument "
+                         "indexing are mixed");
+    _M_indexing = _S_manual;
+    if (__id >= _M_num_args)
+      throw format_error("format error: argument index out of range");
+  }
+
+  // A dynamic width or precision is given by an integer argument. The types
+  // are known only while the format string is checked.
+  constexpr void _M_check_integral(std::size_t __id) const
+  {
+    if (_M_integral && !_M_integral[__id])
+      throw format_error("format error: a dynamic width or precision "
+                         "argument is not an integer");
+  }
+
+  const bool* _M_integral = nullptr;
+
+private:
+  enum _Indexing : unsigned char { _S_unknown, _S_manual, _S_auto };
+
+  const _CharT* _M_begin;
+  const _CharT* _M_end;
+  std::size_t   _M_num_args;
+  std::size_t   _M_next = 0;
+  _Indexing     _M_indexing = _S_unknown;
+};
+
+using format_parse_context = basic_format_parse_context<char>;
+
+template <typename _Out, typename _CharT>
+class basic_format_context
+{
+public:
+  using iterator  = _Out;
+  using char_type = _CharT;
+  template <typename _Tp>
+  using formatter_type = formatter<_Tp, _CharT>;
+
+  // __ints holds the value of each integer argument
+  constexpr basic_format_context(_Out __out, const long long* __ints)
+  : _M_out(std::move(__out)), _M_ints(__ints)
+  { }
+
+  constexpr iterator out() { return std::move(_M_out); }
+  constexpr void advance_to(iterator __it) { _M_out = std::move(__it); }
+
+  constexpr long long _M_arg_int(std::size_t __id) const
+  { return _M_ints[__id]; }
+
+private:
+  _Out             _M_out;
+  const long long* _M_ints;
+};
+
+namespace impl {
+
+template <typename _Tp>
+concept __format_char = std::is_same_v<_Tp, char> ||
+                        std::is_same_v<_Tp, wchar_t> ||
+                        std::is_same_v<_Tp, char8_t> ||
+                        std::is_same_v<_Tp, char16_t> ||
+                        std::is_same_v<_Tp, char32_t>;
+
+template <typename _Tp>
+concept __format_integer = std::is_integral_v<_Tp> &&
+                           !std::is_same_v<_Tp, bool> && !__format_char<_Tp>;
+
+// An output iterator which appends to a string; a range at a time, by
+// __format_put and __format_fill
+template <typename _String>
+struct __append_iterator
+{
+  using iterator_category = std::output_iterator_tag;
+  using value_type        = void;
+  using difference_type   = std::ptrdiff_t;
+  using pointer           = void;
+  using reference         = void;
+  using _CharT            = typename _String::value_type;
+
+  _String* _M_s;
+
+  constexpr __append_iterator& operator=(_CharT __c)
+  { _M_s->push_back(__c); return *this; }
+  constexpr __append_iterator& operator*() { return *this; }
+  constexpr __append_iterator& operator++() { return *this; }
+  constexpr __append_iterator operator++(int) { return *this; }
+
+  constexpr void _M_put(const _CharT* __s, std::size_t __n)
+  { _M_s->append(__s, __n); }
+
+  constexpr void _M_fill(_CharT __c, std::size_t __n)
+  {
+    for (; __n; --__n)
+      _M_s->push_back(__c);
+  }
+};
+
+// An output iterator which counts what is written to it
+struct __counting_iterator
+{
+  using iterator_category = std::output_iterator_tag;
+  using value_type        = void;
+  using difference_type   = std::ptrdiff_t;
+  using pointer           = void;
+  using reference         = void;
+
+  std::size_t _M_n = 0;
+
+  template <typename _CharT>
+  constexpr __counting_iterator& operator=(_CharT) { ++_M_n; return *this; }
+  constexpr __counting_iterator& operator*() { return *this; }
+  constexpr __counting_iterator& operator++() { return *this; }
+  constexpr __counting_iterator operator++(int) { return *this; }
+
+  template <typename _CharT>
+  constexpr void _M_put(const _CharT*, std::size_t __n) { _M_n += __n; }
+  template <typename _CharT>
+  constexpr void _M_fill(_CharT, std::size_t __n) { _M_n += __n; }
+};
+
+template <typename _Out, typename _CharT>
+constexpr _Out
+__format_put(_Out __out, const _CharT* __s, std::size_t __n)
+{
+  if constexpr (requires { __out._M_put(__s, __n); })
+  {
+    __out._M_put(__s, __n);
+    return __out;
+  }
+  else
+    return std::copy_n(__s, __n, std::move(__out));
+}
+
+template <typename _Out, typename _CharT>
+constexpr _Out
+__format_fill(_Out __out, _CharT __c, std::size_t __n)
+{
+  if constexpr (requires { __out._M_fill(__c, __n); })
+  {
+    __out._M_fill(__c, __n);
+    return __out;
+  }
+  else
+    return std::fill_n(std::move(__out), __n, __c);
+}
+
+// A non-negative integer of no more than INT_MAX; an argument id, a width or
+// a precision. A leading zero is not part of one.
+template <typename _CharT>
+constexpr const _CharT*
+__format_parse_num(const _CharT* __p, const _CharT* __e, std::size_t& __n)
+{
+  __n = 0;
+  if (__p != __e && *__p == '0')
+    return __p + 1;
+  for (; __p != __e && *__p >= '0' && *__p <= '9'; ++__p)
+  {
+    __n = __n * 10 + (*__p - '0');
+    if (__n > INT_MAX)
+      throw format_error("format error: number is too large");
+  }
+  return __p;
+}
+
+// The standard format-spec:
+//   [[fill]align][sign][#][0][width][.precision][L][type]
+// A width or precision may be {} or {arg-id}; an integer argument.
+template <typename _CharT>
+struct __format_spec
+{
+  enum _Align : unsigned char { _S_none, _S_left, _S_right, _S_centre };
+
+  // The options which a formatter allows
+  enum : unsigned { _S_sign = 1, _S_alt = 2, _S_zero = 4, _S_prec = 8 };
+
+  _CharT      _M_fill = ' ';
+  _Align      _M_align = _S_none;
+  char        _M_sign = 0;       // '+' or ' '; 0 is '-', the default
+  bool        _M_alt = false;
+  bool        _M_zero = false;
+  bool        _M_width_arg = false;
+  bool        _M_prec_arg = false;
+  char        _M_type = 0;
+  std::size_t _M_width = 0;      // or, if _M_width_arg, an argument id
+  std::size_t _M_prec = 0;       // as _M_width
+  bool        _M_has_prec = false;
+
+  static constexpr _Align _S_align(_CharT __c)
+  {
+    return __c == '<' ? _S_left : __c == '>' ? _S_right
+         : __c == '^' ? _S_centre : _S_none;
+  }
+
+  static constexpr void _S_invalid(const char* __what)
+  { throw format_error(__what); }
+
+  constexpr const _CharT*
+  _M_parse_width(const _CharT* __p, const _CharT* __e,
+                 basic_format_parse_context<_CharT>& __pc,
+                 std::size_t& __n, bool& __arg)
+  {
+    if (__p == __e || *__p != '{')
+      return __format_parse_num(__p, __e, __n);
+    ++__p;
+    if (__p != __e && *__p >= '0' && *__p <= '9')
+    {
+      __p = __format_parse_num(__p, __e, __n);
+      __pc.check_arg_id(__n);
+    }
+    else
+      __n = __pc.next_arg_id();
+    if (__p == __e || *__p != '}')
+      _S_invalid("format error: invalid dynamic width or precision");
+    __pc._M_check_integral(__n);
+    __arg = true;
+    return __p + 1;
+  }
+
+  constexpr const _CharT*
+  _M_parse(basic_format_parse_context<_CharT>& __pc, unsigned __allow)
+  {
+    const _CharT* __p = __pc.begin();
+    const _CharT* const __e = __pc.end();
+    if (__p == __e || *__p == '}')
+      return __p;
+
+    if (__p + 1 != __e && _S_align(__p[1]) != _S_none && *__p != '{' &&
+        *__p != '}')
+    {
+      _M_fill = *__p;
+      _M_align = _S_align(__p[1]);
+      __p += 2;
+    }
+    else if (_S_align(*__p) != _S_none)
+      _M_align = _S_align(*__p++);
+
+    if (__p != __e && (*__p == '+' || *__p == '-' || *__p == ' '))
+    {
+      if (!(__allow & _S_sign))
+        _S_invalid("format error: format-spec contains an invalid sign");
+      _M_sign = *__p == '-' ? 0 : char(*__p);
+      ++__p;
+    }
+    if (__p != __e && *__p == '#')
+    {
+      if (!(__allow & _S_alt))
+        _S_invalid("format error: format-spec contains an invalid #");
+      _M_alt = true;
+      ++__p;
+    }
+    if (__p != __e && *__p == '0')
+    {
+      if (!(__allow & _S_zero))
+        _S_invalid("format error: format-spec contains an invalid 0");
+      _M_zero = true;
+      ++__p;
+    }
+    __p = _M_parse_width(__p, __e, __pc, _M_width, _M_width_arg);
+    if (__p != __e && *__p == '.')
+    {
+      if (!(__allow & _S_prec))
+        _S_invalid("format error: format-spec contains a precision");
+      ++__p;
+      if (__p == __e || !((*__p >= '0' && *__p <= '9') || *__p == '{'))
+        _S_invalid("format error: missing precision");
+      __p = _M_parse_width(__p, __e, __pc, _M_prec, _M_prec_arg);
+      _M_has_prec = true;
+    }
+    if (__p != __e && *__p == 'L')  // the "C" locale is the only one
+      ++__p;
+    if (__p != __e && *__p != '}')
+      _M_type = char(*__p++);
+    return __p;
+  }
+
+  // Checks that the type, if any, is one of __types
+  constexpr void _M_check_type(const char* __types) const
+  {
+    if (!_M_type)
+      return;
+    for (; *__types; ++__types)
+      if (*__types == _M_type)
+        return;
+    _S_invalid("format error: invalid presentation type in format-spec");
+  }
+
+  template <typename _Out>
+  constexpr std::size_t
+  _M_get_width(const basic_format_context<_Out, _CharT>& __fc) const
+  {
+    if (!_M_width_arg)
+      return _M_width;
+    const long long __w = __fc._M_arg_int(_M_width);
+    if (__w < 0)
+      _S_invalid("format error: negative width");
+    return static_cast<std::size_t>(__w);
+  }
+
+  // -1 if there is no precision
+  template <typename _Out>
+  constexpr int
+  _M_get_prec(const basic_format_context<_Out, _CharT>& __fc) const
+  {
+    if (!_M_has_prec)
+      return -1;
+    if (!_M_prec_arg)
+      return static_cast<int>(_M_prec);
+    const long long __p = __fc._M_arg_int(_M_prec);
+    if (__p < 0)
+      _S_invalid("format error: negative precision");
+    return __p > INT_MAX ? INT_MAX : static_cast<int>(__p);
+  }
+
+  // Writes [__s, __s + __n) padded to the width. With the 0 option, and no
+  // alignment, zeros are inserted after the first __z characters (a sign or
+  // a prefix); unless __z is npos.
+  static constexpr std::size_t _S_npos = std::size_t(-1);
+
+  template <typename _Out>
+  constexpr _Out
+  _M_write(basic_format_context<_Out, _CharT>& __fc, const _CharT* __s,
+           std::size_t __n, _Align __default,
+           std::size_t __z = _S_npos) const
+  {
+    const std::size_t __w = _M_get_width(__fc);
+    _Out __out = __fc.out();
+    if (__n >= __w)
+      return __format_put(std::move(__out), __s, __n);
+
+    const std::size_t __pad = __w - __n;
+    if (_M_zero && _M_align == _S_none && __z != _S_npos)
+    {
+      __out = __format_put(std::move(__out), __s, __z);
+      __out = __format_fill(std::move(__out), _CharT('0'), __pad);
+      return __format_put(std::move(__out), __s + __z, __n - __z);
+    }
+
+    const _Align __a = _M_align == _S_none ? __default : _M_align;
+    const std::size_t __before = __a == _S_left ? 0
+                               : __a == _S_right ? __pad : __pad / 2;
+    __out = __format_fill(std::move(__out), _M_fill, __before);
+    __out = __format_put(std::move(__out), __s, __n);
+    return __format_fill(std::move(__out), _M_fill, __pad - __before);
+  }
+
+  // As above; but the __n characters are those which __gen writes to the
+  // output iterator it is given. They pass through a buffer on the stack of
+  // 64 characters, however many there are.
+  template <typename _Out, typename _Gen>
+  constexpr _Out
+  _M_write_gen(basic_format_context<_Out, _CharT>& __fc, std::size_t __n,
+               const _Gen& __gen, _Align __default,
+               std::size_t __z = _S_npos) const
+  {
+    const std::size_t __w = _M_get_width(__fc);
+    const std::size_t __pad = __w > __n ? __w - __n : 0;
+    std::size_t __split = _S_npos;  // zeros follow this many characters
+    std::size_t __before = 0, __after = 0;
+    if (__pad && _M_zero && _M_align == _S_none && __z != _S_npos)
+      __split = __z;
+    else if (__pad)
+    {
+      const _Align __a = _M_align == _S_none ? __default : _M_align;
+      __before = __a == _S_left ? 0 : __a == _S_right ? __pad : __pad / 2;
+      __after = __pad - __before;
+    }
+
+    struct _Chunks
+    {
+      constexpr void _M_flush()
+      {
+        _M_out = __format_put(std::move(_M_out), _M_buf, _M_len);
+        _M_len = 0;
+      }
+      constexpr void _M_put(_CharT __c)
+      {
+        if (_M_pos++ == _M_split)
+        {
+          _M_flush();
+          _M_out = __format_fill(std::move(_M_out), _CharT('0'), _M_zeros);
+        }
+        if (_M_len == 64)
+          _M_flush();
+        _M_buf[_M_len++] = __c;
+      }
+
+      _Out _M_out;
+      std::size_t _M_split, _M_zeros;
+      std::size_t _M_pos = 0;
+      std::size_t _M_len = 0;
+      _CharT _M_buf[64]{};
+    } __chunks{__format_fill(__fc.out(), _M_fill, __before), __split, __pad};
+
+    __gen(__put_iterator<_Chunks, _CharT>{&__chunks});
+    __chunks._M_flush();
+    return __format_fill(std::move(__chunks._M_out), _M_fill, __after);
+  }
+};
+
+template <typename _CharT>
+struct __formatter_str
+{
+  using _Spec = __format_spec<_CharT>;
+
+  constexpr const _CharT* _M_parse(basic_format_parse_context<_CharT>& __pc)
+  {
+    const _CharT* __p = _M_spec._M_parse(__pc, _Spec::_S_prec);
+    _M_spec._M_check_type("s");
+    return __p;
+  }
+
+  template <typename _Out>
+  constexpr _Out
+  _M_format(std::basic_string_view<_CharT> __s,
+            basic_format_context<_Out, _CharT>& __fc) const
+  {
+    const int __prec = _M_spec._M_get_prec(__fc);
+    if (__prec >= 0 && std::size_t(__prec) < __s.size())
+      __s = __s.substr(0, __prec);
+    return _M_spec._M_write(__fc, __s.data(), __s.size(), _Spec::_S_left);
+  }
+
+  _Spec _M_spec;
+};
+
+// Integers; and a character or bool with an integer presentation type
+template <typename _CharT>
+struct __formatter_int
+{
+  using _Spec = __format_spec<_CharT>;
+
+  // __default is the presentation type if there is none: 'd', 'c' or 's'
+  constexpr const _CharT*
+  _M_parse(basic_format_parse_context<_CharT>& __pc, char __default)
+  {
+    const _CharT* __p = _M_spec._M_parse(__pc, _Spec::_S_sign | _Spec::_S_alt
+                                               | _Spec::_S_zero);
+    _M_spec._M_check_type(__default == 's' ? "bBdoxXs" : "bBcdoxX");
+    if (!_M_spec._M_type)
+      _M_spec._M_type = __default;
+    if ((_M_spec._M_type == 'c' || _M_spec._M_type == 's') &&
+        (_M_spec._M_sign || _M_spec._M_alt || _M_spec._M_zero))
+      _Spec::_S_invalid("format error: format-spec contains an option "
+                        "invalid for a character or string");
+    return __p;
+  }
+
+  // As text: a character; or a bool as true or false
+  constexpr bool _M_text() const
+  { return _M_spec._M_type == 'c' || _M_spec._M_type == 's'; }
+
+  template <typename _Tp, typename _Out>
+  constexpr _Out
+  _M_format(_Tp __v, basic_format_context<_Out, _CharT>& __fc,
+            typename _Spec::_Align __default = _Spec::_S_right) const
+  {
+    if (_M_spec._M_type == 'c')
+    {
+      using _Lim = std::numeric_limits<_CharT>;
+      if (std::cmp_less(__v, static_cast<long long>(_Lim::min())) ||
+          std::cmp_greater(__v, static_cast<unsigned long long>(_Lim::max())))
+        _Spec::_S_invalid("format error: integer not representable as a "
+                          "character");
+      const _CharT __c = static_cast<_CharT>(__v);
+      return _M_spec._M_write(__fc, &__c, 1, __default);
+    }
+
+    using _Up = std::make_unsigned_t<_Tp>;
+    _Up __u = static_cast<_Up>(__v);
+    bool __neg = false;
+    if constexpr (std::is_signed_v<_Tp>)
+      if (__v < 0)
+      {
+        __neg = true;
+        __u = _Up(0) - __u;
+      }
+
+    unsigned __base = 10;
+    const char __type = _M_spec._M_type;
+    if (__type == 'b' || __type == 'B')
+      __base = 2;
+    else if (__type == 'o')
+      __base = 8;
+    else if (__type == 'x' || __type == 'X')
+      __base = 16;
+
+    // Binary digits, a sign and a two character prefix
+    _CharT __buf[sizeof(_Tp) * 8 + 3];
+    _CharT* const __end = __buf + sizeof(_Tp) * 8 + 3;
+    _CharT* __p = __uint_to_chars(__end, __u, __base, __type == 'X');
+    if (_M_spec._M_alt && __base != 10 && (__base != 8 || __u != 0))
+    {
+      if (__base != 8)
+        *--__p = _CharT(__type);
+      *--__p = _CharT('0');
+    }
+    if (__neg)
+      *--__p = _CharT('-');
+    else if (_M_spec._M_sign)
+      *--__p = _CharT(_M_spec._M_sign);
+
+    const std::size_t __z = (__end - __p) - __uint_digits(__u, __base);
+    return _M_spec._M_write(__fc, __p, __end - __p, __default, __z);
+  }
+
+  template <typename _Up>
+  static constexpr std::size_t __uint_digits(_Up __u, unsigned __base)
+  {
+    std::size_t __n = 1;
+    for (; __u >= __base; __u /= __base)
+      ++__n;
+    return __n;
+  }
+
+  _Spec _M_spec;
+};
+
+template <typename _CharT>
+struct __formatter_fp
+{
+  using _Spec = __format_spec<_CharT>;
+
+  constexpr const _CharT*
+  _M_parse(basic_format_parse_context<_CharT>& __pc, unsigned __allow =
+           _Spec::_S_sign | _Spec::_S_alt | _Spec::_S_zero | _Spec::_S_prec)
+  {
+    const _CharT* __p = _M_spec._M_parse(__pc, __allow);
+    _M_spec._M_check_type("aAeEfFgG");
+    return __p;
+  }
+
+  // As std::to_chars: with no type, and no precision, the shortest
+  // representation; and the hexadecimal form has no 0x
+  template <typename _Out>
+  constexpr __fp_spec
+  _M_fp_spec(const basic_format_context<_Out, _CharT>& __fc) const
+  {
+    __fp_spec __fs;
+    int __prec = _M_spec._M_get_prec(__fc);
+    switch (_M_spec._M_type)
+    {
+      case 'a': case 'A':
+        __fs._M_style = __fp_style::hex;
+        break;
+      case 'e': case 'E':
+        __fs._M_style = __fp_style::scientific;
+        break;
+      case 'f': case 'F':
+        __fs._M_style = __fp_style::fixed;
+        break;
+      case 'g': case 'G':
+        __fs._M_style = __fp_style::general;
+        break;
+      default:
+        __fs._M_style = __fp_style::shortest;
+    }
+    if (__prec < 0 && _M_spec._M_type && __fs._M_style != __fp_style::hex)
+      __prec = 6;
+    __fs._M_precision = __prec;
+    __fs._M_upper = _M_spec._M_type >= 'A' && _M_spec._M_type <= 'Z';
+    __fs._M_alt = _M_spec._M_alt;
+    __fs._M_plus = _M_spec._M_sign;
+    __fs._M_prefix = false;
+    return __fs;
+  }
+
+  template <typename _Tp, typename _Out>
+  constexpr _Out
+  _M_format(_Tp __v, basic_format_context<_Out, _CharT>& __fc) const
+  {
+    using _Fp = std::conditional_t<std::is_same_v<_Tp, float>, float, double>;
+    const __fp_formatter __fmt(static_cast<_Fp>(__v), _M_fp_spec(__fc));
+    // Zeros follow the sign; an infinity or NaN is padded with the fill
+    return _M_spec._M_write_gen(__fc, __fmt.size(),
+                                [&](auto __out) { __fmt.write(__out); },
+                                _Spec::_S_right,
+                                __fmt.finite() ? __fmt.prefix_size()
+                                               : _Spec::_S_npos);
+  }
+
+  _Spec _M_spec;
+};
+
+template <typename _Tp>
+constexpr long long __format_int_arg(const _Tp& __x)
+{
+  if constexpr (__format_integer<_Tp>)
+  {
+    if (std::cmp_greater(__x, LLONG_MAX))
+      return LLONG_MAX;
+    return static_cast<long long>(__x);
+  }
+  else
+    return -1;
+}
+
+// Calls the parse member of the formatter of argument __id
+template <typename _CharT, typename... _Args>
+constexpr const _CharT*
+__format_parse_arg(std::size_t __id, basic_format_parse_context<_CharT>& __pc)
+{
+  const _CharT* __r = nullptr;
+  std::size_t __i = 0;
+  ((__i++ == __id ? (__r = formatter<_Args, _CharT>().parse(__pc), true)
+                  : false) || ...);
+  return __r;
+}
+
+template <typename _CharT, typename _Out, typename _Tp>
+constexpr const _CharT*
+__format_one(basic_format_parse_context<_CharT>& __pc,
+             basic_format_context<_Out, _CharT>& __fc, const _Tp& __x)
+{
+  formatter<std::remove_cvref_t<_Tp>, _CharT> __f;
+  const _CharT* __r = __f.parse(__pc);
+  __fc.advance_to(__f.format(__x, __fc));
+  return __r;
+}
+
+template <typename _CharT, typename _Out, typename... _Args>
+constexpr const _CharT*
+__format_arg(std::size_t __id, basic_format_parse_context<_CharT>& __pc,
+             basic_format_context<_Out, _CharT>& __fc, const _Args&... __args)
+{
+  const _CharT* __r = nullptr;
+  std::size_t __i = 0;
+  ((__i++ == __id ? (__r = __format_one(__pc, __fc, __args), true)
+                  : false) || ...);
+  return __r;
+}
+
+// Calls __text with each run of literal text, and __field with the id of
+// each replacement field; which returns the end of its format-spec
+template <typename _CharT, typename _Text, typename _Field>
+constexpr void
+__format_parse(basic_format_parse_context<_CharT>& __pc, _Text __text,
+               _Field __field)
+{
+  const _CharT* __p = __pc.begin();
+  const _CharT* const __e = __pc.end();
+  while (__p != __e)
+  {
+    const _CharT* __q = __p;
+    while (__q != __e && *__q != '{' && *__q != '}')
+      ++__q;
+    if (__q != __p)
+      __text(__p, __q);
+    if (__q == __e)
+      break;
+    if (__q + 1 != __e && __q[1] == *__q)  // {{ or }}
+    {
+      __text(__q, __q + 1);
+      __p = __q + 2;
+      continue;
+    }
+    if (*__q == '}')
+      throw format_error("format error: unmatched '}' in format string");
+
+    __p = __q + 1;
+    std::size_t __id;
+    if (__p != __e && *__p >= '0' && *__p <= '9')
+    {
+      __p = __format_parse_num(__p, __e, __id);
+      __pc.check_arg_id(__id);
+    }
+    else
+      __id = __pc.next_arg_id();
+    if (__p != __e && *__p == ':')
+      ++__p;
+    else if (__p == __e || *__p != '}')
+      throw format_error("format error: invalid replacement field");
+
+    __pc.advance_to(__p);
+    __p = __field(__id);
+    if (__p == __e || *__p != '}')
+      throw format_error("format error: missing '}' in format string");
+    ++__p;
+  }
+}
+
+template <typename _CharT, typename... _Args>
+constexpr void
+__check_format(std::basic_string_view<_CharT> __fmt)
+{
+  static_assert((std::is_default_constructible_v<formatter<_Args, _CharT>>
+                 && ...), "cest::format: an argument is not formattable");
+  constexpr bool __ints[] = { __format_integer<_Args>..., false };
+  basic_format_parse_context<_CharT> __pc(__fmt, sizeof...(_Args));
+  __pc._M_integral = __ints;
+  __format_parse(__pc, [](const _CharT*, const _CharT*) { },
+                 [&](std::size_t __id)
+                 { return __format_parse_arg<_CharT, _Args...>(__id, __pc); });
+}
+
+template <typename _CharT, typename _Out, typename... _Args>
+constexpr _Out
+__vformat_to(_Out __out, std::basic_string_view<_CharT> __fmt,
+             const _Args&... __args)
+{
+  const long long __ints[] = { __format_int_arg(__args)..., 0 };
+  basic_format_parse_context<_CharT> __pc(__fmt, sizeof...(_Args));
+  basic_format_context<_Out, _CharT> __fc(std::move(__out), __ints);
+  __format_parse(__pc,
+                 [&](const _CharT* __b, const _CharT* __e)
+                 { __fc.advance_to(__format_put(__fc.out(), __b, __e - __b)); },
+                 [&](std::size_t __id)
+                 { return __format_arg(__id, __pc, __fc, __args...); });
+  return __fc.out();
+}
+
+} // namespace impl
+
+// A format string; checked against the argument types by the consteval
+// constructor
+template <typename _CharT, typename... _Args>
+class basic_format_string
+{
+public:
+  template <typename _Tp>
+    requires std::convertible_to<const _Tp&, std::basic_string_view<_CharT>>
+  consteval basic_format_string(const _Tp& __s)
+  : _M_str(__s)
+  { impl::__check_format<_CharT, std::remove_cvref_t<_Args>...>(_M_str); }
+
+  constexpr std::basic_string_view<_CharT> get() const noexcept
+  { return _M_str; }
+
+private:
+  std::basic_string_view<_CharT> _M_str;
+};
+
+template <typename... _Args>
+using format_string = basic_format_string<char, std::type_identity_t<_Args>...>;
+
+template <typename... _Args>
+constexpr string
+format(format_string<_Args...> __fmt, _Args&&... __args)
+{
+  string __s;
+  impl::__vformat_to(impl::__append_iterator<string>{&__s}, __fmt.get(),
+                     __args...);
+  return __s;
+}
+
+template <typename _Out, typename... _Args>
+constexpr _Out
+format_to(_Out __out, format_string<_Args...> __fmt, _Args&&... __args)
+{ return impl::__vformat_to(std::move(__out), __fmt.get(), __args...); }
+
+template <typename... _Args>
+constexpr std::size_t
+formatted_size(format_string<_Args...> __fmt, _Args&&... __args)
+{
+  return impl::__vformat_to(impl::__counting_iterator{}, __fmt.get(),
+                            __args...)._M_n;
+}
+
+// Formatters
+
+template <impl::__format_integer _Tp, typename _CharT>
+struct formatter<_Tp, _CharT>
+{
+  constexpr const _CharT* parse(basic_format_parse_context<_CharT>& __pc)
+  { return _M_f._M_parse(__pc, 'd'); }
+
+  template <typename _Out>
+  constexpr _Out format(_Tp __v, basic_format_context<_Out, _CharT>& __fc) const
+  { return _M_f._M_format(__v, __fc); }
+
+  impl::__formatter_int<_CharT> _M_f;
+};
+
+// As a character; or, with an integer presentation type, as the unsigned
+// value of its code unit
+template <>
+struct formatter<char, char>
+{
+  constexpr const char* parse(basic_format_parse_context<char>& __pc)
+  { return _M_f._M_parse(__pc, 'c'); }
+
+  template <typename _Out>
+  constexpr _Out format(char __c, basic_format_context<_Out, char>& __fc) const
+  {
+    using _Spec = impl::__format_spec<char>;
+    if (_M_f._M_text())
+      return _M_f._M_spec._M_write(__fc, &__c, 1, _Spec::_S_left);
+    return _M_f._M_format(static_cast<unsigned char>(__c), __fc);
+  }
+
+  impl::__formatter_int<char> _M_f;
+};
+
+template <typename _CharT>
+struct formatter<bool, _CharT>
+{
+  constexpr const _CharT* parse(basic_format_parse_context<_CharT>& __pc)
+  { return _M_f._M_parse(__pc, 's'); }
+
+  template <typename _Out>
+  constexpr _Out format(bool __b, basic_format_context<_Out, _CharT>& __fc) const
+  {
+    using _Spec = impl::__format_spec<_CharT>;
+    if (!_M_f._M_text())
+      return _M_f._M_format(static_cast<unsigned char>(__b), __fc);
+    const _CharT __t[] = { 't', 'r', 'u', 'e' };
+    const _CharT __f[] = { 'f', 'a', 'l', 's', 'e' };
+    return __b ? _M_f._M_spec._M_write(__fc, __t, 4, _Spec::_S_left)
+               : _M_f._M_spec._M_write(__fc, __f, 5, _Spec::_S_left);
+  }
+
+  impl::__formatter_int<_CharT> _M_f;
+};
+
+template <std::floating_point _Tp, typename _CharT>
+struct formatter<_Tp, _CharT>
+{
+  constexpr const _CharT* parse(basic_format_parse_context<_CharT>& __pc)
+  { return _M_f._M_parse(__pc); }
+
+  template <typename _Out>
+  constexpr _Out format(_Tp __v, basic_format_context<_Out, _CharT>& __fc) const
+  { return _M_f._M_format(__v, __fc); }
+
+  impl::__formatter_fp<_CharT> _M_f;
+};
+
+template <typename _CharT, typename _Traits>
+struct formatter<std::basic_string_view<_CharT, _Traits>, _CharT>
+{
+  constexpr const _CharT* parse(basic_format_parse_context<_CharT>& __pc)
+  { return _M_f._M_parse(__pc); }
+
+  template <typename _Out>
+  constexpr _Out format(std::basic_string_view<_CharT, _Traits> __s,
+                        basic_format_context<_Out, _CharT>& __fc) const
+  { return _M_f._M_format({__s.data(), __s.size()}, __fc); }
+
+  impl::__formatter_str<_CharT> _M_f;
+};
+
+template <typename _CharT>
+struct formatter<const _CharT*, _CharT>
+  : formatter<std::basic_string_view<_CharT>, _CharT>
+{ };
+
+template <typename _CharT>
+struct formatter<_CharT*, _CharT>
+  : formatter<std::basic_string_view<_CharT>, _CharT>
+{ };
+
+template <typename _CharT, std::size_t _Nm>
+struct formatter<_CharT[_Nm], _CharT>
+  : formatter<std::basic_string_view<_CharT>, _CharT>
+{ };
+
+template <typename _CharT, typename _Traits, typename _Alloc>
+struct formatter<basic_string<_CharT, _Traits, _Alloc>, _CharT>
+  : formatter<std::basic_string_view<_CharT>, _CharT>
+{
+  template <typename _Out>
+  constexpr _Out format(const basic_string<_CharT, _Traits, _Alloc>& __s,
+                        basic_format_context<_Out, _CharT>& __fc) const
+  { return this->_M_f._M_format({__s.data(), __s.size()}, __fc); }
+};
+
+template <typename _CharT, typename _Traits, typename _Alloc>
+struct formatter<std::basic_string<_CharT, _Traits, _Alloc>, _CharT>
+  : formatter<std::basic_string_view<_CharT>, _CharT>
+{ };
+
+// As 0x followed by the address in hexadecimal. Within a constant expression,
+// only a null pointer has an address.
+template <typename _CharT>
+struct formatter<const void*, _CharT>
+{
+  constexpr const _CharT* parse(basic_format_parse_context<_CharT>& __pc)
+  {
+    const _CharT* __p = _M_f._M_spec._M_parse(__pc, 0);
+    _M_f._M_spec._M_check_type("p");
+    _M_f._M_spec._M_type = 'x';
+    _M_f._M_spec._M_alt = true;
+    return __p;
+  }
+
+  template <typename _Out>
+  constexpr _Out format(const void* __p,
+                        basic_format_context<_Out, _CharT>& __fc) const
+  {
+    std::uintptr_t __u = 0;
+    if (__p)
+      __u = reinterpret_cast<std::uintptr_t>(__p);
+    return _M_f._M_format(__u, __fc);
+  }
+
+  impl::__formatter_int<_CharT> _M_f;
+};
+
+template <typename _CharT>
+struct formatter<void*, _CharT> : formatter<const void*, _CharT>
+{ };
+
+template <typename _CharT>
+struct formatter<std::nullptr_t, _CharT> : formatter<const void*, _CharT>
+{ };
+
+// As operator<<, (re,im); the format-spec is that of a floating-point type,
+// and all but its fill, alignment and width apply to each part
+template <typename _Tp, typename _CharT>
+struct formatter<complex<_Tp>, _CharT>
+{
+  using _Spec = impl::__format_spec<_CharT>;
+
+  constexpr const _CharT* parse(basic_format_parse_context<_CharT>& __pc)
+  { return _M_f._M_parse(__pc, _Spec::_S_sign | _Spec::_S_alt | _Spec::_S_prec); }
+
+  template <typename _Out>
+  constexpr _Out format(const complex<_Tp>& __z,
+                        basic_format_context<_Out, _CharT>& __fc) const
+  {
+    using _Fp = std::conditional_t<std::is_same_v<_Tp, float>, float, double>;
+    const impl::__fp_spec __fs = _M_f._M_fp_spec(__fc);
+    const impl::__fp_formatter __re(static_cast<_Fp>(__z.real()), __fs);
+    const impl::__fp_formatter __im(static_cast<_Fp>(__z.imag()), __fs);
+    auto __gen = [&](auto __out) {
+      *__out++ = _CharT('(');
+      __out = __re.write(__out);
+      *__out++ = _CharT(',');
+      __out = __im.write(__out);
+      *__out++ = _CharT(')');
+    };
+    return _M_f._M_spec._M_write_gen(__fc, __re.size() + __im.size() + 3,
+                                     __gen, _Spec::_S_right);
+  }
+
+  impl::__formatter_fp<_CharT> _M_f;
+};
+
+} // namespace cest
+
+#endif // _CEST_FORMAT_HPP_
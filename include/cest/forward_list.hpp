@@ -97,7 +97,11 @@ struct forward_list {
   };
 
   constexpr forward_list() = default;
+  explicit constexpr forward_list(const Allocator& alloc)
+    : m_node_alloc(alloc) {}
   constexpr forward_list(const forward_list& x)
+    : forward_list(std::allocator_traits<Allocator>::
+                     select_on_container_copy_construction(x.get_allocator()))
   {
     const node_base* from = &x.m_front;
           node_base*   to = &this->m_front;
@@ -120,6 +124,7 @@ struct forward_list {
 
   constexpr void swap(forward_list& x) {
     std::swap(this->m_front.next, x.m_front.next);
+    std::swap(this->m_node_alloc, x.m_node_alloc);
   }
 
   constexpr allocator_type get_allocator() const noexcept {
@@ -205,6 +210,12 @@ struct forward_list {
   typename std::allocator_traits<allocator_type>::template rebind_alloc<node> m_node_alloc;
 };
 
+namespace pmr {
+template <typename T> class polymorphic_allocator; // cest/memory_resource.hpp
+template <class T>
+using forward_list = cest::forward_list<T, polymorphic_allocator<T>>;
+} // namespace pmr
+
 } // namespace cest
 
 #endif // _CEST_FORWARD_LIST_HPP_
@@ -1,11 +1,154 @@
 #ifndef _CEST_FSTREAM_HPP_
 #define _CEST_FSTREAM_HPP_
 
-#include <fstream>
+// An input-only <fstream>. Within a constant expression a file is read from
+// the embedded_files registry, as no file can be opened; at runtime the named
+// file is memory-mapped, by basic_mmapbuf. Either way the contents are the get
+// area of the streambuf, and are not copied.
+
+#include "istream.hpp"
+#include "mmapbuf.hpp"  // cest::basic_mmapbuf
+#include <span>
+#include <string>       // std::string
+#include <string_view>
 
 namespace cest {
 
-  using std::ifstream;
+// The contents of a file, named as it would be passed to open
+template <typename _CharT>
+struct basic_embedded_file
+{
+  std::string_view        name;
+  std::span<const _CharT> data;
+};
+
+using embedded_file = basic_embedded_file<char>;
+
+// The files available to a basic_ifstream<_CharT> in a constant expression.
+// A program lists its own by specialising this before any use of a
+// basic_ifstream<_CharT>; e.g. in a header generated by the build system, or
+// with C23's #embed:
+//
+//   constexpr char db[] = {
+//   #embed "db.txt"
+//   };
+//   constexpr cest::embedded_file files[] = { {"db.txt", db} };
+//   template <>
+//   inline constexpr std::span<const cest::embedded_file>
+//     cest::embedded_files<char>{files};
+template <typename _CharT>
+inline constexpr std::span<const basic_embedded_file<_CharT>> embedded_files{};
+
+template<
+  class _CharT,
+  class _Traits = std::char_traits<_CharT>
+> class basic_filebuf : public basic_mmapbuf<_CharT, _Traits>
+{
+public:
+
+  typedef _CharT  char_type;
+  typedef _Traits traits_type;
+
+  typedef typename traits_type::int_type    int_type;
+  typedef typename traits_type::pos_type    pos_type;
+  typedef typename traits_type::off_type    off_type;
+
+  typedef basic_mmapbuf<char_type, traits_type>     __mmapbuf_type;
+  typedef basic_filebuf<char_type, traits_type>     __filebuf_type;
+
+  constexpr basic_filebuf() : __mmapbuf_type() { }
+
+  // Only reading is supported; the get area is the whole file
+  constexpr __filebuf_type* open(const char* __s, ios_base::openmode __mode)
+  {
+    if (this->_M_open || !(__mode & ios_base::in) || (__mode & ios_base::out))
+      return 0;
+
+    if (!std::is_constant_evaluated())
+      return __mmapbuf_type::open(__s) ? this : 0;
+
+    for (const auto& __f : embedded_files<char_type>)
+      if (__f.name == __s)
+      {
+        // As the mapped file; the get area is never written to
+        char_type* __p = const_cast<char_type*>(__f.data.data());
+        this->setg(__p, __p, __p + __f.data.size());
+        this->_M_open = true;
+        return this;
+      }
+    return 0;
+  }
+
+  constexpr __filebuf_type* close()
+  { return __mmapbuf_type::close() ? this : 0; }
+};
+
+using filebuf = basic_filebuf<char>;
+using wfilebuf = basic_filebuf<wchar_t>;
+
+template <
+  class _CharT,
+  class _Traits = std::char_traits<_CharT>
+> class basic_ifstream : public basic_istream<_CharT, _Traits>
+{
+public:
+  using char_type   = _CharT;
+  using traits_type = _Traits;
+  using int_type    = typename traits_type::int_type;
+  using pos_type    = typename traits_type::pos_type;
+  using off_type    = typename traits_type::off_type;
+
+  typedef basic_filebuf<_CharT, _Traits>  __filebuf_type;
+  typedef basic_istream<char_type, traits_type> __istream_type;
+
+  constexpr basic_ifstream()
+  : __istream_type(), _M_filebuf()
+  { this->init(&_M_filebuf); }
+
+  constexpr explicit
+  basic_ifstream(const char* __s, ios_base::openmode __mode = ios_base::in)
+  : __istream_type(), _M_filebuf()
+  {
+    this->init(&_M_filebuf);
+    this->open(__s, __mode);
+  }
+
+  constexpr explicit
+  basic_ifstream(const std::string& __s,
+                 ios_base::openmode __mode = ios_base::in)
+  : basic_ifstream(__s.c_str(), __mode)
+  { }
+
+  constexpr __filebuf_type*
+  rdbuf() const
+  { return const_cast<__filebuf_type*>(&_M_filebuf); }
+
+  constexpr bool is_open() const { return _M_filebuf.is_open(); }
+
+  // from fstream
+  constexpr void open(const char* __s, ios_base::openmode __mode = ios_base::in)
+  {
+    if (!_M_filebuf.open(__s, __mode | ios_base::in))
+      this->setstate(ios_base::failbit);
+    else
+      // _GLIBCXX_RESOLVE_LIB_DEFECTS
+      // 409. Closing an fstream should clear error state
+      this->clear();
+  }
+
+  constexpr void close()
+  {
+    if (!_M_filebuf.close())
+      this->setstate(ios_base::failbit);
+  }
+
+  constexpr ~basic_ifstream() {}
+
+  __filebuf_type  _M_filebuf;
+};
+
+using ifstream = basic_ifstream<char>;
+using wifstream = basic_ifstream<wchar_t>;
 
 } // namespace cest
 
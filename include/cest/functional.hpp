@@ -4,85 +4,409 @@
 #include "memory.hpp"
 
 #include <type_traits>
+#include <functional> // std::bad_function_call, std::reference_wrapper
+#include <cstddef>    // std::size_t
+#include <new>        // placement new
+
+// At runtime, a cest::function stores a callable within the function object
+// itself, rather than on the heap, if it fits within this many bytes.
+#ifndef CEST_FUNCTION_BUFFER_SIZE
+#define CEST_FUNCTION_BUFFER_SIZE (4 * sizeof(void*))
+#endif
 
 namespace cest
 {
 // Based on the 2nd answer:
 // https://stackoverflow.com/questions/53977787/constexpr-version-of-stdfunction
 // very useful, thank you!
+// As with shared_ptr's control block, destroy() deletes the final type; so the
+// destructor need not be virtual. The placement new of clone_into & move_into
+// is not allowed in a constant expression; they are only called at runtime.
 template <typename R, typename... Args>
 class virt_impl_f
 {
 public:
   constexpr virtual R operator()(Args... args) = 0;
-  constexpr virtual ~virt_impl_f() = default;
+  constexpr virtual virt_impl_f* clone() const = 0;
+  virtual virt_impl_f* clone_into(void* buf) const = 0;
+  virtual virt_impl_f* move_into(void* buf) noexcept = 0;
+  constexpr virtual void destroy(bool inplace) noexcept = 0;
+
+protected:
+  constexpr ~virt_impl_f() = default;
 };
 
 template <typename F, typename R, typename... Args>
-class impl_f : public virt_impl_f<R , Args...>
+class impl_f final : public virt_impl_f<R , Args...>
 {
+  using base_t = virt_impl_f<R, Args...>;
+
 public:
-  constexpr impl_f(F&& f) : f_(f) {}
+  template <typename G>
+  constexpr impl_f(G&& g) : f_(std::forward<G>(g)) {}
+  constexpr impl_f(const impl_f&) = default;
+  constexpr impl_f(impl_f&&) = default;
 
   constexpr virtual R operator()(Args... args) override {
-    return f_(std::forward<Args>(args)...);
+    if constexpr (std::is_void_v<R>)
+      f_(std::forward<Args>(args)...);
+    else
+      return f_(std::forward<Args>(args)...);
+  }
+
+  // Never called for the move-only callables of a move_only_function
+  constexpr virtual base_t* clone() const override {
+    if constexpr (std::is_copy_constructible_v<F>)
+      return new impl_f(*this);
+    else
+      return nullptr;
+  }
+
+  virtual base_t* clone_into(void* buf) const override {
+    if constexpr (std::is_copy_constructible_v<F>)
+      return ::new (buf) impl_f(*this);
+    else
+      return nullptr;
+  }
+
+  virtual base_t* move_into(void* buf) noexcept override {
+    return ::new (buf) impl_f(std::move(*this));
+  }
+
+  constexpr virtual void destroy(bool inplace) noexcept override {
+    if (inplace)
+      std::destroy_at(this);
+    else
+      delete this;
   }
 
   F f_;
 };
 
-template <typename F, typename... Args>
-class impl_f<F, void, Args...> : public virt_impl_f<void, Args...>
+namespace impl {
+
+// The storage shared by function and move_only_function. The small buffer is
+// used only at runtime; and only for callables which can be moved without
+// throwing, so the move operations of both classes are noexcept.
+template <typename R, typename... Args>
+class function_base
 {
-public:
-  constexpr impl_f(F&& f) : f_(f) {}
+protected:
+  using impl_t = virt_impl_f<R, Args...>;
+
+  template <typename F>
+  using impl_for = impl_f<std::decay_t<F>, R, Args...>;
 
-  constexpr virtual void operator()(Args... args) override {
-    f_(std::forward<Args>(args)...);
+  template <typename F>
+  static constexpr bool fits_inline =
+    sizeof(impl_for<F>) <= CEST_FUNCTION_BUFFER_SIZE &&
+    alignof(impl_for<F>) <= alignof(void*) &&
+    std::is_nothrow_move_constructible_v<std::decay_t<F>>;
+
+  constexpr function_base() noexcept {}
+  constexpr ~function_base() { reset(); }
+
+  // The callable is forwarded; so moved from only if it's an rvalue
+  template <typename F>
+  constexpr void construct(F&& f)
+  {
+    if constexpr (fits_inline<F>)
+      if (!std::is_constant_evaluated()) {
+        f_ = ::new (static_cast<void*>(buf_)) impl_for<F>(std::forward<F>(f));
+        inplace_ = true;
+        return;
+      }
+    f_ = new impl_for<F>(std::forward<F>(f));
   }
 
-  F f_;
+  constexpr void copy(const function_base& other)
+  {
+    if (!other.f_)
+      return;
+    if (other.inplace_) {
+      f_ = other.f_->clone_into(buf_);
+      inplace_ = true;
+    } else {
+      f_ = other.f_->clone();
+    }
+  }
+
+  constexpr void reset() noexcept
+  {
+    if (f_)
+      f_->destroy(inplace_);
+    f_ = nullptr;
+    inplace_ = false;
+  }
+
+  // leaves other empty; *this must be empty
+  constexpr void take(function_base& other) noexcept
+  {
+    if (other.inplace_) {
+      f_ = other.f_->move_into(buf_);
+      inplace_ = true;
+      other.reset();
+    } else {
+      f_ = other.f_;
+      other.f_ = nullptr;
+    }
+  }
+
+  constexpr R call(Args&&... args) const {
+    if (!f_)
+      throw std::bad_function_call();
+    return f_->operator()(std::forward<Args>(args)...);
+  }
+
+  alignas(void*) unsigned char buf_[CEST_FUNCTION_BUFFER_SIZE];
+  impl_t* f_ = nullptr;
+  bool inplace_ = false;
 };
 
+} // namespace impl
+
 template <typename>
 class function;
 
 template <typename R, typename... Args>
-class function<R (Args...)>
+class function<R (Args...)> : private impl::function_base<R, Args...>
 {
-  cest::unique_ptr<virt_impl_f<R, Args...>> f_;
+  using base_t = impl::function_base<R, Args...>;
+
+  template <typename F>
+  using callable_t = std::enable_if_t<
+    !std::is_same_v<std::decay_t<F>, function> &&
+    std::is_copy_constructible_v<std::decay_t<F>> &&
+    std::is_invocable_r_v<R, std::decay_t<F>&, Args...>>;
 
 public:
-  constexpr R operator()(Args... args) {
-    return f_->operator()(std::forward<Args>(args)...);
+  using result_type = R;
+
+  constexpr function() noexcept {}
+  constexpr function(std::nullptr_t) noexcept {}
+
+  template <typename F, typename = callable_t<F>>
+  constexpr function(F&& f) { this->construct(std::forward<F>(f)); }
+
+  constexpr function(const function& other) { this->copy(other); }
+  constexpr function(function&& other) noexcept { this->take(other); }
+
+  constexpr function& operator=(const function& other)
+  {
+    function(other).swap(*this);
+    return *this;
   }
 
-  template<typename F>
-  constexpr function(F&& f) :
-    f_(cest::make_unique<impl_f<std::decay_t<F>,
-                         R, Args...>>(std::move(f))){}
+  constexpr function& operator=(function&& other) noexcept
+  {
+    if (this != &other) {
+      this->reset();
+      this->take(other);
+    }
+    return *this;
+  }
+
+  constexpr function& operator=(std::nullptr_t) noexcept
+  {
+    this->reset();
+    return *this;
+  }
+
+  template <typename F, typename = callable_t<F>>
+  constexpr function& operator=(F&& f)
+  {
+    function(std::forward<F>(f)).swap(*this);
+    return *this;
+  }
+
+  constexpr void swap(function& other) noexcept
+  {
+    function tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+
+  constexpr explicit operator bool() const noexcept { return this->f_; }
+
+  constexpr R operator()(Args... args) const {
+    return this->call(std::forward<Args>(args)...);
+  }
 };
 
-template <typename... Args>
-class function<void (Args...)>
+// As function, but the callable need only be move constructible; so it can
+// own e.g. a unique_ptr. A move_only_function can't be copied.
+template <typename>
+class move_only_function;
+
+template <typename R, typename... Args>
+class move_only_function<R (Args...)> : private impl::function_base<R, Args...>
 {
-  cest::unique_ptr<virt_impl_f<void, Args...>> f_;
+  template <typename F>
+  using callable_t = std::enable_if_t<
+    !std::is_same_v<std::decay_t<F>, move_only_function> &&
+    std::is_invocable_r_v<R, std::decay_t<F>&, Args...>>;
 
 public:
-  constexpr void operator()(Args... args) {
-    return f_->operator()(std::forward<Args>(args)...);
+  using result_type = R;
+
+  constexpr move_only_function() noexcept {}
+  constexpr move_only_function(std::nullptr_t) noexcept {}
+
+  template <typename F, typename = callable_t<F>>
+  constexpr move_only_function(F&& f) { this->construct(std::forward<F>(f)); }
+
+  move_only_function(const move_only_function&) = delete;
+  constexpr move_only_function(move_only_function&& other) noexcept {
+    this->take(other);
+  }
+
+  move_only_function& operator=(const move_only_function&) = delete;
+
+  constexpr move_only_function& operator=(move_only_function&& other) noexcept
+  {
+    if (this != &other) {
+      this->reset();
+      this->take(other);
+    }
+    return *this;
+  }
+
+  constexpr move_only_function& operator=(std::nullptr_t) noexcept
+  {
+    this->reset();
+    return *this;
+  }
+
+  template <typename F, typename = callable_t<F>>
+  constexpr move_only_function& operator=(F&& f)
+  {
+    move_only_function(std::forward<F>(f)).swap(*this);
+    return *this;
   }
 
-  template<typename F>
-  constexpr function(F&& f) :
-    f_(cest::make_unique<impl_f<std::decay_t<F>,
-                         void, Args...>>(std::move(f))){}
+  constexpr void swap(move_only_function& other) noexcept
+  {
+    move_only_function tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+
+  constexpr explicit operator bool() const noexcept { return this->f_; }
+
+  constexpr R operator()(Args... args) {
+    return this->call(std::forward<Args>(args)...);
+  }
 };
 
+template <typename R, typename... Args>
+constexpr void swap(move_only_function<R(Args...)>& a,
+                    move_only_function<R(Args...)>& b) noexcept
+{
+  a.swap(b);
+}
+
+template <typename R, typename... Args>
+constexpr void swap(function<R(Args...)>& a, function<R(Args...)>& b) noexcept
+{
+  a.swap(b);
+}
+
+template <typename R, typename... Args>
+constexpr bool operator==(const function<R(Args...)>& f, std::nullptr_t)
+noexcept
+{
+  return !f;
+}
+
 // Deduction guide borrowed from libcxx
 template<class R, class ...Args>
 function(R(*)(Args...)) -> function<R(Args...)>; // since C++17
 
+template <typename>
+class function_ref;
+
+// A non-owning reference to a callable; which must outlive the function_ref.
+// At runtime this is a pointer to the callable, and a pointer to a function
+// which casts it back and invokes it. A constant expression can't cast from
+// void*, so there the callable's address is instead held by a heap allocated
+// impl_f (of a std::reference_wrapper).
+template <typename R, typename... Args>
+class function_ref<R (Args...)>
+{
+  using impl_t = virt_impl_f<R, Args...>;
+
+  template <typename F>
+  using callable_t = std::enable_if_t<
+    !std::is_same_v<std::remove_cvref_t<F>, function_ref> &&
+    std::is_invocable_r_v<R, F&, Args...>>;
+
+  template <typename F>
+  static R invoke(void* obj, Args... args)
+  {
+    F& f = *static_cast<F*>(obj);
+    if constexpr (std::is_void_v<R>)
+      f(std::forward<Args>(args)...);
+    else
+      return f(std::forward<Args>(args)...);
+  }
+
+  template <typename F>
+  static R invoke_fn(void* obj, Args... args)
+  {
+    auto f = reinterpret_cast<F*>(obj);
+    if constexpr (std::is_void_v<R>)
+      f(std::forward<Args>(args)...);
+    else
+      return f(std::forward<Args>(args)...);
+  }
+
+public:
+  template <typename F, typename = callable_t<F>>
+  constexpr function_ref(F&& f) noexcept
+  {
+    using fn_t = std::remove_reference_t<F>;
+    if (std::is_constant_evaluated()) {
+      using ref_t = std::reference_wrapper<fn_t>;
+      f_ = new impl_f<ref_t, R, Args...>(ref_t(f));
+    } else if constexpr (std::is_function_v<fn_t>) {
+      obj_ = reinterpret_cast<void*>(&f);
+      call_ = &invoke_fn<fn_t>;
+    } else {
+      obj_ = const_cast<void*>(static_cast<const volatile void*>(&f));
+      call_ = &invoke<fn_t>;
+    }
+  }
+
+  constexpr function_ref(const function_ref& other) noexcept
+    : obj_(other.obj_), call_(other.call_),
+      f_(other.f_ ? other.f_->clone() : nullptr) {}
+
+  constexpr function_ref& operator=(const function_ref& other) noexcept
+  {
+    if (this != &other) {
+      if (f_)
+        f_->destroy(false);
+      obj_  = other.obj_;
+      call_ = other.call_;
+      f_    = other.f_ ? other.f_->clone() : nullptr;
+    }
+    return *this;
+  }
+
+  constexpr ~function_ref() { if (f_) f_->destroy(false); }
+
+  constexpr R operator()(Args... args) const {
+    if (std::is_constant_evaluated())
+      return f_->operator()(std::forward<Args>(args)...);
+    return call_(obj_, std::forward<Args>(args)...);
+  }
+
+private:
+  void* obj_ = nullptr;
+  R (*call_)(void*, Args...) = nullptr;
+  impl_t* f_ = nullptr;
+};
+
 } // namespace cest
 
 #endif // _CEST_FUNCTIONAL_HPP_
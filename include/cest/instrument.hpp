@@ -0,0 +1,127 @@
+#ifndef _CEST_INSTRUMENT_HPP_
+#define _CEST_INSTRUMENT_HPP_
+
+#include <memory>      // std::allocator_traits
+#include <type_traits>
+#include <concepts>    // std::same_as
+#include <cstddef>     // std::size_t
+
+namespace cest {
+
+// Counts of the work done by the containers sharing a counting_allocator. The
+// counters are ordinary members; so, as the allocator only holds a pointer to
+// them, they may be inspected within the constant expression which uses the
+// containers, e.g. to static_assert an allocation budget.
+struct alloc_stats
+{
+  std::size_t allocations        = 0;
+  std::size_t deallocations      = 0;
+  std::size_t bytes_allocated    = 0;
+  std::size_t bytes_deallocated  = 0;
+  std::size_t peak_bytes         = 0;
+  std::size_t reallocations      = 0; // vector::reserve; string growth
+  std::size_t relocated_elements = 0; // moved or copied by a reallocation
+  std::size_t rotations          = 0; // map and set rebalancing
+  std::size_t chunk_allocations  = 0; // deque
+
+  constexpr std::size_t live_bytes() const noexcept {
+    return bytes_allocated - bytes_deallocated;
+  }
+
+  constexpr void reset() noexcept { *this = alloc_stats{}; }
+};
+
+// An allocator adaptor which records each allocation in an alloc_stats; and
+// through which the containers report their internal events. Without an
+// alloc_stats (e.g. when default constructed) nothing is counted.
+template <typename Allocator>
+class counting_allocator
+{
+  using traits = std::allocator_traits<Allocator>;
+
+public:
+  using value_type      = typename traits::value_type;
+  using size_type       = typename traits::size_type;
+  using difference_type = typename traits::difference_type;
+  using propagate_on_container_copy_assignment =
+    typename traits::propagate_on_container_copy_assignment;
+  using propagate_on_container_move_assignment =
+    typename traits::propagate_on_container_move_assignment;
+  using propagate_on_container_swap = typename traits::propagate_on_container_swap;
+
+  template <typename U>
+  struct rebind {
+    using other = counting_allocator<typename traits::template rebind_alloc<U>>;
+  };
+
+  constexpr counting_allocator() = default;
+  constexpr counting_allocator(alloc_stats& s,
+                               const Allocator& a = Allocator()) noexcept
+    : m_alloc(a), m_stats(&s) {}
+
+  template <typename A>
+  constexpr counting_allocator(const counting_allocator<A>& other) noexcept
+    : m_alloc(other.upstream()), m_stats(other.stats()) {}
+
+  [[nodiscard]] constexpr value_type* allocate(size_type n)
+  {
+    value_type* p = traits::allocate(m_alloc, n);
+    if (m_stats) {
+      ++m_stats->allocations;
+      m_stats->bytes_allocated += n * sizeof(value_type);
+      if (m_stats->live_bytes() > m_stats->peak_bytes)
+        m_stats->peak_bytes = m_stats->live_bytes();
+    }
+    return p;
+  }
+
+  constexpr void deallocate(value_type* p, size_type n)
+  {
+    if (m_stats) {
+      ++m_stats->deallocations;
+      m_stats->bytes_deallocated += n * sizeof(value_type);
+    }
+    traits::deallocate(m_alloc, p, n);
+  }
+
+  constexpr counting_allocator select_on_container_copy_construction() const
+  {
+    return counting_allocator(traits::select_on_container_copy_construction(
+                                m_alloc), m_stats);
+  }
+
+  constexpr alloc_stats*      stats()    const noexcept { return m_stats; }
+  constexpr const Allocator&  upstream() const noexcept { return m_alloc; }
+
+  template <typename A>
+  friend constexpr bool operator==(const counting_allocator& a,
+                                   const counting_allocator<A>& b) noexcept
+  {
+    return a.stats() == b.stats() && a.upstream() == b.upstream();
+  }
+
+private:
+  constexpr counting_allocator(const Allocator& a, alloc_stats* s) noexcept
+    : m_alloc(a), m_stats(s) {}
+
+  [[no_unique_address]] Allocator m_alloc;
+  alloc_stats* m_stats = nullptr;
+};
+
+namespace impl {
+
+// Called by the containers: a no-op unless the allocator is counting
+template <typename Alloc>
+constexpr void count(const Alloc& a, std::size_t alloc_stats::* counter,
+                     std::size_t n = 1) noexcept
+{
+  if constexpr (requires { { a.stats() } -> std::same_as<alloc_stats*>; })
+    if (alloc_stats* s = a.stats())
+      s->*counter += n;
+}
+
+} // namespace impl
+
+} // namespace cest
+
+#endif // _CEST_INSTRUMENT_HPP_
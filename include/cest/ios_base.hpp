@@ -197,11 +197,231 @@ public:
   constexpr fmtflags
   flags() const
   { return _M_flags; }
+
+  constexpr fmtflags
+  flags(fmtflags __fmtfl)
+  {
+    fmtflags __old = _M_flags;
+    _M_flags = __fmtfl;
+    return __old;
+  }
+
+  constexpr fmtflags
+  setf(fmtflags __fmtfl)
+  {
+    fmtflags __old = _M_flags;
+    _M_flags |= __fmtfl;
+    return __old;
+  }
+
+  constexpr fmtflags
+  setf(fmtflags __fmtfl, fmtflags __mask)
+  {
+    fmtflags __old = _M_flags;
+    _M_flags &= ~__mask;
+    _M_flags |= (__fmtfl & __mask);
+    return __old;
+  }
+
+  constexpr void
+  unsetf(fmtflags __mask)
+  { _M_flags &= ~__mask; }
+
+  constexpr streamsize
+  precision() const
+  { return _M_precision; }
+
+  constexpr streamsize
+  precision(streamsize __prec)
+  {
+    streamsize __old = _M_precision;
+    _M_precision = __prec;
+    return __old;
+  }
+
+  constexpr streamsize
+  width() const
+  { return _M_width; }
+
+  constexpr streamsize
+  width(streamsize __wide)
+  {
+    streamsize __old = _M_width;
+    _M_width = __wide;
+    return __old;
+  }
+
+  // Defined in cest/iostream.hpp
+  static bool sync_with_stdio(bool __sync = true);
 };
 
-constexpr ios_base& dec(ios_base& str) { return str; }
-constexpr ios_base& hex(ios_base& str) { return str; }
-constexpr ios_base& oct(ios_base& str) { return str; }
+constexpr ios_base&
+boolalpha(ios_base& __base)
+{
+  __base.setf(ios_base::boolalpha);
+  return __base;
+}
+
+constexpr ios_base&
+noboolalpha(ios_base& __base)
+{
+  __base.unsetf(ios_base::boolalpha);
+  return __base;
+}
+
+constexpr ios_base&
+showbase(ios_base& __base)
+{
+  __base.setf(ios_base::showbase);
+  return __base;
+}
+
+constexpr ios_base&
+noshowbase(ios_base& __base)
+{
+  __base.unsetf(ios_base::showbase);
+  return __base;
+}
+
+constexpr ios_base&
+showpoint(ios_base& __base)
+{
+  __base.setf(ios_base::showpoint);
+  return __base;
+}
+
+constexpr ios_base&
+noshowpoint(ios_base& __base)
+{
+  __base.unsetf(ios_base::showpoint);
+  return __base;
+}
+
+constexpr ios_base&
+showpos(ios_base& __base)
+{
+  __base.setf(ios_base::showpos);
+  return __base;
+}
+
+constexpr ios_base&
+noshowpos(ios_base& __base)
+{
+  __base.unsetf(ios_base::showpos);
+  return __base;
+}
+
+constexpr ios_base&
+skipws(ios_base& __base)
+{
+  __base.setf(ios_base::skipws);
+  return __base;
+}
+
+constexpr ios_base&
+noskipws(ios_base& __base)
+{
+  __base.unsetf(ios_base::skipws);
+  return __base;
+}
+
+constexpr ios_base&
+uppercase(ios_base& __base)
+{
+  __base.setf(ios_base::uppercase);
+  return __base;
+}
+
+constexpr ios_base&
+nouppercase(ios_base& __base)
+{
+  __base.unsetf(ios_base::uppercase);
+  return __base;
+}
+
+constexpr ios_base&
+unitbuf(ios_base& __base)
+{
+  __base.setf(ios_base::unitbuf);
+  return __base;
+}
+
+constexpr ios_base&
+nounitbuf(ios_base& __base)
+{
+  __base.unsetf(ios_base::unitbuf);
+  return __base;
+}
+
+constexpr ios_base&
+internal(ios_base& __base)
+{
+  __base.setf(ios_base::internal, ios_base::adjustfield);
+  return __base;
+}
+
+constexpr ios_base&
+left(ios_base& __base)
+{
+  __base.setf(ios_base::left, ios_base::adjustfield);
+  return __base;
+}
+
+constexpr ios_base&
+right(ios_base& __base)
+{
+  __base.setf(ios_base::right, ios_base::adjustfield);
+  return __base;
+}
+
+constexpr ios_base&
+dec(ios_base& __base)
+{
+  __base.setf(ios_base::dec, ios_base::basefield);
+  return __base;
+}
+
+constexpr ios_base&
+hex(ios_base& __base)
+{
+  __base.setf(ios_base::hex, ios_base::basefield);
+  return __base;
+}
+
+constexpr ios_base&
+oct(ios_base& __base)
+{
+  __base.setf(ios_base::oct, ios_base::basefield);
+  return __base;
+}
+
+constexpr ios_base&
+fixed(ios_base& __base)
+{
+  __base.setf(ios_base::fixed, ios_base::floatfield);
+  return __base;
+}
+
+constexpr ios_base&
+scientific(ios_base& __base)
+{
+  __base.setf(ios_base::scientific, ios_base::floatfield);
+  return __base;
+}
+
+constexpr ios_base&
+hexfloat(ios_base& __base)
+{
+  __base.setf(ios_base::fixed | ios_base::scientific, ios_base::floatfield);
+  return __base;
+}
+
+constexpr ios_base&
+defaultfloat(ios_base& __base)
+{
+  __base.unsetf(ios_base::floatfield);
+  return __base;
+}
 
 } // namespace cest
 
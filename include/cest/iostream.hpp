@@ -4,13 +4,119 @@
 #include "string.hpp"
 #include "ostream.hpp"
 #include "sstream.hpp"
+#include <cstdio>      // std::fflush, stdout, stderr
+#include <cerrno>      // errno, EINTR
+#include <unistd.h>    // ::write
+
+// The size in characters of the output buffers of cout, cerr and clog
+#ifndef CEST_STREAM_BUFFER_SIZE
+#define CEST_STREAM_BUFFER_SIZE 8192
+#endif
 
 namespace cest {
 
 namespace impl {
-  basic_stringbuf cout(string("cout"));
-  basic_stringbuf cerr(string("cerr"));
-  basic_stringbuf clog(string("clog"));
+
+// The streambuf of each standard output stream. As with std::cout, it is by
+// default synchronized with the C stdio stream of the same file: each
+// character is written with fwrite to stdout or stderr, so its output stays
+// in order with that of printf, or std::cout. After
+// ios_base::sync_with_stdio(false), characters accumulate instead in the put
+// area, and are written to the file descriptor with a single write(2) when
+// it is full, or on a flush; any output pending in the C stdio stream is
+// flushed first.
+class fd_streambuf : public basic_streambuf<char>
+{
+public:
+  explicit constexpr fd_streambuf(int __fd) : _M_fd(__fd), _M_buf{} { }
+
+  fd_streambuf(const fd_streambuf&) = delete;
+  fd_streambuf& operator=(const fd_streambuf&) = delete;
+
+  ~fd_streambuf() { this->sync(); }
+
+  // Flushes, then either empties the put area (so each character is written
+  // through stdio) or sets it to the buffer
+  bool _M_sync_with_stdio(bool __sync)
+  {
+    const bool __ok = _M_flush();
+    if (__sync)
+      this->setp(nullptr, nullptr);
+    else
+      this->setp(_M_buf, _M_buf + CEST_STREAM_BUFFER_SIZE);
+    return __ok;
+  }
+
+protected:
+  int_type overflow(int_type __c) override
+  {
+    if (_M_synced())
+    {
+      if (traits_type::eq_int_type(__c, traits_type::eof()))
+        return traits_type::not_eof(__c);
+      return std::fputc(__c, _M_file()) == EOF ? traits_type::eof() : __c;
+    }
+    if (!_M_flush())
+      return traits_type::eof();
+    if (!traits_type::eq_int_type(__c, traits_type::eof()))
+      return this->sputc(traits_type::to_char_type(__c));
+    return traits_type::not_eof(__c);
+  }
+
+  // Output which wouldn't fit in the put area is written directly
+  streamsize xsputn(const char_type* __s, streamsize __n) override
+  {
+    if (_M_synced())
+      return std::fwrite(__s, 1, static_cast<std::size_t>(__n), _M_file());
+    if (__n <= this->epptr() - this->pptr()) {
+      traits_type::copy(this->pptr(), __s, __n);
+      this->__safe_pbump(__n);
+      return __n;
+    }
+    if (!_M_flush() || !_M_write_all(__s, __n))
+      return 0;
+    return __n;
+  }
+
+  int sync() override { return _M_flush() ? 0 : -1; }
+
+private:
+  bool _M_synced() const { return this->epptr() == nullptr; }
+
+  std::FILE* _M_file() const { return _M_fd == 2 ? stderr : stdout; }
+
+  bool _M_flush()
+  {
+    const bool __ok = std::fflush(_M_file()) == 0;
+    const streamsize __n = this->pptr() - this->pbase();
+    if (__n == 0)
+      return __ok;
+    this->setp(_M_buf, _M_buf + CEST_STREAM_BUFFER_SIZE);
+    return _M_write_all(_M_buf, __n) && __ok;
+  }
+
+  bool _M_write_all(const char_type* __s, streamsize __n)
+  {
+    while (__n > 0) {
+      const auto __ret = ::write(_M_fd, __s, static_cast<std::size_t>(__n));
+      if (__ret < 0) {
+        if (errno == EINTR)
+          continue;
+        return false;
+      }
+      __s += __ret;
+      __n -= __ret;
+    }
+    return true;
+  }
+
+  int  _M_fd;
+  char _M_buf[CEST_STREAM_BUFFER_SIZE];
+};
+
+  fd_streambuf cout(1);
+  fd_streambuf cerr(2);
+  fd_streambuf clog(2);
   basic_stringbuf cin(string("cin"));
 }
 
@@ -19,6 +125,35 @@ ostream cerr(&impl::cerr);
 ostream clog(&impl::clog);
 istream cin(&impl::cin);
 
+namespace impl {
+
+// As libstdc++'s ios_base::Init: cerr is unit-buffered; and cin and cerr are
+// tied to cout, which is then flushed before either is used.
+struct ios_init
+{
+  ios_init()
+  {
+    cest::cerr.setf(ios_base::unitbuf);
+    cest::cerr.tie(&cest::cout);
+    cest::cin.tie(&cest::cout);
+  }
+} ios_init_object;
+
+} // namespace impl
+
+// As std::ios_base::sync_with_stdio; but it may be called at any time. The
+// previous setting is returned.
+inline bool ios_base::sync_with_stdio(bool __sync)
+{
+  static bool __synced = true;
+  const bool __old = __synced;
+  impl::cout._M_sync_with_stdio(__sync);
+  impl::cerr._M_sync_with_stdio(__sync);
+  impl::clog._M_sync_with_stdio(__sync);
+  __synced = __sync;
+  return __old;
+}
+
 using iostream  = basic_iostream<char>;
 using wiostream = basic_iostream<wchar_t>;
 
@@ -2,11 +2,29 @@
 #define _CEST_ISTREAM_HPP_
 
 #include "ios.hpp" // cest::basic_ios
+#include "ostream.hpp" // cest::basic_ostream
 #include "streambuf.hpp"
+#include "bits/from_chars.hpp" // cest::impl::__int_scanner, __fp_scanner
 #include <string>  // std::char_traits
+#include <limits>  // std::numeric_limits
+#include <cstddef> // std::size_t
+#include <algorithm> // std::min
 
 namespace cest {
 
+namespace impl {
+
+// As isspace in the "C" locale; which replaces the ctype facet used by
+// libstdc++ to skip whitespace
+template <typename _CharT>
+constexpr bool
+__is_space(_CharT __c)
+{
+  return __c == _CharT(' ') || (__c >= _CharT('\t') && __c <= _CharT('\r'));
+}
+
+} // namespace impl
+
 template <class _CharT, class _Traits>
   class basic_istream : /*virtual*/ public basic_ios<_CharT, _Traits>
 {
@@ -44,6 +62,78 @@ public:
   gcount() const
   { return _M_gcount; }
 
+  constexpr __istream_type&
+  operator>>(__istream_type& (*__pf)(__istream_type&))
+  { return __pf(*this); }
+
+  constexpr __istream_type&
+  operator>>(__ios_type& (*__pf)(__ios_type&))
+  {
+    __pf(*this);
+    return *this;
+  }
+
+  // for hex, and noskipws
+  constexpr __istream_type&
+  operator>>(ios_base& (*__pf)(ios_base&))
+  {
+    __pf(*this);
+    return *this;
+  }
+
+  constexpr __istream_type&
+  operator>>(bool& __n);
+
+  constexpr __istream_type&
+  operator>>(short& __n)
+  { return _M_extract_narrow(__n); }
+
+  constexpr __istream_type&
+  operator>>(unsigned short& __n)
+  { return _M_extract(__n); }
+
+  constexpr __istream_type&
+  operator>>(int& __n)
+  { return _M_extract_narrow(__n); }
+
+  constexpr __istream_type&
+  operator>>(unsigned int& __n)
+  { return _M_extract(__n); }
+
+  constexpr __istream_type&
+  operator>>(long& __n)
+  { return _M_extract(__n); }
+
+  constexpr __istream_type&
+  operator>>(unsigned long& __n)
+  { return _M_extract(__n); }
+
+  constexpr __istream_type&
+  operator>>(long long& __n)
+  { return _M_extract(__n); }
+
+  constexpr __istream_type&
+  operator>>(unsigned long long& __n)
+  { return _M_extract(__n); }
+
+  constexpr __istream_type&
+  operator>>(float& __f)
+  { return _M_extract(__f); }
+
+  constexpr __istream_type&
+  operator>>(double& __f)
+  { return _M_extract(__f); }
+
+  // There is no long double parser; so the value is that of a double
+  constexpr __istream_type&
+  operator>>(long double& __f)
+  {
+    double __d = 0;
+    _M_extract(__d);
+    __f = __d;
+    return *this;
+  }
+
   constexpr
   __istream_type&
   get(char_type& ch);
@@ -56,10 +146,85 @@ public:
   __istream_type&
   read(char_type*, streamsize);
 
+  constexpr
+  __istream_type&
+  getline(char_type* __s, streamsize __n)
+  { return this->getline(__s, __n, this->widen('\n')); }
+
+  constexpr
+  __istream_type&
+  getline(char_type* __s, streamsize __n, char_type __delim);
+
+  constexpr
+  __istream_type&
+  ignore(streamsize __n = 1, int_type __delim = traits_type::eof());
+
+  constexpr
+  int_type
+  peek();
+
+  constexpr
+  __istream_type&
+  putback(char_type __c);
+
+  constexpr
+  streamsize
+  readsome(char_type* __s, streamsize __n);
+
+  // Passes to __sink, a run of the get area at a time, at most __n characters
+  // preceding __delim (found with traits_type::find); or all of them if
+  // __delim is eof. Returns the number extracted; leaving __c as the next
+  // character, or eof. The caller has constructed the sentry.
+  template<typename _Sink>
+  constexpr streamsize
+  _M_copy_until(streamsize __n, int_type __delim, int_type& __c,
+                _Sink&& __sink);
+
 protected:
   constexpr basic_istream()
   : _M_gcount(streamsize(0))
   { this->init(0); }
+
+  template<typename _ValueT>
+  constexpr __istream_type&
+  _M_extract(_ValueT& __v);
+
+  // As libstdc++: a short or int is extracted as a long, and then checked
+  template<typename _ValueT>
+  constexpr __istream_type&
+  _M_extract_narrow(_ValueT& __n)
+  {
+    long __l = 0;
+    _M_extract(__l);
+    using _Lim = std::numeric_limits<_ValueT>;
+    if (__l < _Lim::min())
+      {
+  this->setstate(ios_base::failbit);
+  __n = _Lim::min();
+      }
+    else if (__l > _Lim::max())
+      {
+  this->setstate(ios_base::failbit);
+  __n = _Lim::max();
+      }
+    else
+      __n = _ValueT(__l);
+    return *this;
+  }
+
+  // Feeds characters to __sc until it rejects one, which is left unread
+  template<typename _Scanner>
+  constexpr ios_base::iostate
+  _M_scan(_Scanner& __sc)
+  {
+    __streambuf_type* __sb = this->rdbuf();
+    int_type __c = __sb->sgetc();
+    while (!traits_type::eq_int_type(__c, traits_type::eof()) &&
+           __sc._M_feed(traits_type::to_char_type(__c)))
+      __c = __sb->snextc();
+    return traits_type::eq_int_type(__c, traits_type::eof()) ? ios_base::eofbit
+                                                             : ios_base::goodbit;
+  }
 };
 
 using istream = basic_istream<char>;
@@ -74,7 +239,6 @@ using wistream = basic_istream<wchar_t>;
     typedef _Traits           traits_type;
     typedef basic_streambuf<_CharT, _Traits>    __streambuf_type;
     typedef basic_istream<_CharT, _Traits>    __istream_type;
-    typedef typename __istream_type::__ctype_type   __ctype_type;
     typedef typename _Traits::int_type    __int_type;
 
     explicit constexpr
@@ -102,23 +266,9 @@ using wistream = basic_istream<wchar_t>;
     __streambuf_type* __sb = __in.rdbuf();
     __int_type __c = __sb->sgetc();
 
-#if !defined(_LIBCPP_VERSION)
-    const __ctype_type& __ct = __check_facet(__in._M_ctype);
-#else
-    // The way it should be done in libcxx, except that all of this is not 
-    // constexpr yet..
-    // const std::ctype<_CharT>& __ct = std::use_facet<std::ctype<_CharT> >(__in.getloc());
-
-    // No __check_facet in libcxx and std::use_facet requires a lot of 
-    // non-constexpr functionallity, so using a default in its place for now. So
-    // if we end up with some strange output this may be the cause.
-    struct __place_holder_ctype : std::ctype<char> {};
-    const __ctype_type& __ct = __place_holder_ctype();
-#endif
-    
+    // No locale: the ctype facet's is(space, __c) isn't constexpr
     while (!traits_type::eq_int_type(__c, __eof)
-           && __ct.is(std::ctype_base::space,
-          traits_type::to_char_type(__c)))
+           && impl::__is_space(traits_type::to_char_type(__c)))
       __c = __sb->snextc();
 
     // _GLIBCXX_RESOLVE_LIB_DEFECTS
@@ -257,12 +407,666 @@ using wistream = basic_istream<wchar_t>;
       return *this;
     }
 
+  // from istream.tcc; the get area is scanned and copied a run at a time,
+  // rather than a character at a time
+  template<typename _CharT, typename _Traits>
+    constexpr basic_istream<_CharT, _Traits>&
+    basic_istream<_CharT, _Traits>::
+    getline(char_type* __s, streamsize __n, char_type __delim)
+    {
+      _M_gcount = 0;
+      ios_base::iostate __err = ios_base::goodbit;
+      sentry __cerb(*this, true);
+      if (__cerb)
+  {
+    __try
+      {
+        const int_type __eof = traits_type::eof();
+        const int_type __idelim = traits_type::to_int_type(__delim);
+        int_type __c = __eof;
+        _M_gcount = _M_copy_until(__n - 1, __idelim, __c,
+          [&__s](const char_type* __p, streamsize __len)
+          {
+            traits_type::copy(__s, __p, __len);
+            __s += __len;
+          });
+
+        if (traits_type::eq_int_type(__c, __eof))
+    __err |= ios_base::eofbit;
+        else if (traits_type::eq_int_type(__c, __idelim))
+    {
+      _M_gcount++;
+      this->rdbuf()->sbumpc();
+    }
+        else
+    __err |= ios_base::failbit;
+      }
+#if !defined(_LIBCPP_VERSION)
+    __catch(__cxxabiv1::__forced_unwind&)
+      {
+        this->_M_setstate(ios_base::badbit);
+        __throw_exception_again;
+      }
+#endif
+    __catch(...)
+      { this->_M_setstate(ios_base::badbit); }
+  }
+      // _GLIBCXX_RESOLVE_LIB_DEFECTS
+      // 243. get and getline when sentry reports failure.
+      if (__n > 0)
+  *__s = char_type();
+      if (!_M_gcount)
+  __err |= ios_base::failbit;
+      if (__err)
+  this->setstate(__err);
+      return *this;
+    }
+
+  // from istream.tcc
+  template<typename _CharT, typename _Traits>
+    constexpr basic_istream<_CharT, _Traits>&
+    basic_istream<_CharT, _Traits>::
+    ignore(streamsize __n, int_type __delim)
+    {
+      _M_gcount = 0;
+      sentry __cerb(*this, true);
+      if (__cerb && __n > 0)
+  {
+    ios_base::iostate __err = ios_base::goodbit;
+    __try
+      {
+        const int_type __eof = traits_type::eof();
+        int_type __c = __eof;
+        _M_gcount = _M_copy_until(__n, __delim, __c,
+                                  [](const char_type*, streamsize) { });
+
+        if (traits_type::eq_int_type(__c, __eof))
+    __err |= ios_base::eofbit;
+        else if (_M_gcount < __n
+           && traits_type::eq_int_type(__c, __delim))
+    {
+      _M_gcount++;
+      this->rdbuf()->sbumpc();
+    }
+      }
+#if !defined(_LIBCPP_VERSION)
+    __catch(__cxxabiv1::__forced_unwind&)
+      {
+        this->_M_setstate(ios_base::badbit);
+        __throw_exception_again;
+      }
+#endif
+    __catch(...)
+      { this->_M_setstate(ios_base::badbit); }
+    if (__err)
+      this->setstate(__err);
+  }
+      return *this;
+    }
+
+  // from istream.tcc
+  template<typename _CharT, typename _Traits>
+    constexpr typename basic_istream<_CharT, _Traits>::int_type
+    basic_istream<_CharT, _Traits>::
+    peek(void)
+    {
+      int_type __c = traits_type::eof();
+      _M_gcount = 0;
+      sentry __cerb(*this, true);
+      if (__cerb)
+  {
+    ios_base::iostate __err = ios_base::goodbit;
+    __try
+      {
+        __c = this->rdbuf()->sgetc();
+        if (traits_type::eq_int_type(__c, traits_type::eof()))
+    __err |= ios_base::eofbit;
+      }
+#if !defined(_LIBCPP_VERSION)
+    __catch(__cxxabiv1::__forced_unwind&)
+      {
+        this->_M_setstate(ios_base::badbit);
+        __throw_exception_again;
+      }
+#endif
+    __catch(...)
+      { this->_M_setstate(ios_base::badbit); }
+    if (__err)
+      this->setstate(__err);
+  }
+      return __c;
+    }
+
+  // from istream.tcc
+  template<typename _CharT, typename _Traits>
+    constexpr basic_istream<_CharT, _Traits>&
+    basic_istream<_CharT, _Traits>::
+    putback(char_type __c)
+    {
+      // _GLIBCXX_RESOLVE_LIB_DEFECTS
+      // 60. What is a formatted input function?
+      _M_gcount = 0;
+      // Clear eofbit per N3168.
+      this->clear(this->rdstate() & ~ios_base::eofbit);
+      sentry __cerb(*this, true);
+      if (__cerb)
+  {
+    ios_base::iostate __err = ios_base::goodbit;
+    __try
+      {
+        const int_type __eof = traits_type::eof();
+        __streambuf_type* __sb = this->rdbuf();
+        if (!__sb
+      || traits_type::eq_int_type(__sb->sputbackc(__c), __eof))
+    __err |= ios_base::badbit;
+      }
+#if !defined(_LIBCPP_VERSION)
+    __catch(__cxxabiv1::__forced_unwind&)
+      {
+        this->_M_setstate(ios_base::badbit);
+        __throw_exception_again;
+      }
+#endif
+    __catch(...)
+      { this->_M_setstate(ios_base::badbit); }
+    if (__err)
+      this->setstate(__err);
+  }
+      return *this;
+    }
 
+  // from istream.tcc
+  template<typename _CharT, typename _Traits>
+    constexpr streamsize
+    basic_istream<_CharT, _Traits>::
+    readsome(char_type* __s, streamsize __n)
+    {
+      _M_gcount = 0;
+      sentry __cerb(*this, true);
+      if (__cerb)
+  {
+    ios_base::iostate __err = ios_base::goodbit;
+    __try
+      {
+        // Cannot compare int_type with streamsize generically.
+        const streamsize __num = this->rdbuf()->in_avail();
+        if (__num > 0)
+    _M_gcount = this->rdbuf()->sgetn(__s, std::min(__num, __n));
+        else if (__num == -1)
+    __err |= ios_base::eofbit;
+      }
+#if !defined(_LIBCPP_VERSION)
+    __catch(__cxxabiv1::__forced_unwind&)
+      {
+        this->_M_setstate(ios_base::badbit);
+        __throw_exception_again;
+      }
+#endif
+    __catch(...)
+      { this->_M_setstate(ios_base::badbit); }
+    if (__err)
+      this->setstate(__err);
+  }
+      return _M_gcount;
+    }
+
+  // As the char specialisations of getline and ignore in libstdc++'s
+  // istream.cc; a run of the get area is passed on at once
+  template<typename _CharT, typename _Traits>
+    template<typename _Sink>
+      constexpr streamsize
+      basic_istream<_CharT, _Traits>::
+      _M_copy_until(streamsize __n, int_type __delim, int_type& __c,
+                    _Sink&& __sink)
+      {
+  const int_type __eof = traits_type::eof();
+  const bool __find = !traits_type::eq_int_type(__delim, __eof);
+  const char_type __cdelim = traits_type::to_char_type(__delim);
+  __streambuf_type* __sb = this->rdbuf();
+  streamsize __count = 0;
+
+  __c = __sb->sgetc();
+  while (__count < __n
+         && !traits_type::eq_int_type(__c, __eof)
+         && !traits_type::eq_int_type(__c, __delim))
+    {
+      streamsize __size = std::min(streamsize(__sb->egptr() - __sb->gptr()),
+                                   __n - __count);
+      if (__size > 1)
+        {
+          const char_type* __p = __find
+            ? traits_type::find(__sb->gptr(), __size, __cdelim) : nullptr;
+          if (__p)
+            __size = __p - __sb->gptr();
+          __sink(__sb->gptr(), __size);
+          __sb->__safe_gbump(__size);
+          __count += __size;
+          __c = __sb->sgetc();
+        }
+      else
+        {
+          const char_type __ch = traits_type::to_char_type(__c);
+          __sink(&__ch, 1);
+          ++__count;
+          __c = __sb->snextc();
+        }
+    }
+  return __count;
+      }
+
+  // Unlike istream.tcc, the characters are parsed without a locale; and the
+  // number is accumulated as it is read, rather than in a string.
+  template<typename _CharT, typename _Traits>
+    template<typename _ValueT>
+      constexpr basic_istream<_CharT, _Traits>&
+      basic_istream<_CharT, _Traits>::
+      _M_extract(_ValueT& __v)
+      {
+  sentry __cerb(*this, false);
+  if (__cerb)
+    {
+      ios_base::iostate __err = ios_base::goodbit;
+      __try
+        {
+    if constexpr (std::is_floating_point_v<_ValueT>)
+      {
+        impl::__fp_scanner __sc;
+        __err = _M_scan(__sc);
+        // As num_get: an out of range value is the largest; and fails
+        if (!__sc._M_valid())
+          {
+      __v = 0;
+      __err |= ios_base::failbit;
+          }
+        else
+          {
+      __v = __sc.template _M_value<_ValueT>();
+      using _Lim = std::numeric_limits<_ValueT>;
+      if (__v == _Lim::infinity() || __v == -_Lim::infinity())
+        {
+          __v = __v < 0 ? -_Lim::max() : _Lim::max();
+          __err |= ios_base::failbit;
+        }
+          }
+      }
+    else
+      {
+        const ios_base::fmtflags __basefield = this->flags()
+                                             & ios_base::basefield;
+        impl::__int_scanner<_ValueT>
+          __sc(__basefield == ios_base::oct ? 8
+               : __basefield == ios_base::hex ? 16
+               : __basefield == ios_base::dec ? 10 : 0);
+        __err = _M_scan(__sc);
+        if (!__sc._M_result(__v))
+          __err |= ios_base::failbit;
+      }
+        }
+#if !defined(_LIBCPP_VERSION)
+      __catch(__cxxabiv1::__forced_unwind&)
+        {
+    this->_M_setstate(ios_base::badbit);
+    __throw_exception_again;
+        }
+#endif
+      __catch(...)
+        { this->_M_setstate(ios_base::badbit); }
+      if (__err)
+        this->setstate(__err);
+    }
+  return *this;
+      }
+
+  // As num_get::_M_extract_bool: with boolalpha, the longest prefix of "true"
+  // or "false" is read; otherwise the value must be 0 or 1
+  template<typename _CharT, typename _Traits>
+    constexpr basic_istream<_CharT, _Traits>&
+    basic_istream<_CharT, _Traits>::
+    operator>>(bool& __n)
+    {
+      if (!(this->flags() & ios_base::boolalpha))
+  {
+    long __l = -1;
+    _M_extract(__l);
+    if (__l == 0 || __l == 1)
+      __n = bool(__l);
+    else
+      {
+        // _GLIBCXX_RESOLVE_LIB_DEFECTS
+        // 23. Num_get overflow result.
+        __n = true;
+        this->setstate(ios_base::failbit);
+      }
+    return *this;
+  }
+
+      sentry __cerb(*this, false);
+      if (__cerb)
+  {
+    ios_base::iostate __err = ios_base::goodbit;
+    __try
+      {
+        const char __truename[] = "true", __falsename[] = "false";
+        const std::size_t __truesize = 4, __falsesize = 5;
+        __streambuf_type* __sb = this->rdbuf();
+        bool __testf = true, __testt = true, __testeof = false;
+        bool __donef = false, __donet = false;
+        std::size_t __i = 0;
+        while (!__donef || !__donet)
+    {
+      const int_type __c = __sb->sgetc();
+      if (traits_type::eq_int_type(__c, traits_type::eof()))
+        {
+          __testeof = true;
+          break;
+        }
+      const char_type __ch = traits_type::to_char_type(__c);
+      if (!__donef)
+        __testf = __ch == char_type(__falsename[__i]);
+      if (!__testf && __donet)
+        break;
+      if (!__donet)
+        __testt = __ch == char_type(__truename[__i]);
+      if (!__testt && __donef)
+        break;
+      if (!__testt && !__testf)
+        break;
+      ++__i;
+      __sb->sbumpc();
+      __donef = !__testf || __i >= __falsesize;
+      __donet = !__testt || __i >= __truesize;
+    }
+        if (__testf && __i == __falsesize)
+    __n = false;
+        else if (__testt && __i == __truesize)
+    __n = true;
+        else
+    {
+      __n = false;
+      __err |= ios_base::failbit;
+    }
+        if (__testeof)
+    __err |= ios_base::eofbit;
+      }
+#if !defined(_LIBCPP_VERSION)
+    __catch(__cxxabiv1::__forced_unwind&)
+      {
+        this->_M_setstate(ios_base::badbit);
+        __throw_exception_again;
+      }
+#endif
+    __catch(...)
+      { this->_M_setstate(ios_base::badbit); }
+    if (__err)
+      this->setstate(__err);
+  }
+      return *this;
+    }
+
+  // from istream.tcc
+  template<typename _CharT, typename _Traits>
+    constexpr basic_istream<_CharT, _Traits>&
+    operator>>(basic_istream<_CharT, _Traits>& __in, _CharT& __c)
+    {
+      typedef basic_istream<_CharT, _Traits>    __istream_type;
+      typedef typename __istream_type::int_type __int_type;
+
+      typename __istream_type::sentry __cerb(__in, false);
+      if (__cerb)
+  {
+    ios_base::iostate __err = ios_base::goodbit;
+    __try
+      {
+        const __int_type __cb = __in.rdbuf()->sbumpc();
+        if (!_Traits::eq_int_type(__cb, _Traits::eof()))
+    __c = _Traits::to_char_type(__cb);
+        else
+    __err |= (ios_base::eofbit | ios_base::failbit);
+      }
+#if !defined(_LIBCPP_VERSION)
+    __catch(__cxxabiv1::__forced_unwind&)
+      {
+        __in._M_setstate(ios_base::badbit);
+        __throw_exception_again;
+      }
+#endif
+    __catch(...)
+      { __in._M_setstate(ios_base::badbit); }
+    if (__err)
+      __in.setstate(__err);
+  }
+      return __in;
+    }
+
+  // from istream.tcc; as C++20, into an array of known size. At most width()
+  // - 1 (if non-zero) characters, up to whitespace, are extracted.
+  template<typename _CharT, typename _Traits, std::size_t _Num>
+    constexpr basic_istream<_CharT, _Traits>&
+    operator>>(basic_istream<_CharT, _Traits>& __in, _CharT (&__s)[_Num])
+    {
+      typedef basic_istream<_CharT, _Traits>    __istream_type;
+      typedef typename __istream_type::int_type __int_type;
+
+      streamsize __extracted = 0;
+      ios_base::iostate __err = ios_base::goodbit;
+      typename __istream_type::sentry __cerb(__in, false);
+      if (__cerb)
+  {
+    __try
+      {
+        streamsize __num = static_cast<streamsize>(_Num);
+        if (__in.width() > 0 && __in.width() < __num)
+    __num = __in.width();
+
+        const __int_type __eof = _Traits::eof();
+        __int_type __c = __in.rdbuf()->sgetc();
+        while (__extracted < __num - 1
+         && !_Traits::eq_int_type(__c, __eof)
+         && !impl::__is_space(_Traits::to_char_type(__c)))
+    {
+      __s[__extracted++] = _Traits::to_char_type(__c);
+      __c = __in.rdbuf()->snextc();
+    }
+        if (_Traits::eq_int_type(__c, __eof))
+    __err |= ios_base::eofbit;
+
+        // _GLIBCXX_RESOLVE_LIB_DEFECTS
+        // 68.  Extractors for char* should store null at end
+        __s[__extracted] = _CharT();
+        __in.width(0);
+      }
+#if !defined(_LIBCPP_VERSION)
+    __catch(__cxxabiv1::__forced_unwind&)
+      {
+        __in._M_setstate(ios_base::badbit);
+        __throw_exception_again;
+      }
+#endif
+    __catch(...)
+      { __in._M_setstate(ios_base::badbit); }
+  }
+      if (!__extracted)
+  __err |= ios_base::failbit;
+      if (__err)
+  __in.setstate(__err);
+      return __in;
+    }
+
+  // The basic_ios base of std::basic_iostream is virtual; and so not usable
+  // within a constant expression. Here each of the two bases instead has its
+  // own basic_ios, initialised with the same streambuf; and the basic_ios and
+  // ios_base members below apply to both. (A manipulator, such as hex, which
+  // is inserted or extracted, applies only to that direction.)
   template<typename _CharT, typename _Traits>
     class basic_iostream
-    : public basic_istream<_CharT, _Traits>//,
-//      public basic_ostream<_CharT, _Traits>
+    : public basic_istream<_CharT, _Traits>,
+      public basic_ostream<_CharT, _Traits>
     {
+    public:
+      typedef _CharT          char_type;
+      typedef typename _Traits::int_type    int_type;
+      typedef typename _Traits::pos_type    pos_type;
+      typedef typename _Traits::off_type    off_type;
+      typedef _Traits         traits_type;
+
+      typedef basic_streambuf<_CharT, _Traits>    __streambuf_type;
+      typedef basic_istream<_CharT, _Traits>    __istream_type;
+      typedef basic_ostream<_CharT, _Traits>    __ostream_type;
+
+      explicit constexpr
+      basic_iostream(__streambuf_type* __sb)
+      : __istream_type(__sb), __ostream_type(__sb) { }
+
+      virtual constexpr
+      ~basic_iostream() { }
+
+      constexpr void
+      init(__streambuf_type* __sb)
+      {
+  __istream_type::init(__sb);
+  __ostream_type::init(__sb);
+      }
+
+      constexpr __streambuf_type*
+      rdbuf() const
+      { return __istream_type::rdbuf(); }
+
+      constexpr ios_base::iostate
+      rdstate() const
+      { return __istream_type::rdstate() | __ostream_type::rdstate(); }
+
+      constexpr void
+      clear(ios_base::iostate __state = ios_base::goodbit)
+      {
+  __istream_type::clear(__state);
+  __ostream_type::clear(__state);
+      }
+
+      constexpr void
+      setstate(ios_base::iostate __state)
+      { this->clear(this->rdstate() | __state); }
+
+      explicit constexpr operator bool() const
+      { return !this->fail(); }
+
+      constexpr bool
+      operator!() const
+      { return this->fail(); }
+
+      constexpr bool
+      good() const
+      { return this->rdstate() == 0; }
+
+      constexpr bool
+      eof() const
+      { return (this->rdstate() & ios_base::eofbit) != 0; }
+
+      constexpr bool
+      fail() const
+      { return (this->rdstate() & (ios_base::badbit | ios_base::failbit)) != 0; }
+
+      constexpr bool
+      bad() const
+      { return (this->rdstate() & ios_base::badbit) != 0; }
+
+      constexpr ios_base::iostate
+      exceptions() const
+      { return __istream_type::exceptions(); }
+
+      constexpr void
+      exceptions(ios_base::iostate __except)
+      {
+  __istream_type::exceptions(__except);
+  __ostream_type::exceptions(__except);
+      }
+
+      constexpr __ostream_type*
+      tie() const
+      { return __istream_type::tie(); }
+
+      constexpr __ostream_type*
+      tie(__ostream_type* __tiestr)
+      {
+  __ostream_type::tie(__tiestr);
+  return __istream_type::tie(__tiestr);
+      }
+
+      constexpr ios_base::fmtflags
+      flags() const
+      { return __istream_type::flags(); }
+
+      constexpr ios_base::fmtflags
+      flags(ios_base::fmtflags __fmtfl)
+      {
+  __ostream_type::flags(__fmtfl);
+  return __istream_type::flags(__fmtfl);
+      }
+
+      constexpr ios_base::fmtflags
+      setf(ios_base::fmtflags __fmtfl)
+      {
+  __ostream_type::setf(__fmtfl);
+  return __istream_type::setf(__fmtfl);
+      }
+
+      constexpr ios_base::fmtflags
+      setf(ios_base::fmtflags __fmtfl, ios_base::fmtflags __mask)
+      {
+  __ostream_type::setf(__fmtfl, __mask);
+  return __istream_type::setf(__fmtfl, __mask);
+      }
+
+      constexpr void
+      unsetf(ios_base::fmtflags __mask)
+      {
+  __ostream_type::unsetf(__mask);
+  __istream_type::unsetf(__mask);
+      }
+
+      constexpr streamsize
+      precision() const
+      { return __ostream_type::precision(); }
+
+      constexpr streamsize
+      precision(streamsize __prec)
+      {
+  __istream_type::precision(__prec);
+  return __ostream_type::precision(__prec);
+      }
+
+      constexpr streamsize
+      width() const
+      { return __ostream_type::width(); }
+
+      constexpr streamsize
+      width(streamsize __wide)
+      {
+  __istream_type::width(__wide);
+  return __ostream_type::width(__wide);
+      }
+
+      constexpr char_type
+      fill() const
+      { return __ostream_type::fill(); }
+
+      constexpr char_type
+      fill(char_type __ch)
+      {
+  __istream_type::fill(__ch);
+  return __ostream_type::fill(__ch);
+      }
+
+      constexpr char_type
+      widen(char __c) const
+      { return __ostream_type::widen(__c); }
+
+      constexpr char
+      narrow(char_type __c, char __dfault) const
+      { return __ostream_type::narrow(__c, __dfault); }
+
+    protected:
+      constexpr basic_iostream()
+      : __istream_type(), __ostream_type() { }
     };
 
 } // namespace cest
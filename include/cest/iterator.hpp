@@ -1,13 +1,108 @@
 #ifndef _CEST_ITERATOR_HPP_
 #define _CEST_ITERATOR_HPP_
 
+#include "istream.hpp"   // cest::basic_istream
+#include "streambuf.hpp" // cest::basic_streambuf
 #include <iterator> // std::iterator_traits
+#include <string>   // std::char_traits
 
 namespace cest {
 
   using std::inserter;
   using std::back_inserter;
-  using std::istreambuf_iterator;
+
+  // from streambuf_iterator.h; over a cest::basic_streambuf
+  template<typename _CharT, typename _Traits = std::char_traits<_CharT>>
+    class istreambuf_iterator
+    {
+    public:
+      typedef std::input_iterator_tag           iterator_category;
+      typedef _CharT                            value_type;
+      typedef typename _Traits::off_type        difference_type;
+      typedef _CharT*                           pointer;
+      typedef _CharT                            reference;
+
+      typedef _CharT                            char_type;
+      typedef _Traits                           traits_type;
+      typedef typename _Traits::int_type        int_type;
+      typedef basic_streambuf<_CharT, _Traits>  streambuf_type;
+      typedef basic_istream<_CharT, _Traits>    istream_type;
+
+    private:
+      // 24.5.3 istreambuf_iterator
+      // p 1
+      // If the end of stream is reached (streambuf_type::sgetc()
+      // returns traits_type::eof()), the iterator becomes equal to
+      // the "end of stream" iterator value.
+      mutable streambuf_type* _M_sbuf;
+      int_type                _M_c;
+
+    public:
+      constexpr istreambuf_iterator() noexcept
+      : _M_sbuf(0), _M_c(traits_type::eof()) { }
+
+      constexpr istreambuf_iterator(std::default_sentinel_t) noexcept
+      : istreambuf_iterator() { }
+
+      constexpr istreambuf_iterator(istream_type& __s) noexcept
+      : _M_sbuf(__s.rdbuf()), _M_c(traits_type::eof()) { }
+
+      constexpr istreambuf_iterator(streambuf_type* __s) noexcept
+      : _M_sbuf(__s), _M_c(traits_type::eof()) { }
+
+      constexpr char_type
+      operator*() const
+      { return traits_type::to_char_type(_M_get()); }
+
+      constexpr istreambuf_iterator&
+      operator++()
+      {
+        _M_sbuf->sbumpc();
+        _M_c = traits_type::eof();
+        return *this;
+      }
+
+      constexpr istreambuf_iterator
+      operator++(int)
+      {
+        istreambuf_iterator __old = *this;
+        __old._M_c = _M_sbuf->sbumpc();
+        _M_c = traits_type::eof();
+        return __old;
+      }
+
+      // _GLIBCXX_RESOLVE_LIB_DEFECTS
+      // 110 istreambuf_iterator::equal not const
+      // NB: there is also number 111 (NAD) relevant to this function.
+      constexpr bool
+      equal(const istreambuf_iterator& __b) const
+      { return _M_at_eof() == __b._M_at_eof(); }
+
+      friend constexpr bool
+      operator==(const istreambuf_iterator& __a,
+                 const istreambuf_iterator& __b)
+      { return __a.equal(__b); }
+
+      friend constexpr bool
+      operator==(const istreambuf_iterator& __i, std::default_sentinel_t)
+      { return __i._M_at_eof(); }
+
+    private:
+      constexpr int_type
+      _M_get() const
+      {
+        int_type __ret = _M_c;
+        if (_M_sbuf && traits_type::eq_int_type(__ret, traits_type::eof())
+            && traits_type::eq_int_type(__ret = _M_sbuf->sgetc(),
+                                        traits_type::eof()))
+          _M_sbuf = 0;
+        return __ret;
+      }
+
+      constexpr bool
+      _M_at_eof() const
+      { return traits_type::eq_int_type(_M_get(), traits_type::eof()); }
+    };
 
 } // namespace cest
 
@@ -137,9 +137,13 @@ struct list {
   };
   
   constexpr list() : m_size{} {}
+  explicit constexpr list(const Allocator& alloc)
+    : m_size{}, m_node_alloc(alloc) {}
   constexpr ~list() { clear(); }
 
-  constexpr list(const list& other) : list()
+  constexpr list(const list& other)
+    : list(std::allocator_traits<Allocator>::
+             select_on_container_copy_construction(other.get_allocator()))
   {
     for (auto it = other.cbegin(); it != other.cend(); ++it)
       push_back(*it);
@@ -295,6 +299,12 @@ struct list {
   typename std::allocator_traits<allocator_type>::template rebind_alloc<node> m_node_alloc;
 };
 
+namespace pmr {
+template <typename T> class polymorphic_allocator; // cest/memory_resource.hpp
+template <class T>
+using list = cest::list<T, polymorphic_allocator<T>>;
+} // namespace pmr
+
 } // namespace cest
 
 #endif // _CEST_LIST_HPP_
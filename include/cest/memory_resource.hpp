@@ -0,0 +1,410 @@
+#ifndef _CEST_MEMORY_RESOURCE_HPP_
+#define _CEST_MEMORY_RESOURCE_HPP_
+
+#include "cest/arena.hpp"
+#include "cest/vector.hpp"
+#include <memory>      // std::allocator
+#include <new>         // ::operator new, std::align_val_t
+#include <atomic>      // std::atomic
+#include <mutex>       // std::mutex, std::lock_guard
+#include <type_traits>
+#include <cstddef>     // std::size_t, std::byte, std::max_align_t
+
+namespace cest::pmr {
+
+// As std::pmr::memory_resource. A constant expression can't convert the void*
+// returned by allocate to a T*; so there a polymorphic_allocator instead asks
+// the resource for a typed_arena(). A monotonic_buffer_resource provides its
+// arena; other resources return null, and std::allocator is used.
+class memory_resource
+{
+  static constexpr std::size_t max_align = alignof(std::max_align_t);
+
+public:
+  constexpr memory_resource() = default;
+  constexpr memory_resource(const memory_resource&) = default;
+  constexpr virtual ~memory_resource() = default;
+
+  constexpr memory_resource& operator=(const memory_resource&) = default;
+
+  [[nodiscard]] void* allocate(std::size_t bytes,
+                               std::size_t alignment = max_align)
+  {
+    return do_allocate(bytes, alignment);
+  }
+
+  void deallocate(void* p, std::size_t bytes, std::size_t alignment = max_align)
+  {
+    do_deallocate(p, bytes, alignment);
+  }
+
+  constexpr bool is_equal(const memory_resource& other) const noexcept
+  {
+    return do_is_equal(other);
+  }
+
+  constexpr virtual arena* typed_arena() noexcept { return nullptr; }
+
+private:
+  virtual void* do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+  virtual void do_deallocate(void* p, std::size_t bytes,
+                             std::size_t alignment) = 0;
+  constexpr virtual bool do_is_equal(const memory_resource& other)
+    const noexcept = 0;
+};
+
+constexpr bool operator==(const memory_resource& a,
+                          const memory_resource& b) noexcept
+{
+  return &a == &b || a.is_equal(b);
+}
+
+namespace impl {
+
+class new_delete_resource_t final : public memory_resource
+{
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    return ::operator new(bytes, std::align_val_t{alignment});
+  }
+  void do_deallocate(void* p, std::size_t bytes,
+                     std::size_t alignment) override {
+    ::operator delete(p, bytes, std::align_val_t{alignment});
+  }
+  constexpr bool do_is_equal(const memory_resource& other)
+    const noexcept override { return this == &other; }
+};
+
+class null_memory_resource_t final : public memory_resource
+{
+  void* do_allocate(std::size_t, std::size_t) override {
+    throw std::bad_alloc();
+  }
+  void do_deallocate(void*, std::size_t, std::size_t) override {}
+  constexpr bool do_is_equal(const memory_resource& other)
+    const noexcept override { return this == &other; }
+};
+
+inline std::atomic<memory_resource*>& default_resource() noexcept;
+
+} // namespace impl
+
+inline memory_resource* new_delete_resource() noexcept
+{
+  static impl::new_delete_resource_t r;
+  return &r;
+}
+
+inline memory_resource* null_memory_resource() noexcept
+{
+  static impl::null_memory_resource_t r;
+  return &r;
+}
+
+inline std::atomic<memory_resource*>& impl::default_resource() noexcept
+{
+  static std::atomic<memory_resource*> r{new_delete_resource()};
+  return r;
+}
+
+inline memory_resource* get_default_resource() noexcept
+{
+  return impl::default_resource().load();
+}
+
+inline memory_resource* set_default_resource(memory_resource* r) noexcept
+{
+  return impl::default_resource().exchange(r ? r : new_delete_resource());
+}
+
+// As std::pmr::polymorphic_allocator. A default constructed allocator holds
+// the default resource of the time of its construction; but in a constant
+// expression, a null resource, with which std::allocator is used. (Should
+// such an allocator be used at runtime, the current default resource is.)
+// Unlike std's, it is assignable; as the cest containers swap their
+// allocators.
+template <typename T = std::byte>
+class polymorphic_allocator
+{
+public:
+  using value_type = T;
+
+  constexpr polymorphic_allocator() noexcept
+    : m_r(std::is_constant_evaluated() ? nullptr : get_default_resource()) {}
+  constexpr polymorphic_allocator(memory_resource* r) noexcept : m_r(r) {}
+
+  template <typename U>
+  constexpr polymorphic_allocator(const polymorphic_allocator<U>& other)
+    noexcept : m_r(other.m_r) {}
+
+  [[nodiscard]] constexpr T* allocate(std::size_t n)
+  {
+    if (std::is_constant_evaluated()) {
+      if (arena* a = m_r ? m_r->typed_arena() : nullptr)
+        return a->allocate<T>(n);
+      return std::allocator<T>{}.allocate(n);
+    }
+    return static_cast<T*>(resource()->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  constexpr void deallocate(T* p, std::size_t n)
+  {
+    if (std::is_constant_evaluated()) {
+      if (!(m_r && m_r->typed_arena()))
+        std::allocator<T>{}.deallocate(p, n);
+      return;
+    }
+    resource()->deallocate(p, n * sizeof(T), alignof(T));
+  }
+
+  constexpr memory_resource* resource() const noexcept
+  {
+    if (m_r || std::is_constant_evaluated())
+      return m_r;
+    return get_default_resource();
+  }
+
+  // As std's, a copy of a container uses the default resource
+  constexpr polymorphic_allocator select_on_container_copy_construction() const
+  {
+    return polymorphic_allocator();
+  }
+
+  template <typename U>
+  friend constexpr bool operator==(const polymorphic_allocator& a,
+                                   const polymorphic_allocator<U>& b) noexcept
+  {
+    memory_resource* ra = a.resource();
+    memory_resource* rb = b.resource();
+    return ra == rb || (ra && rb && *ra == *rb);
+  }
+
+private:
+  template <typename> friend class polymorphic_allocator;
+
+  memory_resource* m_r = nullptr;
+};
+
+struct pool_options
+{
+  std::size_t max_blocks_per_chunk        = 1024;
+  std::size_t largest_required_pool_block = 4096;
+};
+
+// As std::pmr::monotonic_buffer_resource; built upon a cest::arena, which is
+// also used by a polymorphic_allocator in a constant expression. The upstream
+// resource of std's is not supported: blocks come from ::operator new.
+class monotonic_buffer_resource : public memory_resource
+{
+public:
+  constexpr monotonic_buffer_resource() = default;
+  explicit constexpr monotonic_buffer_resource(std::size_t initial_size)
+    : m_arena(initial_size) {}
+
+  // GCC rejects an implicit virtual destructor in a constant expression
+  constexpr ~monotonic_buffer_resource() override {}
+
+  monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+  monotonic_buffer_resource&
+  operator=(const monotonic_buffer_resource&) = delete;
+
+  constexpr void release() noexcept { m_arena.release(); }
+
+  constexpr arena* typed_arena() noexcept override { return &m_arena; }
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    return m_arena.allocate_bytes(bytes, alignment);
+  }
+  void do_deallocate(void*, std::size_t, std::size_t) override {}
+  constexpr bool do_is_equal(const memory_resource& other)
+    const noexcept override { return this == &other; }
+
+  arena m_arena;
+};
+
+// As std::pmr::unsynchronized_pool_resource. Requests are rounded up to a
+// power of two, and each size has a pool: a free list threaded through its
+// unused blocks, which are carved from chunks obtained from the upstream
+// resource. Each chunk of a pool has twice the blocks of the last; up to
+// max_blocks_per_chunk. Larger requests go directly upstream.
+class unsynchronized_pool_resource : public memory_resource
+{
+  static constexpr std::size_t min_block = sizeof(void*);
+
+public:
+  unsynchronized_pool_resource()
+    : unsynchronized_pool_resource(pool_options{}, get_default_resource()) {}
+
+  explicit unsynchronized_pool_resource(memory_resource* upstream)
+    : unsynchronized_pool_resource(pool_options{}, upstream) {}
+
+  explicit unsynchronized_pool_resource(const pool_options& opts)
+    : unsynchronized_pool_resource(opts, get_default_resource()) {}
+
+  unsynchronized_pool_resource(const pool_options& opts,
+                               memory_resource* upstream)
+    : m_upstream(upstream), m_opts(opts)
+  {
+    if (m_opts.max_blocks_per_chunk < 1)
+      m_opts.max_blocks_per_chunk = 1;
+    std::size_t size = min_block;
+    while (size < m_opts.largest_required_pool_block)
+      size *= 2;
+    m_opts.largest_required_pool_block = size;
+    for (std::size_t s = min_block; s <= size; s *= 2)
+      m_pools.push_back({s});
+  }
+
+  unsynchronized_pool_resource(const unsynchronized_pool_resource&) = delete;
+  unsynchronized_pool_resource&
+  operator=(const unsynchronized_pool_resource&) = delete;
+
+  ~unsynchronized_pool_resource() { release(); }
+
+  // Returns all memory to the upstream resource
+  void release()
+  {
+    for (auto& c : m_chunks)
+      m_upstream->deallocate(c.p, c.bytes, c.align);
+    m_chunks.clear();
+    for (auto& pool : m_pools) {
+      pool.free       = nullptr;
+      pool.chunk_size = 1;
+    }
+  }
+
+  memory_resource* upstream_resource() const noexcept { return m_upstream; }
+  pool_options options() const noexcept { return m_opts; }
+
+private:
+
+  struct free_block { free_block* next; };
+
+  struct pool
+  {
+    std::size_t block;
+    free_block* free       = nullptr;
+    std::size_t chunk_size = 1;       // in blocks; of the next chunk
+  };
+
+  struct chunk
+  {
+    void*       p;
+    std::size_t bytes;
+    std::size_t align;
+  };
+
+  // null if the request is too large for the pools
+  pool* pool_for(std::size_t bytes, std::size_t alignment) noexcept
+  {
+    const std::size_t size = bytes > alignment ? bytes : alignment;
+    std::size_t i = 0;
+    for (std::size_t s = min_block; s < size; s *= 2)
+      ++i;
+    return i < m_pools.size() ? &m_pools[i] : nullptr;
+  }
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    pool* p = pool_for(bytes, alignment);
+    if (!p) {
+      void* q = m_upstream->allocate(bytes, alignment);
+      m_chunks.push_back({q, bytes, alignment});
+      return q;
+    }
+    if (!p->free) {
+      const std::size_t n = p->chunk_size;
+      const std::size_t align = p->block < alignof(std::max_align_t) ?
+                                alignof(std::max_align_t) : p->block;
+      auto* c = static_cast<std::byte*>(m_upstream->allocate(n * p->block,
+                                                             align));
+      m_chunks.push_back({c, n * p->block, align});
+      for (std::size_t i = n; i-- > 0; )
+        p->free = ::new (c + i * p->block) free_block{p->free};
+      if (2 * n <= m_opts.max_blocks_per_chunk)
+        p->chunk_size = 2 * n;
+    }
+    free_block* b = p->free;
+    p->free = b->next;
+    return b;
+  }
+
+  void do_deallocate(void* q, std::size_t bytes, std::size_t alignment)
+    override
+  {
+    pool* p = pool_for(bytes, alignment);
+    if (!p) {
+      for (std::size_t i = m_chunks.size(); i-- > 0; ) {
+        if (m_chunks[i].p == q) {
+          m_chunks[i] = m_chunks.back();
+          m_chunks.pop_back();
+          break;
+        }
+      }
+      m_upstream->deallocate(q, bytes, alignment);
+      return;
+    }
+    p->free = ::new (q) free_block{p->free};
+  }
+
+  constexpr bool do_is_equal(const memory_resource& other)
+    const noexcept override { return this == &other; }
+
+  memory_resource* m_upstream;
+  pool_options     m_opts;
+  vector<pool>     m_pools;
+  vector<chunk>    m_chunks;  // pool chunks; and the larger requests
+};
+
+// As std::pmr::synchronized_pool_resource: an unsynchronized_pool_resource,
+// guarded by a mutex. Usable from several threads; at runtime only.
+class synchronized_pool_resource : public memory_resource
+{
+public:
+  synchronized_pool_resource() = default;
+
+  explicit synchronized_pool_resource(memory_resource* upstream)
+    : m_pool(upstream) {}
+
+  explicit synchronized_pool_resource(const pool_options& opts)
+    : m_pool(opts) {}
+
+  synchronized_pool_resource(const pool_options& opts,
+                             memory_resource* upstream)
+    : m_pool(opts, upstream) {}
+
+  void release()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pool.release();
+  }
+
+  memory_resource* upstream_resource() const noexcept {
+    return m_pool.upstream_resource();
+  }
+  pool_options options() const noexcept { return m_pool.options(); }
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pool.allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+    override
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pool.deallocate(p, bytes, alignment);
+  }
+
+  constexpr bool do_is_equal(const memory_resource& other)
+    const noexcept override { return this == &other; }
+
+  std::mutex                   m_mutex;
+  unsynchronized_pool_resource m_pool;
+};
+
+} // namespace cest::pmr
+
+#endif // _CEST_MEMORY_RESOURCE_HPP_
@@ -0,0 +1,148 @@
+#ifndef _CEST_MMAPBUF_HPP_
+#define _CEST_MMAPBUF_HPP_
+
+// A read-only streambuf whose get area is the whole of a memory-mapped file;
+// so reads, via sgetn or an istream, are from the mapped pages directly. No
+// file can be opened within a constant expression.
+
+#include "ios_base.hpp"
+#include "streambuf.hpp"
+#include <span>
+#include <string>       // std::char_traits
+#include <cstddef>      // std::size_t
+#include <type_traits>  // std::is_constant_evaluated
+#include <fcntl.h>      // ::open
+#include <sys/mman.h>   // ::mmap, ::madvise, ::munmap
+#include <sys/stat.h>   // ::fstat
+#include <unistd.h>     // ::close
+
+namespace cest {
+
+namespace impl {
+
+// A read-only mapping of the whole of a file; at runtime only. The kernel is
+// advised that it will be read sequentially, so pages are read ahead and may
+// be dropped soon after.
+class __file_map
+{
+public:
+  bool open(const char* __name)
+  {
+    int __fd = ::open(__name, O_RDONLY);
+    if (__fd == -1)
+      return false;
+
+    struct stat __st;
+    bool __ok = ::fstat(__fd, &__st) == 0 && S_ISREG(__st.st_mode);
+    if (__ok && __st.st_size > 0)  // an empty file can't be mapped
+    {
+      void* __p = ::mmap(nullptr, __st.st_size, PROT_READ, MAP_PRIVATE, __fd,
+                         0);
+      __ok = __p != MAP_FAILED;
+      if (__ok)
+      {
+        ::madvise(__p, __st.st_size, MADV_SEQUENTIAL); // only a hint
+        _M_data = static_cast<const char*>(__p);
+        _M_size = __st.st_size;
+      }
+    }
+    ::close(__fd);  // the mapping remains valid
+    return __ok;
+  }
+
+  void close()
+  {
+    if (_M_data)
+      ::munmap(const_cast<char*>(_M_data), _M_size);
+    _M_data = nullptr;
+    _M_size = 0;
+  }
+
+  const char* data() const { return _M_data; }
+  std::size_t size() const { return _M_size; }
+
+private:
+  const char* _M_data = nullptr;
+  std::size_t _M_size = 0;
+};
+
+} // namespace impl
+
+template<
+  class _CharT,
+  class _Traits = std::char_traits<_CharT>
+> class basic_mmapbuf : public basic_streambuf<_CharT, _Traits>
+{
+public:
+
+  typedef _CharT  char_type;
+  typedef _Traits traits_type;
+
+  typedef typename traits_type::int_type    int_type;
+  typedef typename traits_type::pos_type    pos_type;
+  typedef typename traits_type::off_type    off_type;
+
+  typedef basic_streambuf<char_type, traits_type>   __streambuf_type;
+  typedef basic_mmapbuf<char_type, traits_type>     __mmapbuf_type;
+
+protected:
+
+  bool              _M_open;
+  impl::__file_map  _M_map;
+
+public:
+
+  constexpr basic_mmapbuf() : __streambuf_type(), _M_open(false), _M_map() { }
+
+  constexpr explicit
+  basic_mmapbuf(const char* __s)
+  : __streambuf_type(), _M_open(false), _M_map()
+  { this->open(__s); }
+
+  basic_mmapbuf(const basic_mmapbuf&) = delete;
+  basic_mmapbuf& operator=(const basic_mmapbuf&) = delete;
+
+  constexpr ~basic_mmapbuf() { this->close(); }
+
+  constexpr bool is_open() const { return _M_open; }
+
+  constexpr __mmapbuf_type* open(const char* __s)
+  {
+    if (_M_open || std::is_constant_evaluated() || !_M_map.open(__s))
+      return 0;
+
+    // The get area is never written to: putback only moves gptr() back
+    char_type* __p = reinterpret_cast<char_type*>(
+                       const_cast<char*>(_M_map.data()));
+    this->setg(__p, __p, __p + _M_map.size() / sizeof(char_type));
+    _M_open = true;
+    return this;
+  }
+
+  constexpr __mmapbuf_type* close()
+  {
+    if (!_M_open)
+      return 0;
+    if (!std::is_constant_evaluated())
+      _M_map.close();
+    this->setg(0, 0, 0);
+    _M_open = false;
+    return this;
+  }
+
+  // The whole file; however much of it has been read
+  constexpr std::span<const char_type> span() const
+  { return std::span<const char_type>(this->eback(), this->egptr()); }
+
+protected:
+  // At the end of the get area, there is nothing more to come
+  constexpr streamsize showmanyc() override
+  { return _M_open ? -1 : 0; }
+};
+
+using mmapbuf = basic_mmapbuf<char>;
+using wmmapbuf = basic_mmapbuf<wchar_t>;
+
+} // namespace cest
+
+#endif // _CEST_MMAPBUF_HPP_
@@ -3,15 +3,67 @@
 
 #include "ios.hpp"             // cest::basic_ios
 #include "streambuf.hpp"       // cest::basic_streambuf
-#include "runtime_ostream.hpp" // cest::runtime_ostream 
+#include "bits/to_chars.hpp"   // cest::impl::__uint_to_chars, __fp_formatter,
+                               // __put_iterator
 #include <string>              // std::char_traits
-#include <iostream>            // std::cout, std::cerr, std::clog
-#include <locale>              // std::ctype, std::num_put
-#include <iterator>            // std::ostreambuf_iterator
-#include <exception>           // std::uncaught_exception
+#include <type_traits>         // std::is_same_v, std::make_unsigned_t
+#include <exception>           // std::uncaught_exceptions
 
 namespace cest {
 
+namespace impl {
+
+// Writes __v backwards, ending at __end, as num_put would given __flags; and
+// returns a pointer to the first character. As with num_put, only a decimal
+// value is written with a sign; and only a non-zero value with a base.
+template <typename _CharT, typename _ValueT>
+constexpr _CharT*
+__int_to_chars(_CharT* __end, _ValueT __v, ios_base::fmtflags __flags)
+{
+  using _UValueT = std::make_unsigned_t<_ValueT>;
+  const ios_base::fmtflags __basefield = __flags & ios_base::basefield;
+  const unsigned __base = __basefield == ios_base::oct ? 8
+                        : __basefield == ios_base::hex ? 16 : 10;
+  const bool __upper = bool(__flags & ios_base::uppercase);
+  bool __neg = false;
+  _UValueT __u = __v;
+  if constexpr (std::is_signed_v<_ValueT>)
+    if (__base == 10 && __v < 0) {
+      __neg = true;
+      __u = _UValueT(0) - __u;
+    }
+  _CharT* __first = __uint_to_chars(__end, __u, __base, __upper);
+  if (__base == 10) {
+    if (__neg)
+      *--__first = _CharT('-');
+    else if (std::is_signed_v<_ValueT> && bool(__flags & ios_base::showpos))
+      *--__first = _CharT('+');
+  }
+  else if (bool(__flags & ios_base::showbase) && __v != 0) {
+    if (__base == 16)
+      *--__first = _CharT(__upper ? 'X' : 'x');
+    *--__first = _CharT('0');
+  }
+  return __first;
+}
+
+// The number of leading characters of a formatted number, __s, which precede
+// any padding added by ios_base::internal: a sign, then any 0x or 0X
+template <typename _CharT>
+constexpr streamsize
+__internal_split(const _CharT* __s, streamsize __n)
+{
+  streamsize __i = 0;
+  if (__i < __n && (__s[__i] == _CharT('-') || __s[__i] == _CharT('+')))
+    ++__i;
+  if (__i + 1 < __n && __s[__i] == _CharT('0') &&
+      (__s[__i + 1] == _CharT('x') || __s[__i + 1] == _CharT('X')))
+    __i += 2;
+  return __i;
+}
+
+} // namespace impl
+
 template <class _CharT, class _Traits>
   class basic_ostream : /*virtual*/ public basic_ios<_CharT, _Traits>
 {
@@ -25,8 +77,6 @@ public:
   typedef basic_streambuf<_CharT, _Traits>    __streambuf_type;
   typedef basic_ios<_CharT, _Traits>    __ios_type;
   typedef basic_ostream<_CharT, _Traits>    __ostream_type;
-  typedef std::num_put<_CharT, std::ostreambuf_iterator<_CharT, _Traits> >
-          __num_put_type;
   typedef std::ctype<_CharT>             __ctype_type;
 
   explicit constexpr
@@ -47,14 +97,16 @@ public:
 
   constexpr __ostream_type&
   operator<<(__ios_type&     (*__pf)(__ios_type&))     {
-    __pf(*this);
+    if (!_M_discard())
+      __pf(*this);
     return *this;
   }
 
   // for hex
   constexpr __ostream_type&
   operator<<(ios_base&       (*__pf)(ios_base&))       {
-    __pf(*this);
+    if (!_M_discard())
+      __pf(*this);
     return *this;
   }
 
@@ -62,18 +114,183 @@ public:
   operator<<(long __n)
   { return _M_insert(__n); }
 
-  constexpr __ostream_type& operator<<(int value)                             {
-    impl::runtime_ostream(*this, value);
-    return *this;
+  constexpr __ostream_type&
+  operator<<(unsigned long long __n)
+  { return _M_insert(__n); }
+
+  constexpr __ostream_type&
+  operator<<(long long __n)
+  { return _M_insert(__n); }
+
+  constexpr __ostream_type&
+  operator<<(bool __n);
+
+  constexpr __ostream_type&
+  operator<<(short __n)
+  {
+    if (_M_discard())
+      return *this;
+    // As libstdc++: a short is written in hex or oct as an unsigned short
+    const ios_base::fmtflags __fmt = this->flags() & ios_base::basefield;
+    if (__fmt == ios_base::oct || __fmt == ios_base::hex)
+      return _M_insert(static_cast<long>(static_cast<unsigned short>(__n)));
+    else
+      return _M_insert(static_cast<long>(__n));
   }
 
-  constexpr __ostream_type& operator<<(unsigned int value)                    {
-    impl::runtime_ostream(*this, value);
-    return *this;
+  constexpr __ostream_type&
+  operator<<(unsigned short __n)
+  { return _M_insert(static_cast<unsigned long>(__n)); }
+
+  constexpr __ostream_type&
+  operator<<(unsigned long __n)
+  { return _M_insert(__n); }
+
+  constexpr __ostream_type&
+  operator<<(int __n)
+  {
+    if (_M_discard())
+      return *this;
+    // As libstdc++: an int is written in hex or oct as an unsigned int
+    const ios_base::fmtflags __fmt = this->flags() & ios_base::basefield;
+    if (__fmt == ios_base::oct || __fmt == ios_base::hex)
+      return _M_insert(static_cast<long>(static_cast<unsigned int>(__n)));
+    else
+      return _M_insert(static_cast<long>(__n));
   }
 
+  constexpr __ostream_type&
+  operator<<(unsigned int __n)
+  { return _M_insert(static_cast<unsigned long>(__n)); }
+
+  constexpr __ostream_type&
+  operator<<(double __f)
+  { return _M_insert_float(__f); }
+
+  constexpr __ostream_type&
+  operator<<(float __f)
+  { return _M_insert_float(static_cast<double>(__f)); }
+
+  // There is no long double formatter; so the value is rounded to a double
+  constexpr __ostream_type&
+  operator<<(long double __f)
+  { return _M_insert_float(static_cast<double>(__f)); }
+
+  constexpr __ostream_type&
+  put(char_type __c);
+
+  constexpr __ostream_type&
+  write(const char_type* __s, streamsize __n);
+
   constexpr __ostream_type& flush();
 
+  // Writes __n characters to the streambuf; setting badbit on a short write
+  constexpr void
+  _M_write(const char_type* __s, streamsize __n)
+  {
+    const streamsize __put = this->rdbuf()->sputn(__s, __n);
+    if (__put != __n)
+      this->setstate(ios_base::badbit);
+  }
+
+  // As _M_write; but first padding __s to width() with fill() characters,
+  // which, if adjustfield is internal, follow the first __split characters.
+  // As with libstdc++'s __pad, width() is then reset to 0.
+  constexpr void
+  _M_write_padded(const char_type* __s, streamsize __n, streamsize __split)
+  {
+    const streamsize __w = this->width();
+    this->width(0);
+    if (__w <= __n)
+      return _M_write(__s, __n);
+
+    const ios_base::fmtflags __adjust = this->flags() & ios_base::adjustfield;
+    if (__adjust == ios_base::left)
+      __split = __n;
+    else if (__adjust != ios_base::internal)
+      __split = 0;
+    _M_write(__s, __split);
+    _M_pad(__w - __n);
+    if (this->good())
+      _M_write(__s + __split, __n - __split);
+  }
+
+  // Writes __count fill() characters; while good()
+  constexpr void
+  _M_pad(streamsize __count)
+  {
+    const char_type __c = this->fill();
+    for (streamsize __i = 0; __i < __count && this->good(); ++__i)
+      if (traits_type::eq_int_type(this->rdbuf()->sputc(__c), traits_type::eof()))
+        this->setstate(ios_base::badbit);
+  }
+
+  // As above, the characters of __fmt; which, however many there are, are
+  // written through a buffer on the stack of 64 characters.
+  constexpr void
+  _M_write_padded(const impl::__fp_formatter& __fmt)
+  {
+    const streamsize __n = static_cast<streamsize>(__fmt.size());
+    const streamsize __w = this->width();
+    this->width(0);
+    streamsize __split = -1;  // the fill characters follow this many
+    if (__w > __n)
+    {
+      const ios_base::fmtflags __adjust = this->flags() & ios_base::adjustfield;
+      __split = __adjust == ios_base::left ? __n
+              : __adjust == ios_base::internal
+              ? static_cast<streamsize>(__fmt.prefix_size()) : 0;
+    }
+
+    struct _Chunks
+    {
+      constexpr void _M_flush()
+      {
+        if (_M_os->good())
+          _M_os->_M_write(_M_buf, _M_len);
+        _M_len = 0;
+      }
+      constexpr void _M_put(char_type __c)
+      {
+        if (_M_pos++ == _M_split)
+        {
+          _M_flush();
+          _M_os->_M_pad(_M_fill_n);
+        }
+        if (_M_len == 64)
+          _M_flush();
+        _M_buf[_M_len++] = __c;
+      }
+
+      __ostream_type* _M_os;
+      streamsize _M_split, _M_fill_n;
+      streamsize _M_pos = 0;
+      int _M_len = 0;
+      char_type _M_buf[64]{};
+    } __chunks{this, __split, __w - __n};
+
+    __fmt.write(impl::__put_iterator<_Chunks, char_type>{&__chunks});
+    __chunks._M_flush();
+    if (__split == __n)  // left adjusted
+      _M_pad(__w - __n);
+  }
+
+  // A constant expression can't modify cest::cout, cerr or clog; which are
+  // defined outside of it. Output to them is then discarded; as before the
+  // stream's state is examined. Such a stream is recognised as one whose
+  // members can't be read during the evaluation; so neither the standard
+  // streams, nor iostream.hpp, need be visible here. At runtime this is
+  // false and costs nothing.
+  constexpr bool
+  _M_discard() const
+  {
+    if constexpr (std::is_same_v<__ostream_type, basic_ostream<char>>)
+      return std::is_constant_evaluated() &&
+             !__builtin_constant_p(this->_M_streambuf_state);
+    else
+      return false;
+  }
+
   protected:
   constexpr basic_ostream()
   { this->init(0); }
@@ -81,64 +298,189 @@ public:
   template<typename _ValueT>
   constexpr __ostream_type&
   _M_insert(_ValueT __v);
+
+  constexpr __ostream_type&
+  _M_insert_float(double __v);
 };
 
 using  ostream = basic_ostream<char>;
 using wostream = basic_ostream<wchar_t>;
 
+  template <typename _CharT, typename _Traits>
+    class basic_ostream<_CharT, _Traits>::sentry
+    {
+      // Data Members.
+      bool        _M_ok;
+      basic_ostream<_CharT, _Traits>&   _M_os;
+
+    public:
+      // from ostream.tcc
+      explicit constexpr
+      sentry(basic_ostream<_CharT, _Traits>& __os)
+      : _M_ok(false), _M_os(__os)
+      {
+  // XXX MT
+  if (__os.tie() && __os.good())
+    __os.tie()->flush();
+
+  if (__os.good())
+    _M_ok = true;
+  else if (__os.bad())
+    __os.setstate(ios_base::failbit);
+      }
+
+      constexpr
+      ~sentry()
+      {
+  // XXX MT
+  if (bool(_M_os.flags() & ios_base::unitbuf) &&
+      (std::is_constant_evaluated() || !std::uncaught_exceptions()))
+    {
+      // Can't call flush directly or else will get into recursive lock.
+      if (_M_os.rdbuf() && _M_os.rdbuf()->pubsync() == -1)
+        _M_os.setstate(ios_base::badbit);
+    }
+      }
+
+      explicit constexpr
+      operator bool() const
+      { return _M_ok; }
+    };
+
+  // from ostream_insert.h
+  template<typename _CharT, typename _Traits>
+    constexpr basic_ostream<_CharT, _Traits>&
+    __ostream_insert(basic_ostream<_CharT, _Traits>& __out,
+         const _CharT* __s, streamsize __n, streamsize __split = 0)
+    {
+      typedef basic_ostream<_CharT, _Traits>       __ostream_type;
+
+      if (__out._M_discard())
+  return __out;
+
+      typename __ostream_type::sentry __cerb(__out);
+      if (__cerb)
+  {
+    __try
+      {
+        __out._M_write_padded(__s, __n, __split);
+      }
+#if !defined(_LIBCPP_VERSION) // __forced_unwind is a libstdc++/gcc thing
+    __catch(__cxxabiv1::__forced_unwind&)
+      {
+        __out._M_setstate(ios_base::badbit);
+        __throw_exception_again;
+      }
+#endif
+    __catch(...)
+      { __out._M_setstate(ios_base::badbit); }
+  }
+      return __out;
+    }
+
 template< class CharT, class Traits>
 constexpr basic_ostream<CharT,Traits>&
 operator<<(basic_ostream<CharT,Traits>& os, CharT ch)
 {
-  impl::runtime_ostream(os, ch);
-  return os;
+  return __ostream_insert(os, &ch, 1);
 }
 
 template <class CharT, class Traits>
 constexpr basic_ostream<CharT,Traits>&
 operator<<(basic_ostream<CharT,Traits>& os, const CharT* s)
 {
-  impl::runtime_ostream(os, s);
+  if (!s)
+    os.setstate(ios_base::badbit);
+  else
+    __ostream_insert(os, s, static_cast<streamsize>(Traits::length(s)));
   return os;
 }
 
+template <class CharT, class Traits >
+constexpr basic_ostream<CharT,Traits> &
+flush(basic_ostream<CharT, Traits> &os)
+{
+  return os.flush();
+}
+
 template <class CharT, class Traits >
 constexpr basic_ostream<CharT,Traits> &
 endl(basic_ostream<CharT, Traits> &os)
 {
-  impl::runtime_ostream(os, std::endl);
-  return os;
+  return flush(os.put(CharT('\n')));
 }
 
-  template <typename _CharT, typename _Traits>
-    class basic_ostream<_CharT, _Traits>::sentry
+  // from ostream.tcc
+  template<typename _CharT, typename _Traits>
+    constexpr basic_ostream<_CharT, _Traits>&
+    basic_ostream<_CharT, _Traits>::
+    put(char_type __c)
     {
-      // Data Members.
-      bool        _M_ok;
-      basic_ostream<_CharT, _Traits>&   _M_os;
+      // _GLIBCXX_RESOLVE_LIB_DEFECTS
+      // DR 60. What is a formatted input function?
+      // basic_ostream::put(char_type) is an unformatted output function.
+      // DR 63. Exception-handling policy for unformatted output.
+      // Unformatted output functions should catch exceptions thrown
+      // from streambuf members.
+      if (_M_discard())
+  return *this;
+      sentry __cerb(*this);
+      if (__cerb)
+  {
+    ios_base::iostate __err = ios_base::goodbit;
+    __try
+      {
+        const int_type __put = this->rdbuf()->sputc(__c);
+        if (traits_type::eq_int_type(__put, traits_type::eof()))
+    __err |= ios_base::badbit;
+      }
+#if !defined(_LIBCPP_VERSION) // __forced_unwind is a libstdc++/gcc thing
+    __catch(__cxxabiv1::__forced_unwind&)
+      {
+        this->_M_setstate(ios_base::badbit);
+        __throw_exception_again;
+      }
+#endif
+    __catch(...)
+      { this->_M_setstate(ios_base::badbit); }
+    if (__err)
+      this->setstate(__err);
+  }
+      return *this;
+    }
 
-    public:
-      explicit                                          
-      sentry(basic_ostream<_CharT, _Traits>& __os);
-                                                                          
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-      ~sentry()
-      {                                                       
-  // XXX MT                                                                
-  if (bool(_M_os.flags() & ios_base::unitbuf) && !std::uncaught_exception())
-    {   
-      // Can't call flush directly or else will get into recursive lock.
-      if (_M_os.rdbuf() && _M_os.rdbuf()->pubsync() == -1)
-        _M_os.setstate(ios_base::badbit);
-    }                                                                  
+  // from ostream.tcc
+  template<typename _CharT, typename _Traits>
+    constexpr basic_ostream<_CharT, _Traits>&
+    basic_ostream<_CharT, _Traits>::
+    write(const _CharT* __s, streamsize __n)
+    {
+      // _GLIBCXX_RESOLVE_LIB_DEFECTS
+      // DR 60. What is a formatted input function?
+      // basic_ostream::write(const char_type*, streamsize) is an
+      // unformatted output function.
+      // DR 63. Exception-handling policy for unformatted output.
+      // Unformatted output functions should catch exceptions thrown
+      // from streambuf members.
+      if (_M_discard())
+  return *this;
+      sentry __cerb(*this);
+      if (__cerb)
+  {
+    __try
+      { _M_write(__s, __n); }
+#if !defined(_LIBCPP_VERSION) // __forced_unwind is a libstdc++/gcc thing
+    __catch(__cxxabiv1::__forced_unwind&)
+      {
+        this->_M_setstate(ios_base::badbit);
+        __throw_exception_again;
       }
-#pragma GCC diagnostic pop
-                                                          
-      explicit
-      operator bool() const                                       
-      { return _M_ok; }
-    };
+#endif
+    __catch(...)
+      { this->_M_setstate(ios_base::badbit); }
+  }
+      return *this;
+    }
 
   // from ostream.tcc
   template<typename _CharT, typename _Traits>
@@ -149,6 +491,8 @@ endl(basic_ostream<CharT, Traits> &os)
       // _GLIBCXX_RESOLVE_LIB_DEFECTS
       // DR 60. What is a formatted input function?
       // basic_ostream::flush() is *not* an unformatted output function.
+      if (_M_discard())
+  return *this;
       ios_base::iostate __err = ios_base::goodbit;
       __try
   {
@@ -169,37 +513,92 @@ endl(basic_ostream<CharT, Traits> &os)
       return *this;
     }
 
-  // from ostream.tcc
+  // Unlike ostream.tcc, the digits are formatted here without a locale; and
+  // then written to the streambuf with a single call.
   template<typename _CharT, typename _Traits>
     template<typename _ValueT>
       constexpr basic_ostream<_CharT, _Traits>&
       basic_ostream<_CharT, _Traits>::
       _M_insert(_ValueT __v)
       {
-  sentry __cerb(*this);
-  if (__cerb)
+  if (_M_discard())
+    return *this;
+  // Enough for the octal digits of any _ValueT, and a sign or a base
+  _CharT __buf[3 * sizeof(_ValueT) + 2];
+  _CharT* const __end = __buf + sizeof(__buf) / sizeof(_CharT);
+  const _CharT* __first = impl::__int_to_chars(__end, __v, this->flags());
+  const streamsize __n = __end - __first;
+  return __ostream_insert(*this, __first, __n,
+                          impl::__internal_split(__first, __n));
+      }
+
+  // As num_put, boolalpha selects "true" and "false"; without a locale
+  template<typename _CharT, typename _Traits>
+    constexpr basic_ostream<_CharT, _Traits>&
+    basic_ostream<_CharT, _Traits>::
+    operator<<(bool __n)
     {
-      ios_base::iostate __err = ios_base::goodbit;
-      __try
-        {
-    const __num_put_type& __np = __check_facet(this->_M_num_put);
-    if (__np.put(*this, *this, this->fill(), __v).failed())
-      __err |= ios_base::badbit;
-        }
-#if !defined(_LIBCPP_VERSION) // __forced_unwind is a libstdc++/gcc thing
-      __catch(__cxxabiv1::__forced_unwind&)
-        {
-    this->_M_setstate(ios_base::badbit);
-    __throw_exception_again;
-        }
-#endif
-      __catch(...)
-        { this->_M_setstate(ios_base::badbit); }
-      if (__err)
-        this->setstate(__err);
+      if (_M_discard())
+  return *this;
+      if (!(this->flags() & ios_base::boolalpha))
+  return _M_insert(static_cast<long>(__n));
+      const char* __name = __n ? "true" : "false";
+      _CharT __buf[5];
+      streamsize __len = 0;
+      for (; __name[__len]; ++__len)
+  __buf[__len] = _CharT(__name[__len]);
+      return __ostream_insert(*this, __buf, __len);
     }
+
+  // The floatfield flags select printf's %f, %e, %a or (if neither is set)
+  // %g; and showpoint, showpos and uppercase its #, + and upper case forms.
+  // As a cest extension, a negative precision() selects the shortest digits
+  // which read back as __v, rather than %g's default of 6.
+  template<typename _CharT, typename _Traits>
+    constexpr basic_ostream<_CharT, _Traits>&
+    basic_ostream<_CharT, _Traits>::
+    _M_insert_float(double __v)
+    {
+      if (_M_discard())
   return *this;
+      const ios_base::fmtflags __flags = this->flags();
+      const ios_base::fmtflags __fltfield = __flags & ios_base::floatfield;
+      impl::__fp_spec __spec;
+      if (__fltfield == ios_base::fixed)
+  __spec._M_style = impl::__fp_style::fixed;
+      else if (__fltfield == ios_base::scientific)
+  __spec._M_style = impl::__fp_style::scientific;
+      else if (__fltfield == (ios_base::fixed | ios_base::scientific))
+  __spec._M_style = impl::__fp_style::hex;
+      // As C++11's num_put: hexfloat ignores the precision
+      constexpr streamsize __max_prec = __INT_MAX__ / 2;
+      if (__spec._M_style != impl::__fp_style::hex && this->precision() >= 0)
+  __spec._M_precision = static_cast<int>(this->precision() < __max_prec
+                                         ? this->precision() : __max_prec);
+      __spec._M_upper = bool(__flags & ios_base::uppercase);
+      __spec._M_alt = bool(__flags & ios_base::showpoint);
+      __spec._M_plus = (__flags & ios_base::showpos) ? '+' : 0;
+
+      const impl::__fp_formatter __fmt(__v, __spec);
+      sentry __cerb(*this);
+      if (__cerb)
+  {
+    __try
+      {
+        _M_write_padded(__fmt);
+      }
+#if !defined(_LIBCPP_VERSION) // __forced_unwind is a libstdc++/gcc thing
+    __catch(__cxxabiv1::__forced_unwind&)
+      {
+        this->_M_setstate(ios_base::badbit);
+        __throw_exception_again;
       }
+#endif
+    __catch(...)
+      { this->_M_setstate(ios_base::badbit); }
+  }
+      return *this;
+    }
 
 } // namespace cest
 
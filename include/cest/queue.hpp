@@ -2,7 +2,10 @@
 #define _CEST_QUEUE_HPP_
 
 #include "cest/deque.hpp"
-#include <utility> // std::move
+#include "cest/vector.hpp"
+#include <utility>    // std::move
+#include <functional> // std::less
+#include <cstddef>    // std::size_t
 
 namespace cest {
 
@@ -35,10 +38,180 @@ public:
   constexpr void push(T&& value)      { c.push_back(std::move(value)); }
   constexpr void pop()                { c.pop_front();                 }
 
+  template <class... Args>
+  constexpr decltype(auto) emplace(Args&&... args) {
+    return c.emplace_back(std::forward<Args>(args)...);
+  }
+
+protected:
+  container_type c;
+};
+
+namespace impl {
+
+// Heap algorithms for a d-ary heap; where the children of the element at index
+// i are at indices d*i+1 to d*i+d. A wider heap is shallower; so push is
+// cheaper, while pop compares more children per level. For d == 2, these order
+// elements as std::push_heap, std::pop_heap and std::make_heap do. Elements are
+// accessed through the container's operator[], rather than its iterators; as
+// those of cest::deque are not random access.
+template <std::size_t D, class Container, class Compare>
+constexpr void sift_up_d(Container& c, std::size_t i, Compare& comp)
+{
+  auto value = std::move(c[i]);
+  while (i > 0) {
+    std::size_t parent = (i - 1) / D;
+    if (!comp(c[parent], value))
+      break;
+    c[i] = std::move(c[parent]);
+    i = parent;
+  }
+  c[i] = std::move(value);
+}
+
+template <std::size_t D, class Container, class Compare>
+constexpr void sift_down_d(Container& c, std::size_t i, std::size_t n,
+                           Compare& comp)
+{
+  auto value = std::move(c[i]);
+  for (;;) {
+    std::size_t child = D * i + 1;
+    if (child >= n)
+      break;
+    const std::size_t last = child + D < n ? child + D : n;
+    std::size_t best = child;
+    for (++child; child < last; ++child)
+      if (comp(c[best], c[child]))
+        best = child;
+    if (!comp(value, c[best]))
+      break;
+    c[i] = std::move(c[best]);
+    i = best;
+  }
+  c[i] = std::move(value);
+}
+
+// the last element of c is added to the heap formed by the others
+template <std::size_t D, class Container, class Compare>
+constexpr void push_heap_d(Container& c, Compare& comp)
+{
+  if (c.size() > 1)
+    sift_up_d<D>(c, c.size() - 1, comp);
+}
+
+// the first (top) element of the heap is moved to the back of c
+template <std::size_t D, class Container, class Compare>
+constexpr void pop_heap_d(Container& c, Compare& comp)
+{
+  const std::size_t n = c.size();
+  if (n > 1) {
+    using std::swap;
+    swap(c[0], c[n - 1]);
+    sift_down_d<D>(c, 0, n - 1, comp);
+  }
+}
+
+// Floyd's bottom-up construction: O(n) rather than n pushes' O(n log n)
+template <std::size_t D, class Container, class Compare>
+constexpr void make_heap_d(Container& c, Compare& comp)
+{
+  const std::size_t n = c.size();
+  if (n < 2)
+    return;
+  for (std::size_t i = (n - 2) / D + 1; i-- > 0; )
+    sift_down_d<D>(c, i, n, comp);
+}
+
+} // namespace impl
+
+// Arity is the number of children of each node of the heap; 2 by default.
+template <
+  class T,
+  class Container = vector<T>,
+  class Compare = std::less<typename Container::value_type>,
+  std::size_t Arity = 2
+>
+class priority_queue {
+  static_assert(Arity >= 2, "priority_queue: the heap arity must be >= 2");
+
+public:
+
+  using container_type  = Container;
+  using value_compare   = Compare;
+  using value_type      = typename Container::value_type;
+  using size_type       = typename Container::size_type;
+  using reference       = typename Container::reference;
+  using const_reference = typename Container::const_reference;
+
+  constexpr priority_queue() : c(), comp() { }
+
+  explicit constexpr priority_queue(const Compare& compare)
+    : c(), comp(compare) { }
+
+  constexpr priority_queue(const Compare& compare, const Container& cont)
+    : c(cont), comp(compare) { make_heap(); }
+
+  constexpr priority_queue(const Compare& compare, Container&& cont)
+    : c(std::move(cont)), comp(compare) { make_heap(); }
+
+  template <class InputIt>
+  constexpr priority_queue(InputIt first, InputIt last,
+                           const Compare& compare = Compare())
+    : c(), comp(compare)
+  {
+    for (; first != last; ++first)
+      c.push_back(*first);
+    make_heap();
+  }
+
+  [[nodiscard]] constexpr bool      empty() const { return c.empty(); }
+                constexpr size_type  size() const { return c.size();  }
+
+  constexpr const_reference top() const { return c.front(); }
+
+  constexpr void push(const value_type& value)
+  {
+    c.push_back(value);
+    push_heap();
+  }
+
+  constexpr void push(value_type&& value)
+  {
+    c.push_back(std::move(value));
+    push_heap();
+  }
+
+  template <class... Args>
+  constexpr void emplace(Args&&... args)
+  {
+    c.emplace_back(std::forward<Args>(args)...);
+    push_heap();
+  }
+
+  constexpr void pop()
+  {
+    impl::pop_heap_d<Arity>(c, comp);
+    c.pop_back();
+  }
+
 protected:
   container_type c;
+  value_compare comp;
+
+private:
+  constexpr void push_heap() { impl::push_heap_d<Arity>(c, comp); }
+  constexpr void make_heap() { impl::make_heap_d<Arity>(c, comp); }
 };
 
+// A d-ary heap priority queue; e.g. d_ary_priority_queue<int, 4>
+template <
+  class T,
+  std::size_t Arity,
+  class Container = vector<T>,
+  class Compare = std::less<typename Container::value_type>
+>
+using d_ary_priority_queue = priority_queue<T, Container, Compare, Arity>;
+
 } // namespace cest
 
 #endif // _CEST_QUEUE_HPP_
@@ -2,6 +2,7 @@
 #define _CEST_SET_HPP_
 
 #include "swap.hpp"
+#include "instrument.hpp"
 #include <functional> // std::less
 #include <memory>
 
@@ -98,8 +99,12 @@ public:
   };
 
   constexpr set() : m_root{}, m_begin{}, m_size{} {}
+  explicit constexpr set(const Allocator& alloc)
+    : m_root{}, m_begin{}, m_size{}, m_alloc(alloc), m_node_alloc(alloc) {}
 
-  constexpr set(const set& other) : set()
+  constexpr set(const set& other)
+    : set(std::allocator_traits<Allocator>::
+            select_on_container_copy_construction(other.m_alloc))
   {
     for (auto it = other.begin(); it != other.end(); ++it)
       insert(*it);
@@ -115,6 +120,8 @@ public:
     return *this;
   }
 
+  constexpr allocator_type get_allocator() const noexcept { return m_alloc; }
+
 // This seems to exist in cppreference.com; but GCC doesn't have it, and
 // it results in the iterator's type failing std::weakly_incrementable etc.
 //  constexpr     iterator  begin()       noexcept { return {m_begin}; }
@@ -199,12 +206,14 @@ public:
   }
 
   constexpr void rotate_left(node *&n) {
+    impl::count(m_node_alloc, &alloc_stats::rotations);
     node  *nr   = n->r;
     node *&nrlp = n->r->l ? n->r->l->p : nr;
     nary::swap(n,n->r,n->r->l, n->r->p,n->p,nrlp);
   };
 
   constexpr void rotate_right(node *&n) {
+    impl::count(m_node_alloc, &alloc_stats::rotations);
     node  *nl   = n->l;
     node *&nlrp = n->l->r ? n->l->r->p : nl;
     nary::swap(n,n->l,n->l->r, n->l->p,n->p,nlrp);
@@ -273,6 +282,12 @@ public:
   typename std::allocator_traits<allocator_type>::template rebind_alloc<node> m_node_alloc;
 };
 
+namespace pmr {
+template <typename T> class polymorphic_allocator; // cest/memory_resource.hpp
+template <class Key, class Compare = std::less<Key>>
+using set = cest::set<Key, Compare, polymorphic_allocator<Key>>;
+} // namespace pmr
+
 } // namespace cest
 
 #endif // _CEST_SET_HPP_
@@ -5,6 +5,8 @@
 // https://www.justsoftwaresolutions.co.uk/cplusplus/shared-ptr-secret-constructor.html
 
 #include <type_traits>
+#include <memory>      // std::allocator, std::allocator_traits, std::bad_weak_ptr
+#include <atomic>      // std::atomic_ref
 
 #include "cest/iostream.hpp"
 #include "cest/swap.hpp"
@@ -34,40 +36,270 @@ struct default_delete<T[]>
   constexpr void operator()(U* ptr) const { delete [] ptr; }
 };
 
-template <typename>
+// Reference counting policies. The counts of an atomic_policy shared_ptr are
+// updated atomically at runtime, so copies may be used by different threads;
+// during constant evaluation they are plain integers.
+struct single_policy {};
+struct atomic_policy {};
+
+template <typename T, typename Policy = single_policy>
   class shared_ptr;
 
+template <typename T, typename Policy = single_policy>
+  class weak_ptr;
+
 namespace impl {
 
-template <typename T, typename Td>
-class shared_ptr_base
+// The control block. As with libstdc++'s _Sp_counted_base, dispose() destroys
+// the managed object when count_ reaches zero; destroy() frees the block when
+// weak_ reaches zero. weak_ is the number of weak_ptrs, plus one while any
+// shared_ptr remains. The destructor is not virtual: each destroy() deletes
+// its own final type.
+struct ctrl
 {
+  constexpr ctrl() : count_(1), weak_(1) {}
+  virtual constexpr void dispose() = 0;
+  virtual constexpr void destroy() = 0;
+
+  template <class Policy>
+  static constexpr void increment(long& n) noexcept
+  {
+    if constexpr (std::is_same_v<Policy, atomic_policy>)
+      if (!std::is_constant_evaluated()) {
+        std::atomic_ref<long>(n).fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+    ++n;
+  }
+
+  // returns the new count
+  template <class Policy>
+  static constexpr long decrement(long& n) noexcept
+  {
+    if constexpr (std::is_same_v<Policy, atomic_policy>)
+      if (!std::is_constant_evaluated())
+        return std::atomic_ref<long>(n).fetch_sub(1,
+                                                  std::memory_order_acq_rel) - 1;
+    return --n;
+  }
+
+  template <class Policy>
+  constexpr void add_ref() noexcept { increment<Policy>(count_); }
+
+  // for weak_ptr::lock: fails if the managed object has already been disposed
+  template <class Policy>
+  constexpr bool add_ref_lock() noexcept
+  {
+    if constexpr (std::is_same_v<Policy, atomic_policy>)
+      if (!std::is_constant_evaluated()) {
+        std::atomic_ref<long> count(count_);
+        long n = count.load(std::memory_order_relaxed);
+        do {
+          if (n == 0)
+            return false;
+        } while (!count.compare_exchange_weak(n, n + 1,
+                                              std::memory_order_acq_rel,
+                                              std::memory_order_relaxed));
+        return true;
+      }
+    if (count_ == 0)
+      return false;
+    ++count_;
+    return true;
+  }
+
+  template <class Policy>
+  constexpr void release() noexcept
+  {
+    if (decrement<Policy>(count_) == 0) {
+      dispose();
+      weak_release<Policy>();
+    }
+  }
+
+  template <class Policy>
+  constexpr void weak_add_ref() noexcept { increment<Policy>(weak_); }
+
+  template <class Policy>
+  constexpr void weak_release() noexcept
+  {
+    if (decrement<Policy>(weak_) == 0)
+      destroy();
+  }
+
+  template <class Policy>
+  constexpr long use_count() const noexcept
+  {
+    if constexpr (std::is_same_v<Policy, atomic_policy>)
+      if (!std::is_constant_evaluated())
+        return std::atomic_ref<long>(const_cast<long&>(count_)).load(
+                 std::memory_order_relaxed);
+    return count_;
+  }
+
+  long count_;
+  long weak_;
+
 protected:
-  struct ctrl
+  constexpr ~ctrl() = default;
+};
+
+// Owns a pointer obtained elsewhere (e.g. from new); paired with a deleter
+template <class U, class Deleter>
+struct ctrl_derived final : public ctrl
+{
+  constexpr ctrl_derived(U* ptr, Deleter del) : ptr_{ptr}, del_{del} {}
+  virtual constexpr void dispose() override { del_(ptr_); }
+  virtual constexpr void destroy() override { delete this; }
+
+  U* ptr_;
+  Deleter del_;
+};
+
+// Used by make_shared and allocate_shared: the object lives inside the control
+// block; so one allocation, rather than two. The anonymous union allows the
+// object to be destroyed before the block is deallocated.
+template <class U, class Alloc>
+struct ctrl_inplace final : public ctrl
+{
+  using alloc_t =
+    typename std::allocator_traits<Alloc>::template rebind_alloc<ctrl_inplace>;
+
+  template <class... Args>
+  constexpr ctrl_inplace(const Alloc& a, Args&&... args) : alloc_(a) {
+    std::construct_at(&obj_, std::forward<Args>(args)...);
+  }
+  constexpr ~ctrl_inplace() {}
+
+  virtual constexpr void dispose() override { std::destroy_at(&obj_); }
+  virtual constexpr void destroy() override {
+    alloc_t a(alloc_);
+    std::destroy_at(this);
+    a.deallocate(this, 1);
+  }
+
+  [[no_unique_address]] Alloc alloc_;
+  union { U obj_; };
+};
+
+// Deallocates n objects at p on destruction; unless released. This holds an
+// allocation until the objects within it are constructed.
+template <class A>
+struct alloc_guard
+{
+  using pointer = typename std::allocator_traits<A>::pointer;
+
+  constexpr ~alloc_guard() { if (p_) a_.deallocate(p_, n_); }
+  constexpr pointer release() { pointer p = p_; p_ = nullptr; return p; }
+
+  A& a_;
+  pointer p_;
+  std::size_t n_;
+};
+
+// Used by make_shared<T[]> and allocate_shared<T[]>. At runtime the n elements
+// follow the control block within the same allocation. A constant expression
+// can't give an object a runtime-sized tail, so then the elements are
+// allocated separately.
+template <class U, class Alloc>
+struct alignas(alignof(U) > alignof(ctrl) ? alignof(U) : alignof(ctrl))
+ctrl_inplace_array final : public ctrl
+{
+  using alloc_t =
+    typename std::allocator_traits<Alloc>::template rebind_alloc<
+      ctrl_inplace_array>;
+  using elem_alloc_t =
+    typename std::allocator_traits<Alloc>::template rebind_alloc<U>;
+
+  // the number of ctrl_inplace_array sized units holding the block and array
+  static constexpr std::size_t units(std::size_t n) {
+    const std::size_t sz = sizeof(ctrl_inplace_array);
+    return (sz + n * sizeof(U) + sz - 1) / sz;
+  }
+
+  static constexpr ctrl_inplace_array* create(const Alloc& a, std::size_t n)
   {
-    constexpr ctrl() : count_(1) {}
-    virtual constexpr void destroy() = 0;
-    virtual constexpr ~ctrl() {}
+    alloc_t ba(a);
+    if (std::is_constant_evaluated()) {
+      elem_alloc_t ea(a);
+      alloc_guard<elem_alloc_t> ge{ea, ea.allocate(n), n};
+      alloc_guard<alloc_t> gb{ba, ba.allocate(1), 1};
+      std::construct_at(gb.p_, a, n);
+      gb.p_->ptr_ = ge.release();
+      return gb.release();
+    }
 
-    long count_;
-  };
+    alloc_guard<alloc_t> gb{ba, ba.allocate(units(n)), units(n)};
+    std::construct_at(gb.p_, a, n);
+    gb.p_->ptr_ = reinterpret_cast<U*>(gb.p_ + 1);
+    return gb.release();
+  }
 
-  template <class U, class Deleter>
-  struct ctrl_derived : public ctrl
+  // Constructs each element from args; should one throw, those constructed
+  // are destroyed, and the block deallocated
+  template <class... Args>
+  constexpr void construct_elements(const Args&... args)
   {
-    constexpr ctrl_derived(U* ptr, Deleter del) : ptr_{ptr}, del_{del} {}
-    virtual constexpr void destroy() override { del_(ptr_); }
+    struct guard {
+      constexpr ~guard() {
+        if (p_) {
+          std::destroy_n(p_->ptr_, i_);
+          p_->destroy();
+        }
+      }
+      ctrl_inplace_array* p_;
+      std::size_t i_;
+    } g{this, 0};
+    for (; g.i_ < n_; ++g.i_)
+      std::construct_at(ptr_ + g.i_, args...);
+    g.p_ = nullptr;
+  }
+
+  constexpr ctrl_inplace_array(const Alloc& a, std::size_t n)
+    : alloc_(a), n_(n) {}
+
+  virtual constexpr void dispose() override { std::destroy_n(ptr_, n_); }
+  virtual constexpr void destroy() override {
+    alloc_t a(alloc_);
+    const std::size_t n = n_;
+    if (std::is_constant_evaluated()) {
+      elem_alloc_t ea(alloc_);
+      ea.deallocate(ptr_, n);
+      std::destroy_at(this);
+      a.deallocate(this, 1);
+    } else {
+      std::destroy_at(this);
+      a.deallocate(this, units(n));
+    }
+  }
+
+  [[no_unique_address]] Alloc alloc_;
+  std::size_t n_;
+  U* ptr_{};
+};
 
-    U* ptr_;
-    Deleter del_;
-  };
+struct inplace_t { explicit inplace_t() = default; };
 
+template <typename T, typename Td, typename Policy>
+class shared_ptr_base
+{
+protected:
   template <typename U>
   struct def_del : default_delete<U> {};
 
+  // e.g. shared_ptr<Derived> converts to shared_ptr<Base>
+  template <class Y>
+  using compatible_t = std::enable_if_t<std::is_convertible_v<Y*, Td*>>;
+
+  template <typename, typename, typename>
+  friend class shared_ptr_base;
+
+  template <typename, typename>
+  friend class cest::weak_ptr;
+
 public:
   using element_type = std::remove_extent_t<T>;
-  using weak_type = std::weak_ptr<T>;
+  using weak_type = weak_ptr<Td, Policy>;
 
   constexpr shared_ptr_base() noexcept {}
   constexpr shared_ptr_base(std::nullptr_t) noexcept {}
@@ -81,23 +313,93 @@ public:
     : ptr_{ptr}, pctrl_{new ctrl_derived<Y,Deleter>{ptr,del}} {}
 
   constexpr shared_ptr_base(const shared_ptr_base& r) noexcept
-    : ptr_{r.ptr_}, pctrl_{r.pctrl_} { ++pctrl_->count_; }
+    : ptr_{r.ptr_}, pctrl_{r.pctrl_} { if (pctrl_) pctrl_->template add_ref<Policy>(); }
+
+  constexpr shared_ptr_base(shared_ptr_base&& r) noexcept
+    : ptr_{r.ptr_}, pctrl_{r.pctrl_} { r.ptr_ = nullptr; r.pctrl_ = nullptr; }
+
+  template <class Y, class = compatible_t<Y>>
+  constexpr shared_ptr_base(const shared_ptr<Y, Policy>& r) noexcept
+    : ptr_{r.ptr_}, pctrl_{r.pctrl_} { if (pctrl_) pctrl_->template add_ref<Policy>(); }
+
+  template <class Y, class = compatible_t<Y>>
+  constexpr shared_ptr_base(shared_ptr<Y, Policy>&& r) noexcept
+    : ptr_{r.ptr_}, pctrl_{r.pctrl_} { r.ptr_ = nullptr; r.pctrl_ = nullptr; }
+
+  // The aliasing constructors
+  template <class Y>
+  constexpr shared_ptr_base(const shared_ptr<Y, Policy>& r,
+                            element_type* ptr) noexcept
+    : ptr_{ptr}, pctrl_{r.pctrl_} { if (pctrl_) pctrl_->template add_ref<Policy>(); }
 
   template <class Y>
-  constexpr shared_ptr_base(const shared_ptr<Y>& r, element_type* ptr) noexcept
-    : ptr_{ptr}, pctrl_{r.pctrl_} { ++pctrl_->count_; }
+  constexpr shared_ptr_base(shared_ptr<Y, Policy>&& r,
+                            element_type* ptr) noexcept
+    : ptr_{ptr}, pctrl_{r.pctrl_} { r.ptr_ = nullptr; r.pctrl_ = nullptr; }
+
+  template <class Y, class = compatible_t<Y>>
+  explicit constexpr shared_ptr_base(const weak_ptr<Y, Policy>& r)
+    : ptr_{r.ptr_}, pctrl_{r.pctrl_}
+  {
+    if (!pctrl_ || !pctrl_->template add_ref_lock<Policy>())
+      throw std::bad_weak_ptr();
+  }
+
+  // Adopts a control block made by make_shared or allocate_shared
+  constexpr shared_ptr_base(inplace_t, element_type* ptr, ctrl* pctrl) noexcept
+    : ptr_{ptr}, pctrl_{pctrl} {}
 
   constexpr ~shared_ptr_base()
   {
-    if (pctrl_ && !--pctrl_->count_)
-    {
-      pctrl_->destroy();
-      delete pctrl_;
-    }
+    if (pctrl_)
+      pctrl_->template release<Policy>();
+  }
+
+  constexpr shared_ptr_base& operator=(const shared_ptr_base& r) noexcept
+  {
+    shared_ptr_base(r).swap(*this);
+    return *this;
+  }
+
+  constexpr shared_ptr_base& operator=(shared_ptr_base&& r) noexcept
+  {
+    shared_ptr_base(std::move(r)).swap(*this);
+    return *this;
+  }
+
+  template <class Y, class = compatible_t<Y>>
+  constexpr shared_ptr<Td, Policy>& operator=(const shared_ptr<Y, Policy>& r) noexcept
+  {
+    shared_ptr<Td, Policy>(r).swap(*this);
+    return static_cast<shared_ptr<Td, Policy>&>(*this);
+  }
+
+  template <class Y, class = compatible_t<Y>>
+  constexpr shared_ptr<Td, Policy>& operator=(shared_ptr<Y, Policy>&& r) noexcept
+  {
+    shared_ptr<Td, Policy>(std::move(r)).swap(*this);
+    return static_cast<shared_ptr<Td, Policy>&>(*this);
+  }
+
+  constexpr void swap(shared_ptr_base& r) noexcept
+  {
+    using std::swap;
+    swap(ptr_, r.ptr_);
+    swap(pctrl_, r.pctrl_);
+  }
+
+  constexpr void reset() noexcept { shared_ptr_base().swap(*this); }
+
+  template <class Y>
+  constexpr void reset(Y* ptr) { shared_ptr<Td, Policy>(ptr).swap(*this); }
+
+  template <class Y, class Deleter>
+  constexpr void reset(Y* ptr, Deleter del) {
+    shared_ptr<Td, Policy>(ptr, del).swap(*this);
   }
 
   constexpr long use_count() const noexcept {
-    return pctrl_ ? pctrl_->count_ : 0;
+    return pctrl_ ? pctrl_->template use_count<Policy>() : 0;
   }
 
   constexpr element_type* get() const noexcept { return ptr_; }
@@ -107,23 +409,22 @@ public:
 
   constexpr operator bool() const noexcept { return ptr_; }
 
-  template <class Deleter, class U>
-  friend constexpr Deleter* get_deleter(const shared_ptr<U>&) noexcept;
+  template <class Deleter, class U, class P>
+  friend constexpr Deleter* get_deleter(const shared_ptr<U, P>&) noexcept;
 
 protected:
   T* ptr_{};
   ctrl *pctrl_{};
 };
 
-template <class Deleter, class U>
-constexpr Deleter* get_deleter(const shared_ptr<U>& p) noexcept
+template <class Deleter, class U, class P>
+constexpr Deleter* get_deleter(const shared_ptr<U, P>& p) noexcept
 {
-  using elem_t = typename shared_ptr<U>::element_type;
+  using elem_t = typename shared_ptr<U, P>::element_type;
 
   if constexpr (std::is_invocable_v<Deleter,elem_t*>)
   {
-    using ctrl_derived_t =
-      typename shared_ptr<U>::template ctrl_derived<elem_t,Deleter>;
+    using ctrl_derived_t = ctrl_derived<elem_t,Deleter>;
     auto ptr = dynamic_cast<ctrl_derived_t*>(p.pctrl_);
     return ptr ? &ptr->del_ : nullptr;
   } 
@@ -133,37 +434,201 @@ constexpr Deleter* get_deleter(const shared_ptr<U>& p) noexcept
 
 } // namespace impl
 
-template <typename T>
-class shared_ptr : public impl::shared_ptr_base<T,T>
+template <typename T, typename Policy>
+class shared_ptr : public impl::shared_ptr_base<T,T,Policy>
 {
-  using base_t = impl::shared_ptr_base<T,T>;
+  using base_t = impl::shared_ptr_base<T,T,Policy>;
 
 public:
 
   using element_type = typename base_t::element_type;
   using weak_type = typename base_t::weak_type;
   using base_t::base_t;
+  using base_t::operator=;
 };
 
-template <typename T>
-class shared_ptr<T[]> : public impl::shared_ptr_base<T,T[]>
+template <typename T, typename Policy>
+class shared_ptr<T[], Policy> : public impl::shared_ptr_base<T,T[],Policy>
 {
-  using base_t = impl::shared_ptr_base<T,T[]>;
+  using base_t = impl::shared_ptr_base<T,T[],Policy>;
 
 public:
 
   using element_type = typename base_t::element_type;
   using weak_type = typename base_t::weak_type;
   using base_t::base_t;
+  using base_t::operator=;
 
   constexpr element_type& operator[](std::ptrdiff_t i) const {
     return this->get()[i];
   }
 };
 
-template<typename T>
+template <typename T>
+using atomic_shared_ptr = shared_ptr<T, atomic_policy>;
+
+template <typename T, typename Policy>
+class weak_ptr
+{
+  template <class Y>
+  using compatible_t = std::enable_if_t<std::is_convertible_v<Y*, T*>>;
+
+  template <typename, typename>
+  friend class weak_ptr;
+
+  template <typename, typename, typename>
+  friend class impl::shared_ptr_base;
+
+public:
+  using element_type = std::remove_extent_t<T>;
+
+  constexpr weak_ptr() noexcept {}
+
+  constexpr weak_ptr(const weak_ptr& r) noexcept
+    : ptr_{r.ptr_}, pctrl_{r.pctrl_}
+  { if (pctrl_) pctrl_->template weak_add_ref<Policy>(); }
+
+  constexpr weak_ptr(weak_ptr&& r) noexcept
+    : ptr_{r.ptr_}, pctrl_{r.pctrl_} { r.ptr_ = nullptr; r.pctrl_ = nullptr; }
+
+  template <class Y, class = compatible_t<Y>>
+  constexpr weak_ptr(const weak_ptr<Y, Policy>& r) noexcept
+    : ptr_{r.ptr_}, pctrl_{r.pctrl_}
+  { if (pctrl_) pctrl_->template weak_add_ref<Policy>(); }
+
+  template <class Y, class = compatible_t<Y>>
+  constexpr weak_ptr(const shared_ptr<Y, Policy>& r) noexcept
+    : ptr_{r.ptr_}, pctrl_{r.pctrl_}
+  { if (pctrl_) pctrl_->template weak_add_ref<Policy>(); }
+
+  constexpr ~weak_ptr()
+  {
+    if (pctrl_)
+      pctrl_->template weak_release<Policy>();
+  }
+
+  constexpr weak_ptr& operator=(const weak_ptr& r) noexcept
+  {
+    weak_ptr(r).swap(*this);
+    return *this;
+  }
+
+  constexpr weak_ptr& operator=(weak_ptr&& r) noexcept
+  {
+    weak_ptr(std::move(r)).swap(*this);
+    return *this;
+  }
+
+  template <class Y, class = compatible_t<Y>>
+  constexpr weak_ptr& operator=(const shared_ptr<Y, Policy>& r) noexcept
+  {
+    weak_ptr(r).swap(*this);
+    return *this;
+  }
+
+  constexpr void reset() noexcept { weak_ptr().swap(*this); }
+
+  constexpr void swap(weak_ptr& r) noexcept
+  {
+    using std::swap;
+    swap(ptr_, r.ptr_);
+    swap(pctrl_, r.pctrl_);
+  }
+
+  constexpr long use_count() const noexcept {
+    return pctrl_ ? pctrl_->template use_count<Policy>() : 0;
+  }
+
+  constexpr bool expired() const noexcept { return use_count() == 0; }
+
+  constexpr shared_ptr<T, Policy> lock() const noexcept
+  {
+    if (pctrl_ && pctrl_->template add_ref_lock<Policy>())
+      return shared_ptr<T, Policy>(impl::inplace_t{}, ptr_, pctrl_);
+    return shared_ptr<T, Policy>();
+  }
+
+private:
+  element_type* ptr_{};
+  impl::ctrl *pctrl_{};
+};
+
+template <typename T, typename Policy>
+constexpr void swap(weak_ptr<T, Policy>& a, weak_ptr<T, Policy>& b) noexcept
+{
+  a.swap(b);
+}
+
+// make_shared<T>(args...) returns a shared_ptr<T>; while
+// make_shared<T, atomic_policy>(args...) returns an atomic_shared_ptr<T>.
+template <typename T, typename Policy = single_policy, typename Alloc,
+          typename... Args>
+constexpr std::enable_if_t<!std::is_array_v<T>, shared_ptr<T, Policy>>
+allocate_shared(const Alloc& alloc, Args&&... args)
+{
+  using ctrl_t = impl::ctrl_inplace<T,Alloc>;
+  typename ctrl_t::alloc_t a(alloc);
+  impl::alloc_guard<typename ctrl_t::alloc_t> g{a, a.allocate(1), 1};
+  std::construct_at(g.p_, alloc, std::forward<Args>(args)...);
+  ctrl_t* p = g.release();
+  return shared_ptr<T, Policy>(impl::inplace_t{}, &p->obj_, p);
+}
+
+template <typename T, typename Policy = single_policy, typename... Args>
+constexpr std::enable_if_t<!std::is_array_v<T>, shared_ptr<T, Policy>>
+make_shared(Args&&... args)
+{
+  return cest::allocate_shared<T, Policy>(std::allocator<T>(),
+                                          std::forward<Args>(args)...);
+}
+
+// The elements of the array are value-initialised; or copies of u
+template <typename T, typename Policy = single_policy, typename Alloc>
+constexpr std::enable_if_t<std::is_unbounded_array_v<T>, shared_ptr<T, Policy>>
+allocate_shared(const Alloc& alloc, std::size_t n)
+{
+  using elem_t = std::remove_extent_t<T>;
+  auto* p = impl::ctrl_inplace_array<elem_t,Alloc>::create(alloc, n);
+  p->construct_elements();
+  return shared_ptr<T, Policy>(impl::inplace_t{}, p->ptr_, p);
+}
+
+template <typename T, typename Policy = single_policy, typename Alloc>
+constexpr std::enable_if_t<std::is_unbounded_array_v<T>, shared_ptr<T, Policy>>
+allocate_shared(const Alloc& alloc, std::size_t n,
+                const std::remove_extent_t<T>& u)
+{
+  using elem_t = std::remove_extent_t<T>;
+  auto* p = impl::ctrl_inplace_array<elem_t,Alloc>::create(alloc, n);
+  p->construct_elements(u);
+  return shared_ptr<T, Policy>(impl::inplace_t{}, p->ptr_, p);
+}
+
+template <typename T, typename Policy = single_policy>
+constexpr std::enable_if_t<std::is_unbounded_array_v<T>, shared_ptr<T, Policy>>
+make_shared(std::size_t n)
+{
+  using elem_t = std::remove_extent_t<T>;
+  return cest::allocate_shared<T, Policy>(std::allocator<elem_t>(), n);
+}
+
+template <typename T, typename Policy = single_policy>
+constexpr std::enable_if_t<std::is_unbounded_array_v<T>, shared_ptr<T, Policy>>
+make_shared(std::size_t n, const std::remove_extent_t<T>& u)
+{
+  using elem_t = std::remove_extent_t<T>;
+  return cest::allocate_shared<T, Policy>(std::allocator<elem_t>(), n, u);
+}
+
+template <typename T, typename Policy>
+constexpr void swap(shared_ptr<T, Policy>& a, shared_ptr<T, Policy>& b) noexcept
+{
+  a.swap(b);
+}
+
+template <typename T, typename Policy>
 constexpr cest::ostream&
-operator<<(cest::ostream& o, shared_ptr<T> const& p)
+operator<<(cest::ostream& o, shared_ptr<T, Policy> const& p)
 {
   if (!std::is_constant_evaluated())
     return o << p.get();
@@ -0,0 +1,203 @@
+#ifndef _CEST_SPANSTREAM_HPP_
+#define _CEST_SPANSTREAM_HPP_
+
+// A C++23 <spanstream> subset. The buffer is the caller's character range:
+// nothing is allocated or copied, and the range must outlive the stream.
+
+#include "istream.hpp"
+#include "ostream.hpp"
+#include "streambuf.hpp"
+#include <span>
+#include <type_traits> // std::is_convertible_v
+
+namespace cest {
+
+template<
+  class _CharT,
+  class _Traits = std::char_traits<_CharT>
+> class basic_spanbuf : public basic_streambuf<_CharT, _Traits>
+{
+public:
+
+  typedef _CharT  char_type;
+  typedef _Traits traits_type;
+
+  typedef typename traits_type::int_type    int_type;
+  typedef typename traits_type::pos_type    pos_type;
+  typedef typename traits_type::off_type    off_type;
+
+  typedef basic_streambuf<char_type, traits_type>   __streambuf_type;
+
+protected:
+
+  ios_base::openmode  _M_mode;
+  std::span<_CharT>   _M_buf;
+
+public:
+
+  constexpr basic_spanbuf()
+  : __streambuf_type(), _M_mode(ios_base::in | ios_base::out), _M_buf()
+  { }
+
+  constexpr explicit
+  basic_spanbuf(ios_base::openmode __mode)
+  : __streambuf_type(), _M_mode(__mode), _M_buf()
+  { }
+
+  constexpr explicit
+  basic_spanbuf(std::span<_CharT> __s,
+    ios_base::openmode __mode = ios_base::in | ios_base::out)
+  : __streambuf_type(), _M_mode(__mode), _M_buf()
+  { span(__s); }
+
+  // from spanstream
+  // In output mode, the characters written so far; else the whole buffer
+  constexpr std::span<_CharT> span() const noexcept
+  {
+    if (_M_mode & ios_base::out)
+      return std::span<_CharT>(this->pbase(), this->pptr());
+    else
+      return _M_buf;
+  }
+
+  constexpr void span(std::span<_CharT> __s) noexcept
+  {
+    _M_buf = __s;
+    if (_M_mode & ios_base::out)
+    {
+      this->setp(__s.data(), __s.data() + __s.size());
+      if (_M_mode & ios_base::ate)
+        this->__safe_pbump(__s.size());
+    }
+    if (_M_mode & ios_base::in)
+      this->setg(__s.data(), __s.data(), __s.data() + __s.size());
+  }
+};
+
+using spanbuf = basic_spanbuf<char>;
+using wspanbuf = basic_spanbuf<wchar_t>;
+
+template <
+  class _CharT,
+  class _Traits = std::char_traits<_CharT>
+> class basic_ispanstream : public basic_istream<_CharT, _Traits>
+{
+public:
+  using char_type   = _CharT;
+  using traits_type = _Traits;
+  using int_type    = typename traits_type::int_type;
+  using pos_type    = typename traits_type::pos_type;
+  using off_type    = typename traits_type::off_type;
+
+  typedef basic_spanbuf<_CharT, _Traits>  __spanbuf_type;
+  typedef basic_istream<char_type, traits_type> __istream_type;
+
+  constexpr explicit
+  basic_ispanstream(std::span<_CharT> __s,
+                    ios_base::openmode __mode = ios_base::in)
+  : __istream_type(), _M_spanbuf(__s, __mode | ios_base::in)
+  { this->init(&_M_spanbuf); }
+
+  // A read-only range, such as a const array; never written through
+  template <class _Ros>
+    requires (!std::is_convertible_v<_Ros, std::span<_CharT>>)
+          && std::is_convertible_v<_Ros, std::span<const _CharT>>
+  constexpr explicit
+  basic_ispanstream(_Ros&& __r)
+  : basic_ispanstream(_S_unconst(std::forward<_Ros>(__r)))
+  { }
+
+  constexpr __spanbuf_type*
+  rdbuf() const
+  { return const_cast<__spanbuf_type*>(&_M_spanbuf); }
+
+  constexpr std::span<const _CharT> span() const { return _M_spanbuf.span(); }
+  constexpr void span(std::span<_CharT> __s) { _M_spanbuf.span(__s); }
+
+  constexpr ~basic_ispanstream() {}
+
+  __spanbuf_type  _M_spanbuf;
+
+private:
+  static constexpr std::span<_CharT> _S_unconst(std::span<const _CharT> __s)
+  { return std::span<_CharT>(const_cast<_CharT*>(__s.data()), __s.size()); }
+};
+
+using ispanstream = basic_ispanstream<char>;
+using wispanstream = basic_ispanstream<wchar_t>;
+
+template <
+  class _CharT,
+  class _Traits = std::char_traits<_CharT>
+> class basic_ospanstream : public basic_ostream<_CharT, _Traits>
+{
+public:
+  using char_type   = _CharT;
+  using traits_type = _Traits;
+  using int_type    = typename traits_type::int_type;
+  using pos_type    = typename traits_type::pos_type;
+  using off_type    = typename traits_type::off_type;
+
+  typedef basic_spanbuf<_CharT, _Traits>  __spanbuf_type;
+  typedef basic_ostream<char_type, traits_type> __ostream_type;
+
+  constexpr explicit
+  basic_ospanstream(std::span<_CharT> __s,
+                    ios_base::openmode __mode = ios_base::out)
+  : __ostream_type(), _M_spanbuf(__s, __mode | ios_base::out)
+  { this->init(&_M_spanbuf); }
+
+  constexpr __spanbuf_type*
+  rdbuf() const
+  { return const_cast<__spanbuf_type*>(&_M_spanbuf); }
+
+  constexpr std::span<_CharT> span() const { return _M_spanbuf.span(); }
+  constexpr void span(std::span<_CharT> __s) { _M_spanbuf.span(__s); }
+
+  constexpr ~basic_ospanstream() {}
+
+  __spanbuf_type  _M_spanbuf;
+};
+
+using ospanstream = basic_ospanstream<char>;
+using wospanstream = basic_ospanstream<wchar_t>;
+
+template <
+  class _CharT,
+  class _Traits = std::char_traits<_CharT>
+> class basic_spanstream : public basic_iostream<_CharT, _Traits>
+{
+public:
+  using char_type   = _CharT;
+  using traits_type = _Traits;
+  using int_type    = typename traits_type::int_type;
+  using pos_type    = typename traits_type::pos_type;
+  using off_type    = typename traits_type::off_type;
+
+  typedef basic_spanbuf<_CharT, _Traits>  __spanbuf_type;
+  typedef basic_iostream<char_type, traits_type> __iostream_type;
+
+  constexpr explicit
+  basic_spanstream(std::span<_CharT> __s,
+                   ios_base::openmode __m = ios_base::out | ios_base::in)
+  : __iostream_type(), _M_spanbuf(__s, __m)
+  { this->init(&_M_spanbuf); }
+
+  constexpr __spanbuf_type*
+  rdbuf() const
+  { return const_cast<__spanbuf_type*>(&_M_spanbuf); }
+
+  constexpr std::span<_CharT> span() const { return _M_spanbuf.span(); }
+  constexpr void span(std::span<_CharT> __s) { _M_spanbuf.span(__s); }
+
+  constexpr ~basic_spanstream() {}
+
+  __spanbuf_type  _M_spanbuf;
+};
+
+using spanstream = basic_spanstream<char>;
+using wspanstream = basic_spanstream<wchar_t>;
+
+} // namespace cest
+
+#endif // _CEST_SPANSTREAM_HPP_
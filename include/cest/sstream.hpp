@@ -2,9 +2,11 @@
 #define _CEST_SSTREAM_HPP_
 
 #include "istream.hpp"
+#include "ostream.hpp"
 #include "streambuf.hpp"
 #include "string.hpp"
-#include <limits>   // std::numeric_limits
+#include <limits>    // std::numeric_limits
+#include <algorithm> // std::max
 
 namespace cest {
 
@@ -51,6 +53,16 @@ public:
     _M_string(__str.data(), __str.size(), __str.get_allocator())
   { _M_stringbuf_init(__mode); }
 
+  // from sstream
+  constexpr __string_type str() const
+  {
+    if (char_type* __hi = _M_high_mark())
+      return __string_type(this->pbase(), __hi - this->pbase(),
+                           _M_string.get_allocator());
+    else
+      return _M_string;
+  }
+
   constexpr void str(const __string_type& __s)
   {
     _M_string = __s;
@@ -58,6 +70,38 @@ public:
   }
 
 protected:
+  constexpr int_type underflow() override;
+  constexpr int_type overflow(int_type __c = traits_type::eof()) override;
+
+  // The end of the characters written; which may be beyond egptr()
+  constexpr char_type* _M_high_mark() const
+  {
+    if (char_type* __pptr = this->pptr())
+    {
+      char_type* __egptr = this->egptr();
+      if (!__egptr || __pptr > __egptr)
+        return __pptr;
+      else
+        return __egptr;
+    }
+    return 0;
+  }
+
+  constexpr void _M_update_egptr()
+  {
+    if (char_type* __pptr = this->pptr())
+    {
+      char_type* __egptr = this->egptr();
+      if (!__egptr || __pptr > __egptr)
+      {
+        if (_M_mode & ios_base::in)
+          this->setg(this->eback(), this->gptr(), __pptr);
+        else
+          this->setg(__pptr, __pptr, __pptr);
+      }
+    }
+  }
+
   // Common initialization code goes here.
   constexpr void _M_stringbuf_init(ios_base::openmode __mode)
   {
@@ -118,6 +162,64 @@ protected:
       this->pbump(__off);
     }
 
+  // from sstream.tcc
+  template <class _CharT, class _Traits, class _Alloc>
+    constexpr typename basic_stringbuf<_CharT, _Traits, _Alloc>::int_type
+    basic_stringbuf<_CharT, _Traits, _Alloc>::
+    underflow()
+    {
+      int_type __ret = traits_type::eof();
+      if (_M_mode & ios_base::in)
+  {
+    // Update egptr() to match the actual string end.
+    _M_update_egptr();
+
+    if (this->gptr() < this->egptr())
+      __ret = traits_type::to_int_type(*this->gptr());
+  }
+      return __ret;
+    }
+
+  // Based on sstream.tcc. When the put area is full, the string is replaced
+  // by one of at least twice the capacity; so a sequence of n insertions
+  // copies O(n) characters in total.
+  template <class _CharT, class _Traits, class _Alloc>
+    constexpr typename basic_stringbuf<_CharT, _Traits, _Alloc>::int_type
+    basic_stringbuf<_CharT, _Traits, _Alloc>::
+    overflow(int_type __c)
+    {
+      const bool __testout = _M_mode & ios_base::out;
+      if (__builtin_expect(!__testout, false))
+  return traits_type::eof();
+
+      const bool __testeof = traits_type::eq_int_type(__c, traits_type::eof());
+      if (__builtin_expect(__testeof, false))
+  return traits_type::not_eof(__c);
+
+      const __size_type __capacity = _M_string.capacity();
+      const __size_type __nget = this->gptr() - this->eback();
+      const __size_type __nput = this->pptr() - this->pbase();
+      if (__size_type(this->epptr() - this->pbase()) < __capacity)
+  {
+    // There is additional capacity in _M_string that can be used.
+    _M_sync(_M_string.data(), __nget, __nput);
+  }
+      else if (this->pptr() == this->epptr())
+  {
+    const __size_type __len = std::max(__size_type(2 * __capacity),
+                                       __size_type(512));
+    __string_type __tmp(_M_string.get_allocator());
+    __tmp.reserve(__len);
+    __tmp.append(this->pbase(), this->epptr() - this->pbase());
+    _M_string.swap(__tmp);
+    _M_sync(_M_string.data(), __nget, __nput);
+  }
+
+      *this->pptr() = traits_type::to_char_type(__c);
+      this->pbump(1);
+      return __c;
+    }
+
 template <
   class _CharT,
   class _Traits = std::char_traits<_CharT>,
@@ -155,6 +257,10 @@ public:
     ios_base::openmode __mode = ios_base::in)
   : __istream_type() { }*/
 
+  constexpr __stringbuf_type*
+  rdbuf() const
+  { return const_cast<__stringbuf_type*>(&_M_stringbuf); }
+
   constexpr __string_type str() const { return _M_stringbuf.str(); }
   constexpr void str(const __string_type& __s) { _M_stringbuf.str(__s); }
 
@@ -166,6 +272,54 @@ public:
 using istringstream = basic_istringstream<char>;
 using wistringstream = basic_istringstream<wchar_t>;
 
+template <
+  class _CharT,
+  class _Traits = std::char_traits<_CharT>,
+  class _Alloc = std::allocator<_CharT>
+> class basic_ostringstream : public basic_ostream<_CharT, _Traits>
+{
+public:
+  using char_type   = _CharT;
+  using traits_type = _Traits;
+  using int_type    = typename traits_type::int_type;
+  using pos_type    = typename traits_type::pos_type;
+  using off_type    = typename traits_type::off_type;
+  using allocator_type = _Alloc;
+
+  typedef basic_string<_CharT, _Traits, _Alloc>  __string_type;
+  typedef basic_stringbuf<_CharT, _Traits, _Alloc>  __stringbuf_type;
+  typedef basic_ostream<char_type, traits_type> __ostream_type;
+
+  constexpr basic_ostringstream()
+  : __ostream_type(), _M_stringbuf(ios_base::out)
+  { this->init(&_M_stringbuf); }
+
+  explicit constexpr
+  basic_ostringstream(ios_base::openmode __mode)
+  : __ostream_type(), _M_stringbuf(__mode | ios_base::out)
+  { this->init(&_M_stringbuf); }
+
+  explicit constexpr
+  basic_ostringstream(const __string_type& __str,
+    ios_base::openmode __mode = ios_base::out)
+  : __ostream_type(), _M_stringbuf(__str, __mode | ios_base::out)
+  { this->init(&_M_stringbuf); }
+
+  constexpr __stringbuf_type*
+  rdbuf() const
+  { return const_cast<__stringbuf_type*>(&_M_stringbuf); }
+
+  constexpr __string_type str() const { return _M_stringbuf.str(); }
+  constexpr void str(const __string_type& __s) { _M_stringbuf.str(__s); }
+
+  constexpr ~basic_ostringstream() {}
+
+  __stringbuf_type  _M_stringbuf;
+};
+
+using ostringstream = basic_ostringstream<char>;
+using wostringstream = basic_ostringstream<wchar_t>;
+
 template <
   class _CharT,
   class _Traits = std::char_traits<_CharT>,
@@ -194,6 +348,10 @@ public:
   : __iostream_type(), _M_stringbuf(__str, __m)
   { this->init(&_M_stringbuf); }
 
+  constexpr __stringbuf_type*
+  rdbuf() const
+  { return const_cast<__stringbuf_type*>(&_M_stringbuf); }
+
   constexpr __string_type str() const { return _M_stringbuf.str(); }
   constexpr void str(const __string_type& __s) { _M_stringbuf.str(__s); }
 
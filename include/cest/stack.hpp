@@ -0,0 +1,47 @@
+#ifndef _CEST_STACK_HPP_
+#define _CEST_STACK_HPP_
+
+#include "cest/deque.hpp"
+#include <utility> // std::move
+
+namespace cest {
+
+template<
+  class T,
+  class Container = deque<T>
+>
+class stack {
+public:
+
+  using container_type  = Container;
+  using value_type      = typename Container::value_type;
+  using size_type       = typename Container::size_type;
+  using reference       = typename Container::reference;
+  using const_reference = typename Container::const_reference;
+
+           constexpr stack()                           : c()                { }
+  explicit constexpr stack(const container_type& cont) : c(cont)            { }
+  explicit constexpr stack(container_type&& cont)      : c(std::move(cont)) { }
+
+  [[nodiscard]] constexpr bool      empty() const { return c.empty(); }
+                constexpr size_type  size() const { return c.size();  }
+
+  constexpr reference       top()       { return c.back(); }
+  constexpr const_reference top() const { return c.back(); }
+
+  constexpr void push(const T& value) { c.push_back(value);            }
+  constexpr void push(T&& value)      { c.push_back(std::move(value)); }
+  constexpr void pop()                { c.pop_back();                  }
+
+  template <class... Args>
+  constexpr decltype(auto) emplace(Args&&... args) {
+    return c.emplace_back(std::forward<Args>(args)...);
+  }
+
+protected:
+  container_type c;
+};
+
+} // namespace cest
+
+#endif // _CEST_STACK_HPP_
@@ -26,6 +26,10 @@ protected:
   char_type*    _M_out_end;    ///< End of put area.
   //  locale      _M_buf_locale;
 
+  // As libstdc++; basic_istream scans the get area directly
+  template<typename _CharT2, typename _Traits2>
+    friend class basic_istream;
+
 public:
   constexpr // virtual
   ~basic_streambuf()
@@ -73,6 +77,29 @@ public:
   sgetn(char_type* __s, streamsize __n)
   { return this->xsgetn(__s, __n); }
 
+  constexpr streamsize
+  in_avail()
+  {
+    const streamsize __ret = this->egptr() - this->gptr();
+    return __ret ? __ret : this->showmanyc();
+  }
+
+  constexpr int_type
+  sputbackc(char_type __c)
+  {
+    int_type __ret;
+    const bool __testpos = this->eback() < this->gptr();
+    if (__builtin_expect(!__testpos ||
+                         !traits_type::eq(__c, this->gptr()[-1]), false))
+      __ret = this->pbackfail(traits_type::to_int_type(__c));
+    else
+    {
+      this->gbump(-1);
+      __ret = traits_type::to_int_type(*this->gptr());
+    }
+    return __ret;
+  }
+
   constexpr int_type
   sungetc()
   {
@@ -87,6 +114,25 @@ public:
     return __ret;
   }
 
+  constexpr int_type
+  sputc(char_type __c)
+  {
+    int_type __ret;
+    if (__builtin_expect(this->pptr() < this->epptr(), true))
+    {
+      *this->pptr() = __c;
+      this->pbump(1);
+      __ret = traits_type::to_int_type(__c);
+    }
+    else
+      __ret = this->overflow(traits_type::to_int_type(__c));
+    return __ret;
+  }
+
+  constexpr streamsize
+  sputn(const char_type* __s, streamsize __n)
+  { return this->xsputn(__s, __n); }
+
 protected:
   constexpr basic_streambuf()
   : _M_in_beg(0), _M_in_cur(0), _M_in_end(0),
@@ -116,6 +162,15 @@ protected:
     _M_in_end = __gend;                                          
   }
 
+  constexpr char_type*
+  pbase() const { return _M_out_beg; }
+
+  constexpr char_type*
+  pptr() const { return _M_out_cur; }
+
+  constexpr char_type*
+  epptr() const { return _M_out_end; }
+
   constexpr void pbump(int __n) { _M_out_cur += __n; }
 
   constexpr void setp(char_type* __pbeg, char_type* __pend)
@@ -127,6 +182,9 @@ protected:
   virtual constexpr int
   sync() { return 0; }
 
+  virtual constexpr streamsize
+  showmanyc() { return 0; }
+
   virtual constexpr int_type
   underflow()
   { return traits_type::eof(); }
@@ -185,8 +243,51 @@ protected:
   pbackfail(int_type __c _IsUnused  = traits_type::eof())
   { return traits_type::eof(); }
 
+    // from streambuf.tcc
+    virtual constexpr streamsize
+    xsputn(const char_type* __s, streamsize __n)
+    {
+      streamsize __ret = 0;
+      while (__ret < __n)
+  {
+    const streamsize __buf_len = this->epptr() - this->pptr();
+    if (__buf_len)
+      {
+        const streamsize __remaining = __n - __ret;
+        const streamsize __len = std::min(__buf_len, __remaining);
+        traits_type::copy(this->pptr(), __s, __len);
+        __ret += __len;
+        __s += __len;
+        this->__safe_pbump(__len);
+      }
+
+    if (__ret < __n)
+      {
+        int_type __c = this->overflow(traits_type::to_int_type(*__s));
+        if (!traits_type::eq_int_type(__c, traits_type::eof()))
+    {
+      ++__ret;
+      ++__s;
+    }
+        else
+    break;
+      }
+  }
+      return __ret;
+    }
+
+  virtual constexpr int_type
+  overflow(int_type __c _IsUnused  = traits_type::eof())
+  { return traits_type::eof(); }
+
+  constexpr void
+  __safe_pbump(streamsize __n) { _M_out_cur += __n; }
+
 };
 
+using  streambuf = basic_streambuf<char>;
+using wstreambuf = basic_streambuf<wchar_t>;
+
 } // namespace cest
 
 #endif // _CEST_STREAMBUF_HPP_
@@ -2,12 +2,14 @@
 #define _CEST_STRING_HPP_
 
 #include "ostream.hpp"
-#include "runtime_ostream.hpp"
+#include "istream.hpp"
+#include "instrument.hpp"
 #include <string>      // std::char_traits
 #include <memory>      // std::allocator
 #include <iterator>    // std::reverse_iterator
 #include <limits>      // std::numeric_limits
 #include <type_traits> // std::is_same_v
+#include <utility>     // std::swap
 
 namespace cest {
 
@@ -62,7 +64,9 @@ public:
   constexpr basic_string(const CharT* s, const Allocator &alloc = Allocator())
   : basic_string(s, traits_type::length(s), alloc) {}
 
-  constexpr basic_string(const basic_string& str) : basic_string(str.c_str()) {}
+  constexpr basic_string(const basic_string& str)
+    : basic_string(str.c_str(), std::allocator_traits<Allocator>::
+                     select_on_container_copy_construction(str.m_alloc)) {}
 
   template <class InputIt>
   constexpr basic_string(InputIt __beg, InputIt __end,
@@ -87,6 +91,8 @@ public:
         if (__len == __capacity)
           {
             // Allocate more space.
+            impl::count(m_alloc, &alloc_stats::reallocations);
+            impl::count(m_alloc, &alloc_stats::relocated_elements, __len);
             __capacity = (__len + 1) * 2;
             pointer __another  = m_alloc.allocate(__capacity + 1);
             for (size_type i = 0; i < __capacity+1; i++)
@@ -193,6 +199,8 @@ public:
         traits_type::copy(this->data() + this->size(), s, count);
     }
     else {
+      impl::count(m_alloc, &alloc_stats::reallocations);
+      impl::count(m_alloc, &alloc_stats::relocated_elements, m_size);
       value_type *p = m_alloc.allocate(len+1);
       for (size_type i = 0; i < len+1; i++)
         std::construct_at(&p[i]);
@@ -222,6 +230,7 @@ public:
     size_type count = traits_type::length(s);
 
     if (m_capacity < count+1) {
+      impl::count(m_alloc, &alloc_stats::reallocations);
       m_alloc.deallocate(m_p, m_capacity+1);
       m_capacity = count+1;                    // ensure m_capacity is not 0
       m_p = m_alloc.allocate(m_capacity+1);    // +1 for the null terminator
@@ -242,6 +251,8 @@ public:
   {
     if (new_cap > m_capacity)
     {
+      impl::count(m_alloc, &alloc_stats::reallocations);
+      impl::count(m_alloc, &alloc_stats::relocated_elements, m_size);
       value_type *p = m_alloc.allocate(new_cap+1); // for the null terminator
       for (size_type i = 0; i < new_cap+1; i++)
         std::construct_at(&p[i]);
@@ -252,6 +263,15 @@ public:
     }
   }
 
+  constexpr void swap(basic_string& other) noexcept
+  {
+    using std::swap;
+    swap(m_size, other.m_size);
+    swap(m_capacity, other.m_capacity);
+    swap(m_p, other.m_p);
+    swap(m_alloc, other.m_alloc);
+  }
+
   constexpr int compare(const CharT* s) const noexcept
   {
     const size_type  size = this->size();
@@ -367,8 +387,121 @@ operator<<(
   basic_ostream<CharT, Traits>& os,
   const basic_string<CharT, Traits, Allocator>& str)
 {
-  impl::runtime_ostream(os, str.c_str());
-  return os;
+  return __ostream_insert(os, str.data(), str.size());
+}
+
+// from basic_string.tcc; characters are appended up to whitespace, or width()
+template <class CharT, class Traits, class Allocator>
+constexpr basic_istream<CharT, Traits>&
+operator>>(
+  basic_istream<CharT, Traits>& is,
+  basic_string<CharT, Traits, Allocator>& str)
+{
+  using istream_type = basic_istream<CharT, Traits>;
+  using int_type     = typename istream_type::int_type;
+
+  std::size_t extracted = 0;
+  ios_base::iostate err = ios_base::goodbit;
+  typename istream_type::sentry cerb(is, false);
+  if (cerb)
+  {
+    __try
+    {
+      str.clear();
+      const streamsize w = is.width();
+      const std::size_t n = w > 0 ? static_cast<std::size_t>(w)
+                                  : std::numeric_limits<std::size_t>::max();
+      const int_type eof = Traits::eof();
+      int_type c = is.rdbuf()->sgetc();
+      while (extracted < n && !Traits::eq_int_type(c, eof) &&
+             !impl::__is_space(Traits::to_char_type(c)))
+      {
+        str.push_back(Traits::to_char_type(c));
+        ++extracted;
+        c = is.rdbuf()->snextc();
+      }
+      if (Traits::eq_int_type(c, eof))
+        err |= ios_base::eofbit;
+      is.width(0);
+    }
+#if !defined(_LIBCPP_VERSION)
+    __catch(__cxxabiv1::__forced_unwind&)
+    {
+      is._M_setstate(ios_base::badbit);
+      __throw_exception_again;
+    }
+#endif
+    __catch(...)
+    { is._M_setstate(ios_base::badbit); }
+  }
+  if (!extracted)
+    err |= ios_base::failbit;
+  if (err)
+    is.setstate(err);
+  return is;
+}
+
+// from basic_string.tcc; the characters preceding the delimiter are appended
+// a run of the stream's get area at a time
+template <class CharT, class Traits, class Allocator>
+constexpr basic_istream<CharT, Traits>&
+getline(
+  basic_istream<CharT, Traits>& is,
+  basic_string<CharT, Traits, Allocator>& str,
+  CharT delim)
+{
+  using istream_type = basic_istream<CharT, Traits>;
+  using int_type     = typename istream_type::int_type;
+
+  streamsize extracted = 0;
+  ios_base::iostate err = ios_base::goodbit;
+  typename istream_type::sentry cerb(is, true);
+  if (cerb)
+  {
+    __try
+    {
+      str.clear();
+      const int_type eof = Traits::eof();
+      const int_type idelim = Traits::to_int_type(delim);
+      int_type c = eof;
+      extracted = is._M_copy_until(std::numeric_limits<streamsize>::max(),
+                                   idelim, c,
+                                   [&str](const CharT* p, streamsize len)
+                                   { str.append(p, len); });
+      if (Traits::eq_int_type(c, eof))
+        err |= ios_base::eofbit;
+      else if (Traits::eq_int_type(c, idelim))
+      {
+        ++extracted;
+        is.rdbuf()->sbumpc();
+      }
+      else
+        err |= ios_base::failbit;
+    }
+#if !defined(_LIBCPP_VERSION)
+    __catch(__cxxabiv1::__forced_unwind&)
+    {
+      is._M_setstate(ios_base::badbit);
+      __throw_exception_again;
+    }
+#endif
+    __catch(...)
+    { is._M_setstate(ios_base::badbit); }
+  }
+  if (!extracted)
+    err |= ios_base::failbit;
+  if (err)
+    is.setstate(err);
+  return is;
+}
+
+template <class CharT, class Traits, class Allocator>
+constexpr basic_istream<CharT, Traits>&
+getline(
+  basic_istream<CharT, Traits>& is,
+  basic_string<CharT, Traits, Allocator>& str)
+{
+  return cest::getline(is, str, is.widen('\n'));
 }
 
 using string    = basic_string<char>;
@@ -377,6 +510,19 @@ using u8string  = basic_string<char8_t>;
 using u16string = basic_string<char16_t>;
 using u32string = basic_string<char32_t>;
 
+namespace pmr {
+template <typename T> class polymorphic_allocator; // cest/memory_resource.hpp
+template <class CharT, class Traits = std::char_traits<CharT>>
+using basic_string =
+  cest::basic_string<CharT, Traits, polymorphic_allocator<CharT>>;
+
+using string    = basic_string<char>;
+using wstring   = basic_string<wchar_t>;
+using u8string  = basic_string<char8_t>;
+using u16string = basic_string<char16_t>;
+using u32string = basic_string<char32_t>;
+} // namespace pmr
+
 } // namespace cest
 
 #endif // _CEST_STRING_HPP_
@@ -1,6 +1,7 @@
 #ifndef _CEST_VECTOR_HPP_
 #define _CEST_VECTOR_HPP_
 
+#include "cest/instrument.hpp"
 #include <memory>  // std::allocator
 #include <cstddef>
 #include <algorithm>
@@ -30,6 +31,9 @@ public:
 
   constexpr vector() : m_size{}, m_capacity{}, m_p{}, m_alloc{} {}
 
+  explicit constexpr vector(const Allocator& alloc) noexcept
+    : m_size{}, m_capacity{}, m_p{}, m_alloc(alloc) {}
+
   constexpr void swap(vector& other)
   {
     using std::swap;
@@ -39,7 +43,9 @@ public:
     swap(m_alloc, other.m_alloc);
   }
 
-  constexpr vector(const vector& other) : vector()
+  constexpr vector(const vector& other)
+    : vector(std::allocator_traits<Allocator>::
+               select_on_container_copy_construction(other.m_alloc))
   {
     reserve(other.capacity());
     m_size = other.size();
@@ -101,6 +107,8 @@ public:
     return *this;
   }
 
+  constexpr allocator_type get_allocator() const noexcept { return m_alloc; }
+
   [[nodiscard]]
   constexpr bool            empty() const noexcept { return m_size == 0;  }
   constexpr size_type        size() const noexcept { return m_size;       }
@@ -109,6 +117,8 @@ public:
   {
     if (new_cap > m_capacity)
     {
+      impl::count(m_alloc, &alloc_stats::reallocations);
+      impl::count(m_alloc, &alloc_stats::relocated_elements, m_size);
       value_type *p = m_alloc.allocate(new_cap);
       for (size_type i = 0; i < m_size; i++)
         std::construct_at(&p[i], std::move_if_noexcept(m_p[i]));
@@ -204,6 +214,17 @@ public:
     std::construct_at(&m_p[m_size++],std::forward<T>(value));
   }
 
+  template <class... Args>
+  constexpr reference emplace_back(Args&&... args)
+  {
+    if (0 == m_capacity) {
+      reserve(1);
+    } else if (m_capacity == m_size) {
+      reserve(m_capacity * 2);
+    }
+    return *std::construct_at(&m_p[m_size++], std::forward<Args>(args)...);
+  }
+
   constexpr iterator erase(iterator first, iterator last)
   {
     iterator it1 = first, it2 = last;
@@ -228,6 +249,12 @@ operator==(const vector<_Tp, _Alloc>& __x, const vector<_Tp, _Alloc>& __y)
 { return (__x.size() == __y.size()
           && std::equal(__x.begin(), __x.end(), __y.begin())); }
 
+namespace pmr {
+template <typename T> class polymorphic_allocator; // cest/memory_resource.hpp
+template <class T>
+using vector = cest::vector<T, polymorphic_allocator<T>>;
+} // namespace pmr
+
 } // namespace cest
 
 #endif // _CEST_VECTOR_HPP_
@@ -1,6 +1,17 @@
 #ifndef _CEST_ALLOCATOR_TESTS_HPP_
 #define _CEST_ALLOCATOR_TESTS_HPP_
 
+#include "cest/arena.hpp"
+#include "cest/vector.hpp"
+#include "cest/string.hpp"
+#include "cest/list.hpp"
+#include "cest/forward_list.hpp"
+#include "cest/map.hpp"
+#include "cest/set.hpp"
+#include "cest/deque.hpp"
+#include "cest/circular_buffer.hpp"
+#include <numeric>
+#include <cstdint>
 #include <cassert>
 #include <memory>
 
@@ -75,6 +86,109 @@ constexpr void tests_helper()
   }
 }
 
+template <typename T>
+using mono_t = cest::monotonic_allocator<T>;
+
+// Each cest container, with its storage drawn from one arena
+constexpr bool arena_test1()
+{
+  cest::arena a(1024);
+  bool b1 = 0==a.block_count();
+
+  cest::vector<int, mono_t<int>> v{mono_t<int>(a)};
+  for (int i = 0; i < 100; ++i)
+    v.push_back(i);
+  cest::basic_string<char, std::char_traits<char>, mono_t<char>>
+    s("Fire and Brimstone!", mono_t<char>(a));
+  cest::list<int, mono_t<int>> l{mono_t<int>(a)};
+  cest::forward_list<int, mono_t<int>> fl{mono_t<int>(a)};
+  for (int i = 0; i < 10; ++i) {
+    l.push_back(i);
+    fl.push_front(i);
+  }
+  using pair_t = std::pair<const int, char>;
+  cest::map<int, char, std::less<int>, mono_t<pair_t>> m{mono_t<pair_t>(a)};
+  cest::set<int, std::less<int>, mono_t<int>> st{mono_t<int>(a)};
+  for (int i = 0; i < 10; ++i) {
+    m.insert({i, char('a' + i)});
+    st.insert(9 - i);
+  }
+  cest::deque<int, mono_t<int>> d{mono_t<int>(a)};
+  cest::circular_buffer<int, mono_t<int>> cb{mono_t<int>(a)};
+  for (int i = 0; i < 10; ++i) {
+    d.push_front(i);
+    cb.push_front(i);
+  }
+
+  // a copy allocates from the same arena
+  auto v2 = v;
+  auto m2 = m;
+  bool b2 = v2.get_allocator()==v.get_allocator() &&
+            m2.get_allocator().get_arena()==&a;
+  bool b3 = 4950==std::accumulate(v2.begin(), v2.end(), 0) &&
+            19==s.size() && 45==std::accumulate(l.begin(), l.end(), 0) &&
+            9==fl.front() && 'a'==m2.begin()->second && 10==m2.size() &&
+            0==*st.begin() && 9==d.front() &&
+            9==cb.front() && d.get_allocator().get_arena()==&a;
+  return b1 && b2 && b3 && a.block_count() > 0;
+}
+
+// Many allocations share a block; and all are released together
+constexpr bool arena_test2()
+{
+  cest::arena a(64 * sizeof(double));
+  mono_t<double> alloc(a);
+  double* p = alloc.allocate(4);
+  bool b1 = 1==a.block_count();
+  for (int i = 0; i < 15; ++i) {
+    double* q = alloc.allocate(4);
+    std::construct_at(q, 42.0);
+    b1 = b1 && q != p;
+    alloc.deallocate(q, 4); // a no-op
+  }
+  bool b2 = 1==a.block_count();
+  (void)alloc.allocate(1);    // a second block
+  (void)alloc.allocate(1000); // a block of its own
+  bool b3 = 3==a.block_count();
+  a.release();
+  bool b4 = 0==a.block_count();
+  cest::vector<double, mono_t<double>> v(alloc);
+  v.push_back(42.0);
+  return b1 && b2 && b3 && b4 && 1==a.block_count() && 42.0==v[0];
+}
+
+// Over-aligned types are aligned within a block; at runtime
+bool arena_test3()
+{
+  struct alignas(64) big { char c; };
+  cest::arena a(1024);
+  mono_t<char> ac(a);
+  mono_t<big> ab(a);
+  bool b = true;
+  for (int i = 0; i < 20; ++i) {
+    (void)ac.allocate(1);
+    auto p = reinterpret_cast<std::uintptr_t>(ab.allocate(1));
+    b = b && 0 == p % 64;
+  }
+  return b;
+}
+
+// A size in bytes which would overflow throws; as with std::allocator
+bool arena_test4()
+{
+  cest::arena a(1024);
+  const std::size_t max = std::size_t(-1);
+  int thrown = 0;
+  try { (void)a.allocate<double>(max / sizeof(double) + 1); }
+  catch (const std::bad_array_new_length&) { ++thrown; }
+  (void)a.allocate<char>(1);  // so that the current block is bumped
+  try { (void)a.allocate_bytes(max - 4, 8); }
+  catch (const std::bad_array_new_length&) { ++thrown; }
+  try { (void)mono_t<int>(a).allocate(max / 2); }
+  catch (const std::bad_array_new_length&) { ++thrown; }
+  return 3 == thrown && 1 == a.block_count();
+}
+
 } // namespae alloc_tests
 
 void allocator_tests()
@@ -82,6 +196,16 @@ void allocator_tests()
   using namespace alloc_tests;
 
   tests_helper<CONSTEXPR_CEST,std::allocator<int>>();  // true: constexpr tests
+  tests_helper<CONSTEXPR_CEST,cest::monotonic_allocator<int>>();
+
+#if CONSTEXPR_CEST == 1
+  static_assert(arena_test1());
+  static_assert(arena_test2());
+#endif
+  assert(arena_test1());
+  assert(arena_test2());
+  assert(arena_test3());
+  assert(arena_test4());
 }
 
 #endif // _CEST_ALLOCATOR_TESTS_HPP_
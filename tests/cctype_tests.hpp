@@ -5,6 +5,35 @@
 #include <cctype>
 #include <cassert>
 #include <limits>
+#include <cstdio> // EOF
+
+// Each character of the (constexpr) string, classified as a bitmask
+constexpr unsigned cctype_classes(const char* s)
+{
+  unsigned r = 0;
+  for (; *s; ++s)
+    r = r << 4 | (cest::isalpha(*s) ? 1 : 0) | (cest::isdigit(*s) ? 2 : 0) |
+                 (cest::isspace(*s) ? 4 : 0) | (cest::ispunct(*s) ? 8 : 0);
+  return r;
+}
+
+constexpr bool cctype_scan_test()
+{
+  const char s[] = "   \t\nident_42 = 0x1F; // a comment that goes on and on";
+  const char* e = s + sizeof s - 1;
+  const char* p1 = cest::scan_not(cest::ctype_base::space, s, e);
+  const char* p2 = cest::scan_not(cest::ctype_base::alnum, p1, e);
+  const char* p3 = cest::scan_is(cest::ctype_base::punct, p2 + 1, e);
+  const char* p4 = cest::scan_is(cest::ctype_base::xdigit | cest::ctype_base::cntrl,
+                                 s + 30, e);
+  cest::ctype_base::mask m[4]{};
+  cest::is(p1, p1 + 4, m);
+  return p1 == s + 5 && p2 == s + 10 && p3 == s + 14 && p4 == s + 31 &&
+         cest::scan_is(cest::ctype_base::digit, p4, e) == e &&
+         m[0] == (cest::ctype_base::alpha | cest::ctype_base::lower |
+                  cest::ctype_base::alnum | cest::ctype_base::print |
+                  cest::ctype_base::graph);
+}
 
 void cctype_tests()
 {
@@ -15,6 +44,11 @@ void cctype_tests()
   static_assert(cest::isupper('W') != 0);
   static_assert(cest::isupper('a') == 0);
   static_assert(cest::isupper('!') == 0);
+
+  static_assert(cctype_classes("a1 ;") == 0x1248);
+  static_assert(cest::tolower('Q') == 'q' && cest::toupper('q') == 'Q');
+  static_assert(cest::isxdigit(EOF) == 0 && cest::tolower(EOF) == EOF);
+  static_assert(cctype_scan_test());
 #endif
 
   assert( std::isalnum('q') != 0);
@@ -33,6 +67,40 @@ void cctype_tests()
     assert(std::isalnum(c) == cest::isalnum(c));
     if (c == std::numeric_limits<char>::max()) break;
   }
+
+  // Only non-zero is specified; GCC's builtin isdigit returns 1, for one
+  for (int c = EOF; c <= std::numeric_limits<unsigned char>::max(); ++c) {
+    assert(!std::isalpha(c)  == !cest::isalpha(c));
+    assert(!std::isblank(c)  == !cest::isblank(c));
+    assert(!std::iscntrl(c)  == !cest::iscntrl(c));
+    assert(!std::isdigit(c)  == !cest::isdigit(c));
+    assert(!std::isgraph(c)  == !cest::isgraph(c));
+    assert(!std::islower(c)  == !cest::islower(c));
+    assert(!std::isprint(c)  == !cest::isprint(c));
+    assert(!std::ispunct(c)  == !cest::ispunct(c));
+    assert(!std::isspace(c)  == !cest::isspace(c));
+    assert(!std::isupper(c)  == !cest::isupper(c));
+    assert(!std::isxdigit(c) == !cest::isxdigit(c));
+    assert(std::tolower(c)  == cest::tolower(c));
+    assert(std::toupper(c)  == cest::toupper(c));
+  }
+
+  assert(cctype_scan_test());
+  // Every byte, at every alignment: the runtime scan finds the first match
+  char all[256 + 16];
+  for (int i = 0; i < 256 + 16; ++i) all[i] = char(i);
+  for (unsigned m = 1; m <= 0xffff; m <<= 1)
+    for (int off = 0; off < 16; ++off)
+      for (const char* e = all + off; e <= all + sizeof all; e += 7) {
+        const char* p = all + off;
+        const char* q1 = p;
+        const char* q2 = p;
+        cest::ctype_base::mask mk = 0;
+        while (q1 != e && (cest::is(q1, q1 + 1, &mk), !(mk & m))) ++q1;
+        while (q2 != e && (cest::is(q2, q2 + 1, &mk), mk & m)) ++q2;
+        assert(cest::scan_is(m, p, e) == q1);
+        assert(cest::scan_not(m, p, e) == q2);
+      }
 }
 
 #endif // _CEST_CCTYPE_TESTS_HPP_
@@ -4,6 +4,8 @@
 
 // Copyright (c) 2020-2021 Paul Keir, University of the West of Scotland.
 
+#include "embedded_files.hpp" // first: cest::embedded_files is specialised
+
 #include "vector_tests.hpp"
 #include "forward_list_tests.hpp"
 #include "list_tests.hpp"
@@ -13,12 +15,19 @@
 #include "cctype_tests.hpp"
 #include "deque_tests.hpp"
 #include "queue_tests.hpp"
+#include "stack_tests.hpp"
+#include "circular_buffer_tests.hpp"
 #include "iterator_tests.hpp"
 #include "algorithm_tests.hpp"
 #include "numeric_tests.hpp"
 #include "iostream_tests.hpp"
 #include "allocator_tests.hpp"
 #include "stringstream_tests.hpp"
+#include "ostream_tests.hpp"
+#include "istream_tests.hpp"
+#include "spanstream_tests.hpp"
+#include "fstream_tests.hpp"
+#include "mmapbuf_tests.hpp"
 #include "array_tests.hpp"
 #include "cstdio_tests.hpp"
 #include "cstdlib_tests.hpp"
@@ -26,7 +35,12 @@
 #include "utility_tests.hpp"
 #include "cmath_tests.hpp"
 #include "complex_tests.hpp"
+#include "format_tests.hpp"
+#include "charconv_tests.hpp"
 #include "functional_tests.hpp"
+#include "concurrent_queue_tests.hpp"
+#include "memory_resource_tests.hpp"
+#include "instrument_tests.hpp"
 
 int main(int argc, char *argv[])
 {
@@ -39,12 +53,19 @@ int main(int argc, char *argv[])
   cctype_tests();
   deque_tests();
   queue_tests();
+  stack_tests();
+  circular_buffer_tests();
   iterator_tests();
   algorithm_tests();
   numeric_tests();
   iostream_tests();
   allocator_tests();
   stringstream_tests();
+  ostream_tests();
+  istream_tests();
+  spanstream_tests();
+  fstream_tests();
+  mmapbuf_tests();
   array_tests();
   cstdio_tests();
   cstdlib_tests();
@@ -52,7 +73,12 @@ int main(int argc, char *argv[])
   utility_tests();
   cmath_tests();
   complex_tests();
+  format_tests();
+  charconv_tests();
   functional_tests();
+  concurrent_queue_tests();
+  memory_resource_tests();
+  instrument_tests();
 
   return 0;
 }
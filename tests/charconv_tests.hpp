@@ -0,0 +1,172 @@
+#ifndef _CEST_CHARCONV_TESTS_HPP_
+#define _CEST_CHARCONV_TESTS_HPP_
+
+#include "cest/charconv.hpp"
+#include <charconv>
+#include <bit>          // std::bit_cast
+#include <string_view>
+#include <system_error>
+#include <climits>
+#include <cstdint>
+#include <limits>
+#include <cassert>
+
+// The expected output is that of std::to_chars and std::from_chars
+namespace cc_tests {
+
+template <typename T, typename... Args>
+constexpr bool to_chars_is(std::string_view s, T value, Args... args)
+{
+  char buf[64]{};
+  auto [p, ec] = cest::to_chars(buf, buf + sizeof buf, value, args...);
+  return ec == std::errc{} && std::string_view(buf, p - buf) == s;
+}
+
+template <typename T, typename... Args>
+constexpr bool from_chars_is(std::string_view s, T expected, int used,
+                             Args... args)
+{
+  T value{};
+  auto [p, ec] = cest::from_chars(s.data(), s.data() + s.size(), value,
+                                  args...);
+  return ec == std::errc{} && value == expected && p - s.data() == used;
+}
+
+constexpr bool to_chars_int_test()
+{
+  bool b1 = to_chars_is("0", 0) && to_chars_is("-42", -42) &&
+            to_chars_is("1234567890", 1234567890u) &&
+            to_chars_is("-128", (signed char)-128);
+  bool b2 = to_chars_is("-9223372036854775808", LLONG_MIN) &&
+            to_chars_is("18446744073709551615", ULLONG_MAX);
+  bool b3 = to_chars_is("ff", 255, 16) && to_chars_is("-101", -5, 2) &&
+            to_chars_is("zz", 1295, 36) && to_chars_is("777", 511u, 8);
+
+  char buf[4]{};
+  auto [p, ec] = cest::to_chars(buf, buf + 4, 12345);
+  bool b4 = ec == std::errc::value_too_large && p == buf + 4;
+  return b1 && b2 && b3 && b4;
+}
+
+constexpr bool to_chars_float_test()
+{
+  bool b1 = to_chars_is("0.1", 0.1) && to_chars_is("1e+22", 1e22) &&
+            to_chars_is("123456.789", 123456.789) &&
+            to_chars_is("5e-324", 4.9406564584124654e-324) &&
+            to_chars_is("1.7976931348623157e+308", 1.7976931348623157e308) &&
+            to_chars_is("0.3", 0.3f) && to_chars_is("-0", -0.0);
+  bool b2 = to_chars_is("100000000000000000000", 1e20,
+                        std::chars_format::fixed) &&
+            to_chars_is("1.5e+00", 1.5, std::chars_format::scientific) &&
+            to_chars_is("1e+06", 1e6, std::chars_format::general) &&
+            to_chars_is("1.8p+0", 1.5, std::chars_format::hex);
+  bool b3 = to_chars_is("3.142", 3.14159, std::chars_format::fixed, 3) &&
+            to_chars_is("1.23e-05", 1.2345e-5, std::chars_format::scientific,
+                        2) &&
+            to_chars_is("0.000123", 0.000123456, std::chars_format::general, 3) &&
+            to_chars_is("1.000p+0", 1.0, std::chars_format::hex, 3) &&
+            to_chars_is("0.d9c7dcp-126", 1e-38f, std::chars_format::hex);
+  const double inf = std::numeric_limits<double>::infinity();
+  bool b4 = to_chars_is("inf", inf) && to_chars_is("-inf", -inf) &&
+            to_chars_is("nan", std::numeric_limits<double>::quiet_NaN());
+  return b1 && b2 && b3 && b4;
+}
+
+constexpr bool from_chars_int_test()
+{
+  bool b1 = from_chars_is("42abc", 42, 2) && from_chars_is("-17", -17, 3) &&
+            from_chars_is("ff", 255, 2, 16) && from_chars_is("Zz", 1295, 2, 36) &&
+            from_chars_is("18446744073709551615", ULLONG_MAX, 20);
+
+  int i = 7;
+  const char s1[] = "99999999999 ";
+  auto [p1, ec1] = cest::from_chars(s1, s1 + 12, i);
+  bool b2 = ec1 == std::errc::result_out_of_range && p1 == s1 + 11 && i == 7;
+  unsigned u = 7;
+  const char s2[] = "-5";
+  auto [p2, ec2] = cest::from_chars(s2, s2 + 2, u);
+  bool b3 = ec2 == std::errc::invalid_argument && p2 == s2 && u == 7;
+  auto [p3, ec3] = cest::from_chars(s1, s1 + 2, i, 8); // no octal 9
+  return b1 && b2 && b3 && ec3 == std::errc::invalid_argument && i == 7;
+}
+
+constexpr bool from_chars_float_test()
+{
+  bool b1 = from_chars_is("0.1", 0.1, 3) && from_chars_is("1e22x", 1e22, 4) &&
+            from_chars_is("-2.5E-3", -2.5e-3, 7) &&
+            from_chars_is("4.9406564584124654e-324", 4.9406564584124654e-324,
+                          23) &&
+            from_chars_is("0.30000000000000004", 0.30000000000000004, 19) &&
+            from_chars_is("3.4028235e38", 3.4028235e38f, 12);
+  // Correctly rounded: halfway between 1 and the next double, then just over
+  bool b2 = from_chars_is("1.00000000000000011102230246251565404236316680908203125",
+                          1.0, 55) &&
+            from_chars_is("1.00000000000000011102230246251565404236316680908203126",
+                          1.0000000000000002, 55);
+  bool b3 = from_chars_is("1.5e3", 1.5, 3, std::chars_format::fixed) &&
+            from_chars_is("1.8p+1", 3.0, 6, std::chars_format::hex) &&
+            from_chars_is("1e", 1.0, 1) &&
+            from_chars_is("-Infinity", -std::numeric_limits<double>::infinity(),
+                          9);
+  // A sign after the digits ends the number
+  bool b6 = from_chars_is("1+2", 1.0, 1) && from_chars_is("-1-2", -1.0, 2) &&
+            from_chars_is("79+16e562", 79.0, 2) &&
+            from_chars_is("2.5e+3-1", 2.5e3, 6);
+
+  double d = 7;
+  const char s1[] = "1e400";
+  auto [p1, ec1] = cest::from_chars(s1, s1 + 5, d);
+  bool b4 = ec1 == std::errc::result_out_of_range && p1 == s1 + 5 && d == 7;
+  const char s2[] = "+1";
+  auto [p2, ec2] = cest::from_chars(s2, s2 + 2, d);
+  bool b5 = ec2 == std::errc::invalid_argument && p2 == s2 && d == 7;
+  const char s3[] = "15";
+  auto [p3, ec3] = cest::from_chars(s3, s3 + 2, d,
+                                    std::chars_format::scientific);
+  return b1 && b2 && b3 && b4 && b5 && b6 &&
+         ec3 == std::errc::invalid_argument;
+}
+
+// Runtime only: a shortest round trip, compared with std::to_chars
+bool charconv_round_trip_test()
+{
+  std::uint64_t x = 0x9e3779b97f4a7c15;
+  for (int i = 0; i < 5000; ++i)
+  {
+    x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+    double d = std::bit_cast<double>(x);
+    if (d != d)
+      continue;
+    char b1[64], b2[64];
+    char* e1 = cest::to_chars(b1, b1 + 64, d).ptr;
+    char* e2 = std::to_chars(b2, b2 + 64, d).ptr;
+    double r = 0;
+    cest::from_chars(b1, e1, r);
+    if (std::string_view(b1, e1 - b1) != std::string_view(b2, e2 - b2) ||
+        r != d)
+      return false;
+  }
+  return true;
+}
+
+} // namespace cc_tests
+
+void charconv_tests()
+{
+  using namespace cc_tests;
+
+  assert(to_chars_int_test());
+  assert(to_chars_float_test());
+  assert(from_chars_int_test());
+  assert(from_chars_float_test());
+  assert(charconv_round_trip_test());
+
+#if CONSTEXPR_CEST == 1
+  static_assert(to_chars_int_test());
+  static_assert(to_chars_float_test());
+  static_assert(from_chars_int_test());
+  static_assert(from_chars_float_test());
+#endif
+}
+
+#endif // _CEST_CHARCONV_TESTS_HPP_
@@ -0,0 +1,155 @@
+#ifndef _CEST_CIRCULAR_BUFFER_TESTS_HPP_
+#define _CEST_CIRCULAR_BUFFER_TESTS_HPP_
+
+#include "cest/circular_buffer.hpp"
+#include "cest/queue.hpp"
+#include "cest/stack.hpp"
+#include "deque_tests.hpp"
+#include "queue_tests.hpp"
+#include "stack_tests.hpp"
+#include "../tests/tests_util.hpp"
+#include <deque>
+#include <queue>
+#include <algorithm>
+#include <cassert>
+
+// The front of the queue wraps around the end of the storage; which is then
+// grown while wrapped.
+template <typename D>
+constexpr bool circular_buffer_test1()
+{
+  D d;
+  bool b1 = true;
+  for (int i = 0; i < 100; ++i) {
+    d.push_back(i);
+    d.push_back(i);
+    d.pop_front();
+    b1 = b1 && i==d.back() && (i+1)/2==d.front();
+  }
+  for (int i = 0; i < 20; ++i)
+    d.push_front(-i);
+  bool b2 = 120==d.size() && -19==d.front() && 99==d.back() && 50==d[20];
+  int sum = 0;
+  for (auto x : d)
+    sum += x;
+  return b1 && b2 && 7260==sum;
+}
+
+// Random access iterators
+template <typename D>
+constexpr bool circular_buffer_test2()
+{
+  D d;
+  for (int i = 0; i < 10; ++i) {
+    d.push_front(i);
+    d.push_back(i * 7 % 10);
+  }
+  std::sort(d.begin(), d.end());
+  bool b1 = std::is_sorted(d.begin(), d.end()) && 0==d[0] && 9==d[19];
+  auto it = d.begin() + 10;
+  bool b2 = 10==it - d.begin() && it[-1]==*(it - 1) && d.end() > it;
+  bool b3 = *d.rbegin()==9 && 20==std::count_if(d.cbegin(), d.cend(),
+                                                [](int x) { return x < 10; });
+  return b1 && b2 && b3;
+}
+
+// The capacity is a power of two; and a reserved ring never reallocates
+constexpr bool circular_buffer_test3()
+{
+  cest::circular_buffer<int> d;
+  bool b1 = 0==d.capacity();
+  d.reserve(100);
+  bool b2 = 128==d.capacity();
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i < 128; ++i)
+      d.push_back(i);
+    for (int i = 0; i < 100; ++i)
+      d.pop_front();
+    for (int i = 0; i < 28; ++i)
+      d.pop_back();
+  }
+  bool b3 = 128==d.capacity() && d.empty();
+  cest::ring_deque<int> e{1, 2, 3};
+  e.swap(d);
+  return b1 && b2 && b3 && 3==d.size() && 2==d[1] && e.empty();
+}
+
+// Breadth-first search of a 2D grid: the distance to each cell from a corner
+template <typename Q>
+constexpr int circular_buffer_bfs_test(int n)
+{
+  Q q;
+  cest::vector<int> dist(n * n); // n.b. the distance to v is dist[v] - 1
+  dist[0] = 1;
+  q.push(0);
+  while (!q.empty()) {
+    const int v = q.front();
+    q.pop();
+    const int x = v % n, y = v / n;
+    const int nbrs[]{x > 0 ? v - 1 : -1, x < n-1 ? v + 1 : -1,
+                     y > 0 ? v - n : -1, y < n-1 ? v + n : -1};
+    for (int w : nbrs) {
+      if (w >= 0 && !dist[w]) {
+        dist[w] = dist[v] + 1;
+        q.push(w);
+      }
+    }
+  }
+  int sum = 0;
+  for (int d : dist)
+    sum += d - 1;
+  return sum;
+}
+
+void circular_buffer_tests()
+{
+  using namespace tests_util;
+  using cb_t = cest::circular_buffer<int>;
+
+#if CONSTEXPR_CEST == 1
+  static_assert(deque_test1<cb_t>());
+  static_assert(deque_test2<cb_t>());
+  static_assert(deque_test3<cb_t>());
+  static_assert(deque_test4<cb_t>());
+  static_assert(deque_test5<cb_t>());
+  static_assert(push_back_dtor_test<cest::circular_buffer<Bar<>>>());
+  static_assert(push_front_dtor_test<cest::circular_buffer<Bar<>>>());
+  static_assert(circular_buffer_test1<cb_t>());
+  static_assert(circular_buffer_test2<cb_t>());
+  static_assert(circular_buffer_test3());
+
+  static_assert(queue_test1<cest::queue<int,cb_t>>());
+  static_assert(queue_test2<cest::queue<int,cb_t>>());
+  static_assert(push_dtor_test<
+    cest::queue<Bar<>,cest::circular_buffer<Bar<>>>>());
+  static_assert(stack_test1<cest::stack<int,cb_t>>());
+  static_assert(priority_queue_test1<
+    cest::priority_queue<int,cb_t>>());
+  static_assert(circular_buffer_bfs_test<cest::queue<int,cb_t>>(8) ==
+                circular_buffer_bfs_test<cest::queue<int>>(8));
+#endif
+
+  assert((deque_test1<cb_t>()));
+  assert((deque_test2<cb_t>()));
+  assert((deque_test3<cb_t>()));
+  assert((deque_test4<cb_t>()));
+  assert((deque_test5<cb_t>()));
+  assert(push_back_dtor_test<cest::circular_buffer<Bar<>>>());
+  assert(push_front_dtor_test<cest::circular_buffer<Bar<>>>());
+  assert((circular_buffer_test1< std::deque<int>>()));
+  assert((circular_buffer_test1<cb_t>()));
+  assert((circular_buffer_test2< std::deque<int>>()));
+  assert((circular_buffer_test2<cb_t>()));
+  assert(circular_buffer_test3());
+
+  assert((queue_test1<cest::queue<int,cb_t>>()));
+  assert((queue_test1< std::queue<int,cb_t>>()));
+  assert((queue_test2<cest::queue<int,cb_t>>()));
+  assert((push_dtor_test<cest::queue<Bar<>,cest::circular_buffer<Bar<>>>>()));
+  assert((stack_test1<cest::stack<int,cb_t>>()));
+  assert((priority_queue_test1<cest::priority_queue<int,cb_t>>()));
+  assert((circular_buffer_bfs_test<cest::queue<int,cb_t>>(32) ==
+          circular_buffer_bfs_test< std::queue<int>>(32)));
+}
+
+#endif // _CEST_CIRCULAR_BUFFER_TESTS_HPP_
@@ -4,6 +4,8 @@
 #include "tests_util.hpp"
 #include <cest/cmath.hpp>
 #include <cmath>
+#include <cstdint>
+#include <bit>
 #include <cassert>
 
 template <typename T, typename F1, typename F2, typename F3>
@@ -18,6 +20,158 @@ constexpr bool cmath_test1(F1 abs, F2 atan, F3 sqrt)
   return b1 && b2;
 }
 
+// Within 1 ulp, or so, of the correctly rounded result
+template <typename T>
+constexpr bool close(const T x, const T y)
+{
+  const T d = x < y ? y - x : x - y;
+  return d <= (y < 0 ? -y : y) * T{0x1p-52};
+}
+
+template <typename T, typename F1, typename F2, typename F3, typename F4,
+          typename F5>
+constexpr bool cmath_test2(F1 sqrt, F2 sin, F3 cos, F4 exp, F5 log)
+{
+  bool b1 = sqrt(T{2}) == T{1.4142135623730951} &&
+            sqrt(T{1e-310}) == T{9.9999999999999857e-156} &&
+            sqrt(T{-1}) != sqrt(T{-1});
+  bool b2 = close(sin(T{1}), T{0.8414709848078965}) &&
+            close(cos(T{1e6}), T{0.93675212753314474}) &&
+            close(sin(T{1e22}), T{-0.85220084976718879});
+  bool b3 = close(exp(T{-2.5}), T{0.0820849986238988}) &&
+            close(exp(T{700}), T{1.0142320547350045e+304}) &&
+            exp(T{-750}) == 0 && exp(T{0}) == 1;
+  bool b4 = close(log(T{10}), T{2.3025850929940459}) &&
+            close(log(T{1e-310}), T{-713.80137882815416}) && log(T{1}) == 0;
+  return b1 && b2 && b3 && b4;
+}
+
+template <typename T, typename F1, typename F2, typename F3, typename F4,
+          typename F5>
+constexpr bool cmath_test3(F1 atan, F2 atan2, F3 pow, F4 sinh, F5 cosh)
+{
+  bool b1 = close(atan(T{0.5}), T{0.46364760900080609}) &&
+            close(atan2(T{1}, T{-2}), T{2.677945044588987}) &&
+            atan2(T{-0.0}, T{1}) == 0 &&
+            atan2(T{0x1.7b0166d580702p+6}, T{-0x1.1cca939f7e7f8p+5}) ==
+              T{0x1.ee20d01b6a432p+0};
+  bool b2 = close(pow(T{2}, T{0.5}), T{1.4142135623730951}) &&
+            close(pow(T{1.0000001}, T{1e7}), T{2.7182816941320818}) &&
+            pow(T{-2}, T{-3}) == T{-0.125} &&
+            close(pow(T{10}, T{-300.5}), T{3.1622776601683794e-301}) &&
+            pow(T{-8}, T{1}/3) != pow(T{-8}, T{1}/3);
+  bool b3 = close(sinh(T{0.3}), T{0.3045202934471426}) &&
+            close(cosh(T{5}), T{74.209948524787848}) &&
+            cosh(T{0x1.97bed3028e6ep-1}) == T{0x1.558fe2b734dcap+0} &&
+            sinh(T{0x1.02625b4b09c4p+0}) == T{0x1.308b2b30ea7afp+0} &&
+            sinh(T{0x1.628a626d95088p+9}) == T{0x1.fbb2ce968a717p+1021};
+  return b1 && b2 && b3;
+}
+
+template <typename T, typename F1, typename F2, typename F3, typename F4,
+          typename F5, typename F6, typename F7, typename F8>
+constexpr bool cmath_test4(F1 tan, F2 asin, F3 acos, F4 exp2, F5 log2,
+                           F6 log10, F7 cbrt, F8 hypot)
+{
+  bool b1 = close(tan(T{1}), T{1.5574077246549023}) &&
+            close(tan(T{1e22}), T{-1.6287782256068988}) &&
+            close(asin(T{0.3}), T{0.30469265401539752}) &&
+            close(acos(T{-0.7}), T{2.3461938234056494}) &&
+            close(acos(T{0.99}), T{0.14153947332442729}) &&
+            asin(T{1.5}) != asin(T{1.5});
+  bool b2 = close(exp2(T{-3.3}), T{0.10153154954452945}) &&
+            exp2(T{10}) == 1024 && exp2(T{-1074}) == T{0x1p-1074} &&
+            close(log2(T{3}), T{1.5849625007211561}) && log2(T{0x1p-1060}) == -1060 &&
+            close(log10(T{2e-300}), T{-299.69897000433605}) &&
+            log10(T{1000}) == 3;
+  bool b3 = close(cbrt(T{10}), T{2.1544346900318838}) && close(cbrt(T{-27}), T{-3}) &&
+            close(hypot(T{1e300}, T{3e300}), T{3.1622776601683795e+300}) &&
+            hypot(T{3e-320}, T{4e-320}) == T{4.999944335913415e-320} &&
+            hypot(T{-3}, T{4}) == 5;
+  return b1 && b2 && b3;
+}
+
+// ceil, floor, round, trunc, fmod and fma are exact; for each type
+template <typename T>
+constexpr bool cmath_exact_test()
+{
+  using cest::ceil, cest::floor, cest::round, cest::trunc;
+  const T big = T{0x1p60}, half = T{0.5};
+  bool b1 = floor(T{-2.5}) == -3 && ceil(T{-2.5}) == -2 &&
+            round(T{-2.5}) == -3 && trunc(T{-2.5}) == -2 &&
+            floor(T{2.5}) == 2 && ceil(T{2.5}) == 3 && round(T{2.5}) == 3 &&
+            round(T{0.49999997}) == 0 && round(-half) == -1 &&
+            ceil(T{1e-30}) == 1 && floor(T{-1e-30}) == -1;
+  bool b2 = floor(big + 1) == big + 1 && round(T{8388609}) == 8388609 &&
+            floor(T{-0.0}) == 0 && std::signbit(ceil(T{-0.5})) &&
+            std::signbit(trunc(T{-0.9})) && !std::signbit(round(T{0.3}));
+  bool b3 = cest::fmod(T{7.5}, T{2}) == T{1.5} &&
+            cest::fmod(T{-7.5}, T{2}) == T{-1.5} &&
+            cest::fmod(big, T{3}) == 1 && cest::fmod(2 * big, T{-7}) == 2 &&
+            cest::fmod(T{1}, T{0}) != cest::fmod(T{1}, T{0});
+  // 1 + 2^-23 squared is 1 + 2^-22 + 2^-46; less 1, exact
+  const T e = T{0x1p-23};
+  bool b4 = cest::fma(1 + e, 1 + e, T{-1}) == 2 * e + e * e &&
+            cest::fma(T{2}, T{3}, T{4}) == 10 &&
+            cest::fma(T{0.1}, T{10}, T{-1}) != 0;
+  return b1 && b2 && b3 && b4;
+}
+
+// Runtime only: the constexpr algorithms, against those of libm
+bool cmath_ulp_test()
+{
+  auto ulps = [](double x, double y) {
+    auto ord = [](double d) {
+      const std::int64_t i = std::bit_cast<std::int64_t>(d);
+      return i < 0 ? INT64_MIN - i : i;
+    };
+    const std::int64_t d = ord(x) - ord(y);
+    return d < 0 ? -d : d;
+  };
+  std::uint64_t r = 0x9e3779b97f4a7c15;
+  auto next = [&r] { r ^= r << 13; r ^= r >> 7; r ^= r << 17; return r; };
+  for (int i = 0; i < 2000; ++i)
+  {
+    const double u = (next() >> 11) * 0x1p-53;         // [0,1)
+    double x = std::bit_cast<double>(next() >> 1);     // any positive
+    if (x != x || x == HUGE_VAL)
+      x = 0.5;
+    const double t = (2 * u - 1) * 20;
+    if (ulps(cest::impl::__sqrt(x), std::sqrt(x)) > 0 ||
+        ulps(cest::impl::__sin(x), std::sin(x)) > 1 ||
+        ulps(cest::impl::__cos(t), std::cos(t)) > 1 ||
+        ulps(cest::impl::__exp(t * 30), std::exp(t * 30)) > 1 ||
+        ulps(cest::impl::__log(x), std::log(x)) > 1 ||
+        ulps(cest::impl::__atan(t), std::atan(t)) > 1 ||
+        ulps(cest::impl::__atan2(t, u - 0.5), std::atan2(t, u - 0.5)) > 1 ||
+        ulps(cest::impl::__pow(u * 4, t * 10), std::pow(u * 4, t * 10)) > 1)
+      return false;
+    const double y = std::bit_cast<double>(next());
+    if (ulps(cest::impl::__tan(t), std::tan(t)) > 1 ||
+        ulps(cest::impl::__asin(u), std::asin(u)) > 1 ||
+        ulps(cest::impl::__acos(u - 0.5), std::acos(u - 0.5)) > 1 ||
+        ulps(cest::impl::__exp2(t * 50), std::exp2(t * 50)) > 1 ||
+        ulps(cest::impl::__log2(x), std::log2(x)) > 1 ||
+        ulps(cest::impl::__log10(x), std::log10(x)) > 1 ||
+        ulps(cest::impl::__cbrt(t * x),  // glibc's cbrt can be 2 ulp out
+             double(std::cbrt((long double)(t * x)))) > 1 ||
+        ulps(cest::impl::__hypot(t, u * 1e-8), std::hypot(t, u * 1e-8)) > 1)
+      return false;
+    if (y != y)
+      continue;
+    if (cest::fma(t, y, x) != std::fma(t, y, x) ||
+        cest::impl::__fma(t, y, x) != std::fma(t, y, x) ||
+        cest::impl::__fma(x, u, -x * u) != std::fma(x, u, -x * u) ||
+        cest::impl::__fmod(y, x) != std::fmod(y, x) ||
+        cest::round(y * u) != std::round(y * u) ||
+        cest::floor(t * 1e6) != std::floor(t * 1e6) ||
+        cest::ceil(float(t)) != std::ceil(float(t)) ||
+        cest::trunc(t * 1e6L) != std::trunc(t * 1e6L))
+      return false;
+  }
+  return true;
+}
+
 void cmath_tests()
 {
   // function pointers
@@ -28,12 +182,77 @@ void cmath_tests()
   constexpr auto cest_atan_d = static_cast<double(*)(double)>(cest::atan);
   constexpr auto cest_sqrt_d = static_cast<double(*)(double)>(cest::sqrt);
 
+  auto std_sin_d = static_cast<double(*)(double)>(std::sin);
+  auto std_cos_d = static_cast<double(*)(double)>(std::cos);
+  auto std_exp_d = static_cast<double(*)(double)>(std::exp);
+  auto std_log_d = static_cast<double(*)(double)>(std::log);
+  auto std_atan2_d = static_cast<double(*)(double,double)>(std::atan2);
+  auto std_pow_d = static_cast<double(*)(double,double)>(std::pow);
+  auto std_sinh_d = static_cast<double(*)(double)>(std::sinh);
+  auto std_tan_d = static_cast<double(*)(double)>(std::tan);
+  auto std_asin_d = static_cast<double(*)(double)>(std::asin);
+  auto std_acos_d = static_cast<double(*)(double)>(std::acos);
+  auto std_exp2_d = static_cast<double(*)(double)>(std::exp2);
+  auto std_log2_d = static_cast<double(*)(double)>(std::log2);
+  auto std_log10_d = static_cast<double(*)(double)>(std::log10);
+  auto std_cbrt_d = static_cast<double(*)(double)>(std::cbrt);
+  auto std_hypot_d = static_cast<double(*)(double,double)>(std::hypot);
+  auto std_cosh_d = static_cast<double(*)(double)>(std::cosh);
+  constexpr auto cest_sin_d = static_cast<double(*)(double)>(cest::sin);
+  constexpr auto cest_cos_d = static_cast<double(*)(double)>(cest::cos);
+  constexpr auto cest_exp_d = static_cast<double(*)(double)>(cest::exp);
+  constexpr auto cest_log_d = static_cast<double(*)(double)>(cest::log);
+  constexpr auto cest_atan2_d =
+    static_cast<double(*)(double,double)>(cest::atan2);
+  constexpr auto cest_pow_d = static_cast<double(*)(double,double)>(cest::pow);
+  constexpr auto cest_sinh_d = static_cast<double(*)(double)>(cest::sinh);
+  constexpr auto cest_cosh_d = static_cast<double(*)(double)>(cest::cosh);
+  constexpr auto cest_tan_d = static_cast<double(*)(double)>(cest::tan);
+  constexpr auto cest_asin_d = static_cast<double(*)(double)>(cest::asin);
+  constexpr auto cest_acos_d = static_cast<double(*)(double)>(cest::acos);
+  constexpr auto cest_exp2_d = static_cast<double(*)(double)>(cest::exp2);
+  constexpr auto cest_log2_d = static_cast<double(*)(double)>(cest::log2);
+  constexpr auto cest_log10_d = static_cast<double(*)(double)>(cest::log10);
+  constexpr auto cest_cbrt_d = static_cast<double(*)(double)>(cest::cbrt);
+  constexpr auto cest_hypot_d =
+    static_cast<double(*)(double,double)>(cest::hypot);
+
 #if CONSTEXPR_CEST == 1
   static_assert(cmath_test1<double>(cest_abs_d,cest_atan_d,cest_sqrt_d));
+  static_assert(cmath_test2<double>(cest_sqrt_d,cest_sin_d,cest_cos_d,
+                                    cest_exp_d,cest_log_d));
+  static_assert(cmath_test3<double>(cest_atan_d,cest_atan2_d,cest_pow_d,
+                                    cest_sinh_d,cest_cosh_d));
+  static_assert(cmath_test4<double>(cest_tan_d,cest_asin_d,cest_acos_d,
+                                    cest_exp2_d,cest_log2_d,cest_log10_d,
+                                    cest_cbrt_d,cest_hypot_d));
+  static_assert(cmath_exact_test<float>());
+  static_assert(cmath_exact_test<double>());
+  static_assert(cmath_exact_test<long double>());
+  static_assert(cest::sin(1.0f) == float(cest::sin(1.0)) &&
+                cest::sqrt(2) == cest::sqrt(2.0) &&
+                cest::pow(2.0f, 3) == 8 && cest::atan2(1, 1.0L) > 0.78L);
 #endif
 
   assert(cmath_test1<double>(std_abs_d,std_atan_d,std_sqrt_d));
   assert(cmath_test1<double>(cest_abs_d,cest_atan_d,cest_sqrt_d));
+  assert(cmath_test2<double>(std_sqrt_d,std_sin_d,std_cos_d,
+                             std_exp_d,std_log_d));
+  assert(cmath_test2<double>(cest_sqrt_d,cest_sin_d,cest_cos_d,
+                             cest_exp_d,cest_log_d));
+  assert(cmath_test3<double>(std_atan_d,std_atan2_d,std_pow_d,
+                             std_sinh_d,std_cosh_d));
+  assert(cmath_test3<double>(cest_atan_d,cest_atan2_d,cest_pow_d,
+                             cest_sinh_d,cest_cosh_d));
+  assert(cmath_test4<double>(std_tan_d,std_asin_d,std_acos_d,std_exp2_d,
+                             std_log2_d,std_log10_d,std_cbrt_d,std_hypot_d));
+  assert(cmath_test4<double>(cest_tan_d,cest_asin_d,cest_acos_d,cest_exp2_d,
+                             cest_log2_d,cest_log10_d,cest_cbrt_d,
+                             cest_hypot_d));
+  assert(cmath_exact_test<float>());
+  assert(cmath_exact_test<double>());
+  assert(cmath_exact_test<long double>());
+  assert(cmath_ulp_test());
 }
 
 
@@ -3,7 +3,11 @@
 
 #include "tests_util.hpp"
 #include "cest/complex.hpp"
+#include "cest/sstream.hpp"
+#include "cest/string.hpp"
 #include <complex>
+#include <sstream>
+#include <string>
 #include <cassert>
 
 template <typename Cx>
@@ -19,14 +23,39 @@ constexpr bool complex_test1()
   return b1 && b2 && b3 && b4;
 }
 
+template <typename Oss, typename Cx, typename S>
+constexpr bool complex_test2()
+{
+  Oss s;
+  s << Cx{-3, 4};
+  return s.str() == S("(-3,4)");
+}
+
+template <typename Iss, typename Cx, typename S>
+constexpr bool complex_test3()
+{
+  Iss s(S("(1.5,-2) (3) 4 (5;6)"));
+  Cx x, y, z, w{7,8};
+  s >> x >> y >> z;
+  bool b = x==Cx{1.5,-2} && y==Cx{3,0} && z==Cx{4,0};
+  s >> w;
+  return b && s.fail() && w==Cx{7,8};
+}
+
 void complex_tests()
 {
 #if CONSTEXPR_CEST == 1
   static_assert(complex_test1<cest::complex<double>>());
+  static_assert(complex_test2<cest::ostringstream, cest::complex<int>, cest::string>());
+  static_assert(complex_test3<cest::istringstream, cest::complex<double>, cest::string>());
 #endif
 
   assert(complex_test1<std::complex<double>>());
   assert(complex_test1<cest::complex<double>>());
+  assert((complex_test2< std::ostringstream,  std::complex<int>,  std::string>()));
+  assert((complex_test2<cest::ostringstream, cest::complex<int>, cest::string>()));
+  assert((complex_test3< std::istringstream,  std::complex<double>,  std::string>()));
+  assert((complex_test3<cest::istringstream, cest::complex<double>, cest::string>()));
 }
 
 #endif // _CEST_COMPLEX_TESTS_HPP_
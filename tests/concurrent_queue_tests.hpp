@@ -0,0 +1,137 @@
+#ifndef _CEST_CONCURRENT_QUEUE_TESTS_HPP_
+#define _CEST_CONCURRENT_QUEUE_TESTS_HPP_
+
+#include "cest/concurrent_queue.hpp"
+#include "cest/string.hpp"
+#include "cest/memory.hpp"
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cassert>
+
+// Sequential use: fill, drain and wrap around
+template <typename Q>
+constexpr bool concurrent_queue_test1()
+{
+  Q q(5);
+  bool b1 = 8==q.capacity() && q.empty();
+  int x = -1;
+  bool b2 = !q.try_pop(x) && -1==x;
+  for (int i = 0; i < 8; ++i)
+    b2 = b2 && q.try_push(i);
+  bool b3 = !q.try_push(8) && 8==q.size();
+
+  bool b4 = true;
+  for (int j = 0; j < 20; ++j) {
+    b4 = b4 && q.try_pop(x) && x==j;
+    b4 = b4 && q.try_push(j + 8);
+  }
+  int sum = 0;
+  while (q.try_pop(x))
+    sum += x;
+  return b1 && b2 && b3 && b4 && q.empty() && (20+27)*8/2==sum;
+}
+
+// Elements are destroyed by pop, and by the queue's destructor
+template <typename Q>
+constexpr bool concurrent_queue_test2()
+{
+  Q q(4);
+  bool b = q.try_emplace("Fire and ") && q.try_push("Brimstone!") &&
+           q.try_emplace(cest::string("!!!"));
+  cest::string s, t;
+  b = b && q.try_pop(s) && q.try_pop(t);
+  s += t;
+  return b && "Fire and Brimstone!"==s && 1==q.size();
+}
+
+template <typename Q>
+constexpr bool concurrent_queue_test3()
+{
+  Q q(2);
+  bool b = q.try_push(cest::make_unique<int>(42));
+  cest::unique_ptr<int> p;
+  return b && q.try_pop(p) && 42==*p && q.try_push(std::move(p)) && !p;
+}
+
+bool spsc_queue_thread_test()
+{
+  constexpr int n = 100000;
+  cest::spsc_queue<int> q(64);
+  long long sum = 0;
+  bool in_order = true;
+  std::thread consumer([&] {
+    int expected = 0, x;
+    while (expected < n) {
+      if (q.try_pop(x)) {
+        in_order = in_order && x==expected++;
+        sum += x;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+  for (int i = 0; i < n; ++i)
+    while (!q.try_push(i))
+      std::this_thread::yield();
+  consumer.join();
+  return in_order && (long long)n*(n-1)/2==sum && q.empty();
+}
+
+bool mpmc_queue_thread_test()
+{
+  constexpr int n = 20000, nthreads = 4;
+  cest::mpmc_queue<int> q(128);
+  std::atomic<long long> sum{0};
+  std::atomic<int> popped{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nthreads; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 1; i <= n; ++i)
+        while (!q.try_push(i))
+          std::this_thread::yield();
+    });
+    threads.emplace_back([&] {
+      int x;
+      while (popped < n * nthreads) {
+        if (q.try_pop(x)) {
+          sum += x;
+          ++popped;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto& t : threads)
+    t.join();
+  return (long long)nthreads*n*(n+1)/2==sum && q.empty();
+}
+
+void concurrent_queue_tests()
+{
+  using spsc_s = cest::spsc_queue<cest::string>;
+  using mpmc_s = cest::mpmc_queue<cest::string>;
+  using spsc_u = cest::spsc_queue<cest::unique_ptr<int>>;
+  using mpmc_u = cest::mpmc_queue<cest::unique_ptr<int>>;
+
+#if CONSTEXPR_CEST == 1
+  static_assert(concurrent_queue_test1<cest::spsc_queue<int>>());
+  static_assert(concurrent_queue_test1<cest::mpmc_queue<int>>());
+  static_assert(concurrent_queue_test2<spsc_s>());
+  static_assert(concurrent_queue_test2<mpmc_s>());
+  static_assert(concurrent_queue_test3<spsc_u>());
+  static_assert(concurrent_queue_test3<mpmc_u>());
+#endif
+
+  assert(concurrent_queue_test1<cest::spsc_queue<int>>());
+  assert(concurrent_queue_test1<cest::mpmc_queue<int>>());
+  assert(concurrent_queue_test2<spsc_s>());
+  assert(concurrent_queue_test2<mpmc_s>());
+  assert(concurrent_queue_test3<spsc_u>());
+  assert(concurrent_queue_test3<mpmc_u>());
+  assert(spsc_queue_thread_test());
+  assert(mpmc_queue_thread_test());
+}
+
+#endif // _CEST_CONCURRENT_QUEUE_TESTS_HPP_
@@ -4,21 +4,20 @@
 #include "cest/cstdio.hpp"
 #include "cest/cstdlib.hpp" // cest::size_t
 #include "cest/string.hpp"  // cest::string
+#include "cest/sstream.hpp" // cest::ostringstream
+#include <string_view>
+#include <limits>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
 
 constexpr bool cstdio_test1()
 {
   cest::printf(__func__);
-  const char format[] = " (%d %s)";
-  int r1 = cest::printf(format, 1789, "ok");
-  int r2 = cest::fprintf(cest::stderr, format, 1789, "ok");
+  int r1 = cest::printf(" (%d %s)", 1789, "ok");
+  int r2 = cest::fprintf(cest::stderr, " (%d %s)", 1789, "ok");
   cest::printf("\n");
-  bool b = false;
-  if (std::is_constant_evaluated())
-    b = r1==0;
-  else
-    b = r1==10;
-
-  return b && r1==r2;
+  return r1==10 && r1==r2;
 }
 
 constexpr bool cstdio_test2()
@@ -34,15 +33,130 @@ constexpr bool cstdio_test2()
   return 0==ret && 6==num_read && str[0]==buffer[0];
 }
 
+// fmemopen reads the caller's buffer in place, rather than a copy of it
+constexpr bool cstdio_test3()
+{
+  char buffer[4]{};
+  char data[] = "abcd";
+
+  cest::FILE* in        = cest::fmemopen(data, 4, "rb");
+  data[1] = 'X';
+  cest::size_t num_read = cest::fread(buffer, sizeof buffer[0], 2, in);
+  data[2] = 'Y';
+  num_read += cest::fread(buffer + 2, sizeof buffer[0], 4, in);
+  int ret               = cest::fclose(in);
+
+  return 0==ret && 4==num_read && 'a'==buffer[0] && 'X'==buffer[1] &&
+         'Y'==buffer[2] && 'd'==buffer[3];
+}
+
+// The expected output is that of glibc's snprintf
+constexpr bool cstdio_test4()
+{
+  using sv = std::string_view;
+  char buf[64];
+  int n1 = cest::snprintf(buf, sizeof buf, "%d|%i|%u|%o|%x|%X", -42, 7,
+                          3000000000u, 8, 255, 255);
+  bool b1 = 25==n1 && sv(buf) == "-42|7|3000000000|10|ff|FF";
+  int n2 = cest::snprintf(buf, sizeof buf, "%+5d|%-5d|%05d|% d|%.3d|%#o|%#x",
+                          42, 42, -42, 42, 7, 8, 255);
+  bool b2 = 34==n2 && sv(buf) == "  +42|42   |-0042| 42|007|010|0xff";
+  int n3 = cest::snprintf(buf, sizeof buf, "%c%c|%.2s|%8s|%-4s|%s", 'a', 98,
+                          "str", "str", "str", (const char*)nullptr);
+  bool b3 = 26==n3 && sv(buf) == "ab|st|     str|str |(null)";
+  int n4 = cest::snprintf(buf, sizeof buf, "%f|%.2f|%e|%.3E|%g|%G|%a",
+                          3.14159, 2.5, 12345.678, 0.000123, 0.0001, 1e20, 1.0);
+  bool b4 = 56==n4 &&
+            sv(buf) == "3.141590|2.50|1.234568e+04|1.230E-04|0.0001|1E+20|0x1p+0";
+  int n5 = cest::snprintf(buf, sizeof buf, "%*d|%-*d|%.*f|%08.3f|%#.0f|%10.4g",
+                          6, 42, 6, 42, 2, 3.14159, -3.14159, 3.0, 3.14159);
+  bool b5 = 41==n5 && sv(buf) == "    42|42    |3.14|-003.142|3.|     3.142";
+  int n6 = cest::snprintf(buf, sizeof buf, "%hhd|%hd|%hhu|%hx|%%", 300, 70000,
+                          -1, -1);
+  bool b6 = 18==n6 && sv(buf) == "44|4464|255|ffff|%";
+  int n7 = cest::snprintf(buf, 5, "%d", 1234567);     // truncated
+  bool b7 = 7==n7 && sv(buf) == "1234";
+  int n8 = cest::snprintf(nullptr, 0, "%s-%d", "ab", 12);
+  // Longer than the 64 characters of the stack buffer; inf isn't zero padded
+  char big[200];
+  const double inf = std::numeric_limits<double>::infinity();
+  int n9 = cest::snprintf(big, sizeof big, "%.70f|%08f|%-6F|%+#012a|%090.3e",
+                          0.1, -inf, inf, 1.0, -2.5);
+  bool b9 = 192==n9 && sv(big) ==
+    "0.1000000000000000055511151231257827021181583404541015625000000000000000"
+    "|    -inf|INF   |+0x00001.p+0|-0000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000002.500e+00";
+  return b1 && b2 && b3 && b4 && b5 && b6 && b7 && 5==n8 && b9;
+}
+
+// Formatted directly into the stream's buffer
+constexpr bool cstdio_test5()
+{
+  cest::ostringstream oss;
+  int n = cest::fprintf(&oss, "%s=%.2f", "pi", 3.14159);
+  return 7==n && oss.str() == "pi=3.14";
+}
+
+// A format string which is invalid for the argument types does not compile;
+// unless it is given by runtime_printf_format, when it is an error at runtime
+bool cstdio_test6()
+{
+  char buf[8];
+  const char* format = "%d";
+  return -1==cest::snprintf(buf, sizeof buf,
+                            cest::runtime_printf_format(format), "str") &&
+         1==cest::snprintf(buf, sizeof buf,
+                           cest::runtime_printf_format(format), 7) &&
+         std::strcmp(buf, "7") == 0;
+}
+
+// Runtime only: cest::printf flushes cest::cout first; even when cout is not
+// synchronized with stdio. The output is captured in a temporary file.
+bool cstdio_test7()
+{
+  std::fflush(stdout);
+  std::FILE* tmp = std::tmpfile();
+  const int saved = ::dup(1);
+  if (!tmp || saved < 0 || ::dup2(fileno(tmp), 1) < 0)
+    return false;
+
+  for (bool sync : {true, false})
+  {
+    cest::ios_base::sync_with_stdio(sync);
+    cest::cout << "x";
+    cest::printf("y%d", 1);
+    cest::cout << "z\n";
+    cest::cout.flush();
+  }
+  cest::ios_base::sync_with_stdio(true);
+  std::fflush(stdout);
+
+  ::dup2(saved, 1);
+  ::close(saved);
+  char buf[16]{};
+  std::rewind(tmp);
+  std::fread(buf, 1, sizeof buf - 1, tmp);
+  std::fclose(tmp);
+  return std::strcmp(buf, "xy1z\nxy1z\n") == 0;
+}
+
 void cstdio_tests()
 {
 #if CONSTEXPR_CEST == 1
   static_assert(cstdio_test1());
   static_assert(cstdio_test2());
+  static_assert(cstdio_test3());
+  static_assert(cstdio_test4());
+  static_assert(cstdio_test5());
 #endif
 
   assert(cstdio_test1());
   assert(cstdio_test2());
+  assert(cstdio_test3());
+  assert(cstdio_test4());
+  assert(cstdio_test5());
+  assert(cstdio_test6());
+  assert(cstdio_test7());
 }
 
 #endif // _CEST_CSTDIO_TESTS_HPP_
@@ -0,0 +1,25 @@
+#ifndef _CEST_EMBEDDED_FILES_HPP_
+#define _CEST_EMBEDDED_FILES_HPP_
+
+// The files readable by a cest::ifstream within a constant expression; as a
+// header generated by the build might define them. It precedes any use of a
+// cest::ifstream.
+
+#include "cest/fstream.hpp"
+#include <span>
+
+namespace fs_tests {
+
+constexpr char embedded_txt[] = { '4', '2', ' ', 'o', 'k', '\n', 'e', 'n', 'd' };
+constexpr cest::embedded_file embedded[] = {
+  { "embedded.txt", embedded_txt },
+  { "empty.txt",    {} }
+};
+
+} // namespace fs_tests
+
+template <>
+inline constexpr std::span<const cest::embedded_file>
+  cest::embedded_files<char>{fs_tests::embedded};
+
+#endif // _CEST_EMBEDDED_FILES_HPP_
@@ -0,0 +1,108 @@
+#ifndef _CEST_FORMAT_TESTS_HPP_
+#define _CEST_FORMAT_TESTS_HPP_
+
+#include "cest/format.hpp"
+#include "cest/complex.hpp"
+#include "cest/iterator.hpp" // cest::back_inserter
+#include "cest/string.hpp"
+#include <climits>
+#include <limits>
+#include <cassert>
+
+// The expected output is that of std::format
+namespace fmt_tests {
+
+constexpr bool format_int_test()
+{
+  bool b1 = cest::format("{} {} {} {}", 42, -7, 'x', true) == "42 -7 x true";
+  bool b2 = cest::format("{:+5d}|{:<5}|{:^7}|{:*>6}|{:05}", 42, 42, 42, 42,
+                         -42) == "  +42|42   |  42   |****42|-0042";
+  bool b3 = cest::format("{:#x}|{:#o}|{:#b}|{:X}|{:#X}|{:o}", 255, 8, 5, 255,
+                         255, 0) == "0xff|010|0b101|FF|0XFF|0";
+  bool b4 = cest::format("{:c}|{:d}|{:s}|{:d}|{:6}|{:>3}", 65, 'a', false,
+                         true, true, 'c') == "A|97|false|1|true  |  c";
+  bool b5 = cest::format("{}|{}|{:#010x}", LLONG_MIN, ULLONG_MAX, 255u) ==
+            "-9223372036854775808|18446744073709551615|0x000000ff";
+  return b1 && b2 && b3 && b4 && b5;
+}
+
+constexpr bool format_float_test()
+{
+  // With no type or precision, the shortest representation: as to_chars
+  bool b1 = cest::format("{}|{}|{}|{}|{}|{}|{}", 1.0, 0.1, 1e20, 1e-7,
+                         123456.789, 0.1f, 1e22) ==
+            "1|0.1|1e+20|1e-07|123456.789|0.1|1e+22";
+  bool b2 = cest::format("{:.2f}|{:e}|{:.3g}|{:a}|{:A}|{:.3}", 3.14159,
+                         12345.678, 0.000123456, 1.0, 0.5, 2.0 / 3) ==
+            "3.14|1.234568e+04|0.000123|1p+0|1P-1|0.667";
+  bool b3 = cest::format("{:+}|{:010.3f}|{:#}|{: }|{:<6}|", 2.5, -3.14159,
+                         1e20, 1.5, -0.0) == "+2.5|-00003.142|1.e+20| 1.5|-0    |";
+  const double inf = std::numeric_limits<double>::infinity();
+  bool b4 = cest::format("{}|{:08}|{:F}", inf, -inf, inf) == "inf|    -inf|INF";
+  // Longer than the 64 characters of the stack buffer
+  bool b5 = cest::format("{:.70f}|{:090.3e}", 0.1, -2.5) ==
+    "0.1000000000000000055511151231257827021181583404541015625000000000000000"
+    "|-0000000000000000000000000000000000000000000000000000000000000000000000"
+    "00000000002.500e+00" &&
+    cest::format("{:*^80.20f}", 1.0 / 3) ==
+    "*****************************0.33333333333333331483"
+    "*****************************" &&
+    cest::format("{:.30f}", cest::complex<double>(1, -2)) ==
+    "(1.000000000000000000000000000000,-2.000000000000000000000000000000)" &&
+    cest::formatted_size("{:.3f}", 1e300) == 305;
+  char buf[100]{};
+  char* end = cest::format_to(buf, "{:>90.2f}", 1.5);
+  bool b6 = 90 == end - buf && buf[85] == ' ' &&
+            cest::string(buf + 86) == "1.50";
+  return b1 && b2 && b3 && b4 && b5 && b6;
+}
+
+constexpr bool format_text_test()
+{
+  const cest::string str = "mid";
+  bool b1 = cest::format("{:>8}|{:^9}|{:.2}|{}|{:_<4}", "abc", str, "trunc",
+                         std::string_view("sv"), str) ==
+            "     abc|   mid   |tr|sv|mid_";
+  bool b2 = cest::format("{1}-{0}-{1}|{{}}|}}", 1, 2) == "2-1-2|{}|}";
+  bool b3 = cest::format("{:*^{}}|{:.{}f}", "x", 7, 3.14159, 3) ==
+            "***x***|3.142" && cest::format("{0:{1}}|", "x", 3) == "x  |";
+  bool b4 = cest::format("{}|{:.1f}|{:>8}", cest::complex<double>(1, 2),
+                         cest::complex<double>(1.25, -0.5),
+                         cest::complex<float>(0.1f, 2)) ==
+            "(1,2)|(1.2,-0.5)| (0.1,2)";
+  return b1 && b2 && b3 && b4 && cest::format("{}", nullptr) == "0x0";
+}
+
+// format_to an output iterator; and formatted_size
+constexpr bool format_to_test()
+{
+  cest::string s = "n=";
+  cest::format_to(cest::back_inserter(s), "{:x}/{}", 3054, 0.5);
+  char buf[16]{};
+  char* end = cest::format_to(buf, "{}-{:>3}", "ab", 12);
+  bool b1 = s == "n=bee/0.5" && 6 == end - buf && cest::string(buf) == "ab- 12";
+  std::size_t n = cest::formatted_size("{:>10}|{}|{:.3e}", "x", 123, 1.0);
+  return b1 && 24 == n &&
+         cest::formatted_size("{}", 1.0 / 3) == cest::format("{}", 1.0 / 3).size();
+}
+
+} // namespace fmt_tests
+
+void format_tests()
+{
+  using namespace fmt_tests;
+
+  assert(format_int_test());
+  assert(format_float_test());
+  assert(format_text_test());
+  assert(format_to_test());
+
+#if CONSTEXPR_CEST == 1
+  static_assert(format_int_test());
+  static_assert(format_float_test());
+  static_assert(format_text_test());
+  static_assert(format_to_test());
+#endif
+}
+
+#endif // _CEST_FORMAT_TESTS_HPP_
@@ -0,0 +1,57 @@
+#ifndef _CEST_FSTREAM_TESTS_HPP_
+#define _CEST_FSTREAM_TESTS_HPP_
+
+#include "embedded_files.hpp"
+#include "cest/fstream.hpp"
+#include "cest/string.hpp"
+#include <fstream>
+#include <string>
+#include <cassert>
+
+namespace fs_tests {
+
+// The first line of this file
+template <typename Ifs, typename S>
+constexpr bool fstream_test1()
+{
+  Ifs file(__FILE__);
+  S line;
+  getline(file, line);
+  bool b1 = file.is_open() && line == S("#ifndef _CEST_FSTREAM_TESTS_HPP_");
+  file.close();
+  bool b2 = !file.is_open() && file.good();
+  Ifs none("fs_tests/no_such_file");
+  return b1 && b2 && !none.is_open() && none.fail();
+}
+
+// Within a constant expression, the files are those of the registry
+constexpr bool fstream_test2()
+{
+  cest::ifstream file("embedded.txt");
+  int i = 0;
+  cest::string s1, s2;
+  file >> i >> s1 >> s2;
+  bool b1 = 42==i && s1 == cest::string("ok") && s2 == cest::string("end");
+  bool b2 = file.eof() && !file.fail();
+  cest::ifstream empty("empty.txt");
+  char c = 0;
+  empty.get(c);
+  cest::ifstream none("none.txt");
+  return b1 && b2 && empty.is_open() && empty.fail() && none.fail();
+}
+
+} // namespace fs_tests
+
+void fstream_tests()
+{
+  using namespace fs_tests;
+
+  assert((fstream_test1< std::ifstream,  std::string>()));
+  assert((fstream_test1<cest::ifstream, cest::string>()));
+
+#if CONSTEXPR_CEST == 1
+  static_assert(fstream_test2());
+#endif
+}
+
+#endif // _CEST_FSTREAM_TESTS_HPP_
@@ -23,6 +23,95 @@ constexpr bool function_test1()
   return b;
 }
 
+// copying, moving, assignment and the empty state
+template <template <typename, typename...> typename F>
+constexpr bool function_test2()
+{
+  int i{1};
+  double big[8]{1,2,3,4,5,6,7,8}; // a capture too large for the small buffer
+
+  F<int()> f0;
+  F<int()> f1 = [&i]{ return i; };
+  F<int()> f2 = [big]{ return int(big[7]); };
+  bool b1 = !f0 && f1 && f2 && 1==f1() && 8==f2();
+
+  F<int()> f3 = f1;
+  F<int()> f4 = f2;
+  F<int()> f5 = std::move(f3);
+  i = 2;
+  bool b2 = 2==f5() && 8==f4();
+
+  f0 = f4;
+  f4 = std::move(f5);
+  f5 = nullptr;
+  f1 = [j = 5]{ return j; };
+  bool b3 = 8==f0() && 2==f4() && !f5 && 5==f1();
+
+  swap(f0, f1);
+  bool b4 = 5==f0() && 8==f1();
+
+  return b1 && b2 && b3 && b4;
+}
+
+// an lvalue callable is copied once on wrapping; an rvalue one never is
+template <template <typename, typename...> typename F>
+constexpr bool function_test3()
+{
+  struct counted {
+    constexpr counted(int& copies) : copies_(&copies) {}
+    constexpr counted(const counted& o) : copies_(o.copies_) { ++*copies_; }
+    constexpr counted(counted&& o) noexcept : copies_(o.copies_) {
+      o.copies_ = nullptr;
+    }
+    constexpr int operator()(int x) const { return x + *copies_; }
+    int* copies_;
+  };
+
+  int copies{0};
+  counted c{copies};
+  F<int(int)> f1 = c;
+  bool b1 = 1==copies && c.copies_;
+  F<int(int)> f2 = counted{copies};
+  F<int(int)> f3 = std::move(f2);
+  bool b2 = 1==copies && 2==f3(1) && 2==f1(1);
+  return b1 && b2;
+}
+
+constexpr bool move_only_function_test1()
+{
+  cest::unique_ptr<int> p{new int{42}};
+  cest::move_only_function<int()> f1 = [p = std::move(p)] { return *p; };
+  cest::move_only_function<int()> f2;
+  f2 = std::move(f1);
+  bool b1 = !f1 && f2 && 42==f2() && !p;
+
+  cest::move_only_function<void(int&)> f3 = [](int& i) { ++i; };
+  int i{1};
+  f3(i);
+  return b1 && 2==i;
+}
+
+constexpr int add(int x, int y) { return x + y; }
+
+template <template <typename, typename...> typename F>
+constexpr bool function_ref_test1()
+{
+  int i{3};
+  auto l = [&i](int x) { i += x; return i; };
+  F<int(int)> r1 = l;
+  F<int(int)> r2 = r1;
+  r1(1);
+  bool b1 = 5==r2(1) && 5==i;
+
+  F<int(int,int)> r3 = add;
+  bool b2 = 7==r3(3,4);
+
+  cest::function<void(int)> f = [&i](int x) { i = x; };
+  F<void(int)> r4 = f;
+  r4(42);
+  return b1 && b2 && 42==i;
+}
+
 } // namespace f_tests
 
 void functional_tests()
@@ -31,9 +120,20 @@ void functional_tests()
 
 #if CONSTEXPR_CEST == 1
   static_assert(function_test1<cest::function>());
+  static_assert(function_test2<cest::function>());
+  static_assert(function_test3<cest::function>());
+  static_assert(move_only_function_test1());
+  static_assert(function_ref_test1<cest::function_ref>());
 #endif
 
   assert((function_test1<std::function>()));
+  assert((function_test1<cest::function>()));
+  assert((function_test2<std::function>()));
+  assert((function_test2<cest::function>()));
+  assert((function_test3<std::function>()));
+  assert((function_test3<cest::function>()));
+  assert(move_only_function_test1());
+  assert((function_ref_test1<cest::function_ref>()));
 }
 
 
@@ -0,0 +1,118 @@
+#ifndef _CEST_INSTRUMENT_TESTS_HPP_
+#define _CEST_INSTRUMENT_TESTS_HPP_
+
+#include "cest/instrument.hpp"
+#include "cest/vector.hpp"
+#include "cest/string.hpp"
+#include "cest/map.hpp"
+#include "cest/set.hpp"
+#include "cest/list.hpp"
+#include "cest/deque.hpp"
+#include "cest/arena.hpp"
+#include <cassert>
+
+namespace instr_tests {
+
+template <typename T>
+using counted_t = cest::counting_allocator<std::allocator<T>>;
+
+// Doubling from a capacity of 1 to 1024 reallocates 11 times; and relocates
+// 1 + 2 + 4 + ... + 512 elements. The peak is during the last reallocation.
+constexpr cest::alloc_stats vector_stats(bool reserve)
+{
+  cest::alloc_stats s;
+  {
+    cest::vector<int, counted_t<int>> v{counted_t<int>(s)};
+    if (reserve)
+      v.reserve(1024);
+    for (int i = 0; i < 1024; ++i)
+      v.push_back(i);
+  }
+  return s;
+}
+
+constexpr bool instrument_test1()
+{
+  auto s1 = vector_stats(false);
+  auto s2 = vector_stats(true);
+  return 11==s1.reallocations && 1023==s1.relocated_elements &&
+         11==s1.allocations && s1.allocations==s1.deallocations &&
+         0==s1.live_bytes() && (1024+512)*sizeof(int)==s1.peak_bytes &&
+         1==s2.reallocations && 0==s2.relocated_elements;
+}
+
+constexpr cest::alloc_stats map_stats(int n)
+{
+  using pair_t = std::pair<const int, int>;
+  cest::alloc_stats s;
+  cest::map<int, int, std::less<int>, counted_t<pair_t>> m{counted_t<pair_t>(s)};
+  for (int i = 0; i < n; ++i)
+    m.insert({i, i});  // ascending keys: the worst case for rotations
+  return s;
+}
+
+constexpr bool instrument_test2()
+{
+  const auto s = map_stats(100);
+  cest::alloc_stats s2;
+  {
+    cest::set<int, std::less<int>, counted_t<int>> st{counted_t<int>(s2)};
+    for (int i = 100; i > 0; --i)
+      st.insert(i);
+  }
+  return 100==s.allocations && s.rotations > 0 && s.rotations < 100 &&
+         s.rotations==s2.rotations && 100==s2.deallocations;
+}
+
+constexpr bool instrument_test3()
+{
+  cest::alloc_stats s;
+  {
+    cest::basic_string<char, std::char_traits<char>, counted_t<char>>
+      str{counted_t<char>(s)};
+    for (int i = 0; i < 100; ++i)
+      str.push_back('x');
+    str.append("Fire and Brimstone!", 19);
+  }
+  cest::alloc_stats s2;
+  {
+    cest::deque<int, counted_t<int>> d{counted_t<int>(s2)};
+    for (int i = 0; i < 3 * CHUNK_SIZE; ++i)
+      d.push_back(i);
+  }
+  cest::alloc_stats s3;
+  {
+    // counting the arena: it has one block of each type
+    cest::arena a(1024);
+    using alloc_t = cest::counting_allocator<cest::monotonic_allocator<int>>;
+    cest::list<int, alloc_t> l{alloc_t(s3, a)};
+    auto l2 = l;
+    for (int i = 0; i < 10; ++i)
+      l2.push_back(i);
+  }
+  return s.reallocations > 0 && s.allocations==s.deallocations &&
+         4==s2.chunk_allocations && 10==s3.allocations;
+}
+
+} // namespace instr_tests
+
+void instrument_tests()
+{
+  using namespace instr_tests;
+
+#if CONSTEXPR_CEST == 1
+  static_assert(instrument_test1());
+  static_assert(instrument_test2());
+  static_assert(instrument_test3());
+
+  // e.g. an allocation budget for a workload
+  static_assert(map_stats(1000).rotations < 1000);
+  static_assert(vector_stats(true).allocations == 1);
+#endif
+
+  assert(instrument_test1());
+  assert(instrument_test2());
+  assert(instrument_test3());
+}
+
+#endif // _CEST_INSTRUMENT_TESTS_HPP_
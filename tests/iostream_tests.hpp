@@ -6,6 +6,9 @@
 #include <iostream>
 #include <fstream>
 #include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
 
 constexpr bool iostream_test1(auto &cout, auto &cerr, auto &hex, auto &endl)
 {
@@ -31,6 +34,64 @@ constexpr bool iostream_test2()
   return '#' == c;
 }
 
+// A streambuf over a fixed array; as a user might define
+template <typename Sb, typename C = char>
+struct array_buf : Sb
+{
+  constexpr array_buf() { this->setp(buf, buf + sizeof buf); }
+  constexpr std::size_t size() const { return this->pptr() - this->pbase(); }
+  C buf[64]{};
+};
+
+// Output to a stream other than cout, cerr or clog is no longer dropped
+template <typename Sb, typename Os, typename Hex, typename Dec>
+constexpr bool iostream_test3(Hex& hex, Dec& dec)
+{
+  array_buf<Sb> sb;
+  Os os(&sb);
+  os << "Fire" << ' ' << 42 << -7 << hex << 255 << -1 << dec << 10U;
+  os.put('!').write("abc", 2);
+  const char expected[] = "Fire 42-7ffffffffff10!ab";
+  bool b = sizeof(expected) - 1 == sb.size();
+  for (std::size_t i = 0; b && i < sb.size(); ++i)
+    b = expected[i] == sb.buf[i];
+
+  // a full streambuf sets badbit
+  for (int i = 0; i < 64; ++i)
+    os << 'x';
+  return b && os.bad();
+}
+
+// Runtime only: cest::cout, as std::cout, is synchronized with stdio; so its
+// output is in order with that of printf and std::cout. Unsynchronized, it
+// is in order after a flush. The output is captured in a temporary file.
+bool iostream_order_test()
+{
+  std::cout.flush();
+  std::fflush(stdout);
+  std::FILE* tmp = std::tmpfile();
+  const int saved = ::dup(1);
+  if (!tmp || saved < 0 || ::dup2(fileno(tmp), 1) < 0)
+    return false;
+
+  cest::cout << "A"; std::printf("B"); std::cout << "C";
+  cest::cout << "D\n"; std::printf("E\n");
+  const bool synced = cest::ios_base::sync_with_stdio(false);
+  cest::cout << "F" << cest::flush; std::printf("G"); std::fflush(stdout);
+  cest::cout << "H\n" << cest::flush;
+  cest::ios_base::sync_with_stdio(true);
+  std::cout.flush();
+  std::fflush(stdout);
+
+  ::dup2(saved, 1);
+  ::close(saved);
+  char buf[32]{};
+  std::rewind(tmp);
+  const std::size_t n = std::fread(buf, 1, sizeof buf - 1, tmp);
+  std::fclose(tmp);
+  return synced && n == 11 && std::strcmp(buf, "ABCD\nE\nFGH\n") == 0;
+}
+
 void iostream_tests()
 {
   using std_char_type    = decltype(std::cout)::char_type;
@@ -44,12 +105,16 @@ void iostream_tests()
 #if CONSTEXPR_CEST == 1
   static_assert(iostream_test1(cest::cout, cest::cerr, cest::hex, cest_endl));
   //static_assert(iostream_test2<cest::string,cest::ifstream,cest::istream>());
+  static_assert(iostream_test3<cest::streambuf, cest::ostream>(cest::hex, cest::dec));
 #endif
 
   assert(iostream_test1( std::cout,  std::cerr,  std::hex,  std_endl));
   assert(iostream_test1(cest::cout, cest::cerr, cest::hex, cest_endl));
   assert((iostream_test2<std::string,std::ifstream,std::istream>()));
-  //assert((iostream_test2<cest::string,cest::ifstream,cest::istream>()));
+  assert((iostream_test2<cest::string,cest::ifstream,cest::istream>()));
+  assert((iostream_test3< std::streambuf,  std::ostream>( std::hex,  std::dec)));
+  assert((iostream_test3<cest::streambuf, cest::ostream>(cest::hex, cest::dec)));
+  assert(iostream_order_test());
 }
 
 #endif // _CEST_IOSTREAM_TESTS_HPP_
@@ -0,0 +1,209 @@
+#ifndef _CEST_ISTREAM_TESTS_HPP_
+#define _CEST_ISTREAM_TESTS_HPP_
+
+#include "cest/sstream.hpp"
+#include "cest/string.hpp"
+#include <sstream>
+#include <string>
+#include <climits>
+#include <cassert>
+
+namespace is_tests {
+
+template <typename Iss, typename S>
+constexpr bool istream_int_test()
+{
+  Iss s(S("  42 -7\n+13 18446744073709551615 -1 4294967296 0x1F 017 x"));
+  int i1 = 0, i2 = 0, i3 = 0, i4 = 1;
+  unsigned long long ull = 0;
+  unsigned u = 0;
+  s >> i1 >> i2 >> i3 >> ull >> u;
+  bool b1 = 42==i1 && -7==i2 && 13==i3 && ULLONG_MAX==ull && UINT_MAX==u;
+  s >> i4;              // out of range for an int
+  bool b2 = s.fail() && INT_MAX==i4;
+  s.clear();
+  long l1 = 0, l2 = 0, l3 = 1;
+  s.unsetf(Iss::basefield);
+  s >> l1 >> l2;
+  bool b3 = 31==l1 && 15==l2;
+  s >> l3;              // no digits
+  return b1 && b2 && b3 && s.fail() && 0==l3;
+}
+
+template <typename Iss, typename S>
+constexpr bool istream_hex_test()
+{
+  Iss s(S("ff 0Xff -10 7fffffffffffffff8"));
+  short h1 = 0;
+  long h2 = 0, h3 = 0, h4 = 0;
+  s.setf(Iss::hex, Iss::basefield);
+  s >> h1 >> h2 >> h3 >> h4;
+  return 255==h1 && 255==h2 && -16==h3 && LONG_MAX==h4 && s.fail() && s.eof();
+}
+
+template <typename Iss, typename S>
+constexpr bool istream_float_test()
+{
+  Iss s(S("3.25 -0.1 1e-3 .5e1 2.4703282292062328e-324 1e400 1.5e"));
+  double d1 = 0, d2 = 0, d3 = 0, d4 = 0, d5 = 0, d6 = 0, d7 = 1;
+  float f = 0;
+  s >> d1 >> d2 >> d3 >> f >> d5;
+  bool b1 = 3.25==d1 && -0.1==d2 && 1e-3==d3 && 5.0f==f && 5e-324==d5;
+  s >> d6;              // too large
+  bool b2 = s.fail() && 1.7976931348623157e308==d6;
+  s.clear();
+  s >> d7;              // no exponent digits
+  return b1 && b2 && s.fail() && 0==d7 && 0==d4;
+}
+
+// A sign ends the number, once a digit has been read
+template <typename Iss, typename S>
+constexpr bool istream_float_sign_test()
+{
+  Iss s(S("649-8 -1-2 1+2 233-a"));
+  double d1 = 0, d2 = 0, d3 = 0, d4 = 0, d5 = 0, d6 = 0, d7 = 0;
+  s >> d1 >> d2 >> d3 >> d4 >> d5 >> d6 >> d7;
+  bool b = 649==d1 && -8==d2 && -1==d3 && -2==d4 && 1==d5 && 2==d6 &&
+           233==d7 && s.good();
+  s >> d1;
+  return b && s.fail();
+}
+
+template <typename Iss, typename S>
+constexpr bool istream_text_test()
+{
+  Iss s(S(" \tx 1 true false fals word  longword"));
+  char c = 0;
+  bool t = false, f = true, g = true;
+  s >> c >> t;
+  s.setf(Iss::boolalpha);
+  s >> t >> f;
+  bool b1 = 'x'==c && t && !f;
+  S str;
+  char buf[4];
+  s >> g;               // a prefix of false
+  bool b2 = s.fail() && !g;
+  s.clear();
+  s >> str >> buf;
+  bool b3 = str == S("word") && 'l'==buf[0] && 'o'==buf[1] && 'n'==buf[2] &&
+            0==buf[3];
+  s.width(3);
+  s >> str;
+  bool b4 = str == S("gwo") && 0==s.width();
+  s >> str;
+  bool b5 = str == S("rd") && s.eof() && !s.fail();
+  s >> str;
+  return b1 && b2 && b3 && b4 && b5 && s.fail();
+}
+
+// Without skipws, leading whitespace stops the extraction
+template <typename Iss, typename S>
+constexpr bool istream_skipws_test()
+{
+  Iss s(S(" 1"));
+  int i = 5;
+  s.unsetf(Iss::skipws);
+  s >> i;
+  return s.fail() && 0==i;
+}
+
+template <typename Iss, typename S>
+constexpr bool istream_getline_test()
+{
+  Iss s(S("first line\nsecond;third\n\nlast"));
+  char buf[8];
+  s.getline(buf, 8);    // too long for the array
+  bool b1 = s.fail() && 7==s.gcount() && S(buf) == S("first l");
+  s.clear();
+  s.getline(buf, 8);
+  bool b2 = 4==s.gcount() && S(buf) == S("ine");
+  S str;
+  getline(s, str, ';');
+  bool b3 = str == S("second");
+  getline(s, str);
+  bool b4 = str == S("third");
+  getline(s, str);      // an empty line
+  bool b5 = str.empty() && s.good();
+  getline(s, str);
+  bool b6 = str == S("last") && s.eof() && !s.fail();
+  getline(s, str);      // the sentry fails; str is unchanged
+  return b1 && b2 && b3 && b4 && b5 && b6 && s.fail() && str == S("last");
+}
+
+template <typename Iss, typename S>
+constexpr bool istream_ignore_test()
+{
+  using traits = typename Iss::traits_type;
+  Iss s(S("abc,def,ghi jk"));
+  s.ignore();
+  bool b1 = 'b'==s.peek() && 0==s.gcount();
+  s.ignore(100, ',');
+  bool b2 = 3==s.gcount() && 'd'==s.peek();
+  s.ignore(2);
+  bool b3 = 2==s.gcount() && 'f'==s.peek();
+  s.ignore(std::numeric_limits<std::streamsize>::max(), ' ');
+  char c = 0;
+  s.get(c);
+  s.putback(c);
+  bool b4 = 'j'==c && 'j'==s.peek() && s.good();
+  s.ignore(10);
+  bool b5 = 2==s.gcount() && s.eof() && !s.fail();
+  bool b6 = traits::eq_int_type(traits::eof(), s.peek());
+  s.clear();
+  s.putback('x');       // not the preceding character
+  return b1 && b2 && b3 && b4 && b5 && b6 && s.bad();
+}
+
+template <typename Iss, typename S>
+constexpr bool istream_readsome_test()
+{
+  Iss s(S("hello world"));
+  char buf[8]{};
+  std::streamsize n1 = s.readsome(buf, 5);
+  bool b1 = 5==n1 && S(buf) == S("hello");
+  char buf2[8]{};
+  std::streamsize n2 = s.readsome(buf2, 7);
+  bool b2 = 6==n2 && 6==s.gcount() && S(buf2) == S(" world");
+  std::streamsize n3 = s.readsome(buf2, 7);
+  return b1 && b2 && 0==n3 && s.good();
+}
+
+} // namespace is_tests
+
+void istream_tests()
+{
+  using namespace is_tests;
+
+  assert((istream_int_test< std::istringstream,  std::string>()));
+  assert((istream_int_test<cest::istringstream, cest::string>()));
+  assert((istream_hex_test< std::istringstream,  std::string>()));
+  assert((istream_hex_test<cest::istringstream, cest::string>()));
+  assert((istream_float_test< std::istringstream,  std::string>()));
+  assert((istream_float_test<cest::istringstream, cest::string>()));
+  assert((istream_float_sign_test< std::istringstream,  std::string>()));
+  assert((istream_float_sign_test<cest::istringstream, cest::string>()));
+  assert((istream_text_test< std::istringstream,  std::string>()));
+  assert((istream_text_test<cest::istringstream, cest::string>()));
+  assert((istream_skipws_test< std::istringstream,  std::string>()));
+  assert((istream_skipws_test<cest::istringstream, cest::string>()));
+  assert((istream_getline_test< std::istringstream,  std::string>()));
+  assert((istream_getline_test<cest::istringstream, cest::string>()));
+  assert((istream_ignore_test< std::istringstream,  std::string>()));
+  assert((istream_ignore_test<cest::istringstream, cest::string>()));
+  assert((istream_readsome_test< std::istringstream,  std::string>()));
+  assert((istream_readsome_test<cest::istringstream, cest::string>()));
+
+#if CONSTEXPR_CEST == 1
+  static_assert(istream_int_test<cest::istringstream, cest::string>());
+  static_assert(istream_hex_test<cest::istringstream, cest::string>());
+  static_assert(istream_float_test<cest::istringstream, cest::string>());
+  static_assert(istream_float_sign_test<cest::istringstream, cest::string>());
+  static_assert(istream_text_test<cest::istringstream, cest::string>());
+  static_assert(istream_skipws_test<cest::istringstream, cest::string>());
+  static_assert(istream_getline_test<cest::istringstream, cest::string>());
+  static_assert(istream_ignore_test<cest::istringstream, cest::string>());
+  static_assert(istream_readsome_test<cest::istringstream, cest::string>());
+#endif
+}
+
+#endif // _CEST_ISTREAM_TESTS_HPP_
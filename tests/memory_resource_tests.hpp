@@ -0,0 +1,163 @@
+#ifndef _CEST_MEMORY_RESOURCE_TESTS_HPP_
+#define _CEST_MEMORY_RESOURCE_TESTS_HPP_
+
+#include "cest/memory_resource.hpp"
+#include "cest/vector.hpp"
+#include "cest/string.hpp"
+#include "cest/list.hpp"
+#include "cest/forward_list.hpp"
+#include "cest/map.hpp"
+#include "cest/set.hpp"
+#include "cest/deque.hpp"
+#include <vector>
+#include <thread>
+#include <numeric>
+#include <cassert>
+
+namespace mr_tests {
+
+// Counts the requests passed to the new_delete_resource
+class counting_resource : public cest::pmr::memory_resource
+{
+public:
+  int allocs = 0, deallocs = 0;
+  std::size_t bytes = 0;
+
+private:
+  void* do_allocate(std::size_t n, std::size_t align) override {
+    ++allocs;
+    bytes += n;
+    return cest::pmr::new_delete_resource()->allocate(n, align);
+  }
+  void do_deallocate(void* p, std::size_t n, std::size_t align) override {
+    ++deallocs;
+    bytes -= n;
+    cest::pmr::new_delete_resource()->deallocate(p, n, align);
+  }
+  constexpr bool do_is_equal(const memory_resource& other)
+    const noexcept override { return this == &other; }
+};
+
+// Each pmr container; with the given resource
+template <typename Resource>
+constexpr bool pmr_test1(Resource& r)
+{
+  using namespace cest;
+  pmr::vector<int> v(&r);
+  pmr::string s("Fire and Brimstone!", &r);
+  pmr::list<int> l(&r);
+  pmr::forward_list<int> fl(&r);
+  pmr::map<int, char> m(&r);
+  pmr::set<int> st(&r);
+  pmr::deque<int> d(&r);
+  for (int i = 0; i < 100; ++i) {
+    v.push_back(i);
+    l.push_back(i);
+    fl.push_front(i);
+    m.insert({i, char('a' + i % 26)});
+    st.insert(99 - i);
+    d.push_front(i);
+  }
+  bool b1 = v.get_allocator().resource()==&r && d.get_allocator()==v.get_allocator();
+  bool b2 = 4950==std::accumulate(v.begin(), v.end(), 0) &&
+            4950==std::accumulate(l.begin(), l.end(), 0) && 99==fl.front() &&
+            'a'==m.begin()->second && 100==m.size() && 0==*st.begin() &&
+            99==d.front() && 19==s.size();
+
+  // As std::pmr, a copy uses the default resource
+  pmr::vector<int> v2 = v;
+  bool b3 = 100==v2.size() && 99==v2[99] &&
+            v2.get_allocator()==pmr::polymorphic_allocator<int>();
+  return b1 && b2 && b3;
+}
+
+constexpr bool pmr_monotonic_test()
+{
+  cest::pmr::monotonic_buffer_resource r(1024);
+  bool b = pmr_test1(r);
+  return b && r.typed_arena()->block_count() > 0;
+}
+
+bool pmr_pool_test()
+{
+  counting_resource up;
+  bool b1, b2, b3;
+  {
+    cest::pmr::unsynchronized_pool_resource pool({16, 256}, &up);
+    b1 = pmr_test1(pool) && 256==pool.options().largest_required_pool_block;
+
+    // a freed block is reused by a request of the same size
+    void* p = pool.allocate(24);
+    pool.deallocate(p, 24);
+    void* q = pool.allocate(20);
+    b2 = p==q && up.allocs > 0;
+
+    // larger requests go upstream; and are returned by release
+    const int n = up.allocs;
+    void* big = pool.allocate(1000, 64);
+    b2 = b2 && n+1==up.allocs && 0==reinterpret_cast<std::uintptr_t>(big)%64;
+    pool.release();
+    b3 = 0==up.bytes && up.allocs==up.deallocs;
+    (void)pool.allocate(8);
+  }
+  return b1 && b2 && b3 && 0==up.bytes;
+}
+
+bool pmr_default_resource_test()
+{
+  counting_resource r;
+  auto* old = cest::pmr::set_default_resource(&r);
+  {
+    cest::pmr::vector<int> v;
+    v.push_back(42);
+  }
+  // the resource is that of the allocator's construction; and a change of
+  // the default resource between allocate and deallocate doesn't matter
+  cest::pmr::polymorphic_allocator<int> a;
+  int* p = a.allocate(4);
+  cest::pmr::set_default_resource(old);
+  const bool b = a.resource()==&r && 1==r.allocs - r.deallocs;
+  a.deallocate(p, 4);
+  return b && 0 < r.allocs && r.allocs==r.deallocs &&
+         cest::pmr::polymorphic_allocator<int>().resource()==old &&
+         old==cest::pmr::new_delete_resource() &&
+         old==cest::pmr::get_default_resource();
+}
+
+bool pmr_synchronized_test()
+{
+  cest::pmr::synchronized_pool_resource pool;
+  std::vector<std::thread> threads;
+  std::vector<int> sums(4);
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([&pool, &sums, t] {
+      for (int j = 0; j < 50; ++j) {
+        cest::pmr::list<int> l(&pool);
+        for (int i = 0; i < 100; ++i)
+          l.push_back(i);
+        sums[t] += std::accumulate(l.begin(), l.end(), 0);
+      }
+    });
+  for (auto& t : threads)
+    t.join();
+  return std::all_of(sums.begin(), sums.end(),
+                     [](int s) { return 50*4950==s; });
+}
+
+} // namespace mr_tests
+
+void memory_resource_tests()
+{
+  using namespace mr_tests;
+
+#if CONSTEXPR_CEST == 1
+  static_assert(pmr_monotonic_test());
+#endif
+
+  assert(pmr_monotonic_test());
+  assert(pmr_pool_test());
+  assert(pmr_default_resource_test());
+  assert(pmr_synchronized_test());
+}
+
+#endif // _CEST_MEMORY_RESOURCE_TESTS_HPP_
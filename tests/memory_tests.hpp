@@ -3,6 +3,9 @@
 
 #include <cest/memory.hpp>
 #include <memory>
+#include <vector>
+#include <thread>
+#include <atomic>
 #include <cassert>
 
 template <template<typename...>typename U>
@@ -157,6 +160,168 @@ constexpr bool shared_ptr_test2()
   return b1 && b2 && 42==i;
 }
 
+// move, assignment, swap, reset and conversion
+template <template <typename ...> typename St>
+constexpr bool shared_ptr_test3()
+{
+  struct base_t { int i; };
+  struct derived_t : base_t { constexpr derived_t(int i) : base_t{i} {} };
+
+  St<int> sp1{new int{1}};
+  St<int> sp2{std::move(sp1)};
+  bool b1 = !sp1 && 0==sp1.use_count() && 1==*sp2 && 1==sp2.use_count();
+
+  St<int> sp3;
+  sp3 = sp2;
+  St<int> sp4{new int{4}};
+  sp4 = std::move(sp3);
+  bool b2 = !sp3 && 2==sp2.use_count() && 1==*sp4;
+
+  St<int> sp5{new int{5}};
+  swap(sp4, sp5);
+  sp2.swap(sp4);
+  bool b3 = 5==*sp2 && 1==*sp4 && 1==*sp5 && 2==sp5.use_count();
+
+  sp5.reset();
+  sp4.reset(new int{6});
+  bool b4 = !sp5 && 6==*sp4 && 1==sp4.use_count();
+
+  St<derived_t> spd{new derived_t{7}};
+  St<base_t> spb1{spd};
+  St<base_t> spb2{std::move(spd)};
+  St<base_t> spb3;
+  spb3 = St<derived_t>{new derived_t{8}};
+  bool b5 = !spd && 7==spb1->i && 7==spb2->i && 2==spb1.use_count();
+  b5 = b5 && 8==spb3->i && 1==spb3.use_count();
+
+  St<int[]> spa1{new int[2]{1,2}};
+  St<int[]> spa2;
+  spa2 = std::move(spa1);
+  bool b6 = !spa1 && 2==spa2[1];
+
+  return b1 && b2 && b3 && b4 && b5 && b6;
+}
+
+template <template <typename ...> typename St,
+          template <typename ...> typename Wp>
+constexpr bool weak_ptr_test()
+{
+  Wp<int> wp1;
+  bool b1 = wp1.expired() && 0==wp1.use_count() && !wp1.lock();
+
+  St<int> sp1{new int{42}};
+  Wp<int> wp2{sp1};
+  Wp<int> wp3 = wp2;
+  bool b2 = !wp2.expired() && 1==wp2.use_count() && 1==sp1.use_count();
+
+  bool b3{false};
+  {
+    St<int> sp2 = wp3.lock();
+    St<int> sp3{wp3};
+    b3 = 42==*sp2 && 42==*sp3 && 3==wp2.use_count();
+  }
+
+  sp1.reset();
+  bool b4 = wp2.expired() && wp3.expired() && !wp3.lock();
+  wp1 = wp3;
+  wp3.reset();
+  bool b5 = wp1.expired() && 0==wp3.use_count();
+
+  return b1 && b2 && b3 && b4 && b5;
+}
+
+constexpr bool make_shared_test()
+{
+  struct point { int x, y; };
+
+  bool b1{false}, b2{false}, b3{false}, b4{false};
+  int i{41};
+  {
+    struct dtor_count { constexpr ~dtor_count() { ++i_; } int& i_; };
+    auto sp1 = cest::make_shared<point>(1, 2);
+    auto sp2 = sp1;
+    b1 = 1==sp1->x && 2==sp2->y && 2==sp1.use_count();
+
+    auto sp3 = cest::make_shared<dtor_count>(i);
+    auto sp4 = cest::allocate_shared<int>(std::allocator<int>(), 42);
+    b2 = 42==*sp4 && 1==sp4.use_count() && 41==sp3->i_;
+
+    auto spa1 = cest::make_shared<int[]>(4);
+    auto spa2 = cest::make_shared<long double[]>(3, 1.5L);
+    spa1[3] = 4;
+    b3 = 0==spa1[0] && 0==spa1[2] && 4==spa1[3] && 1.5L==spa2[2];
+
+    auto spa3 = cest::allocate_shared<point[]>(std::allocator<point>(), 2);
+    b4 = 0==spa3[1].x && 0==spa3[1].y;
+  }
+
+  return b1 && b2 && b3 && b4 && 42==i;
+}
+
+// Runtime only: should a constructor throw, allocate_shared deallocates the
+// block; and destroys the elements of an array already constructed
+struct live_alloc_count { int allocs = 0, objs = 0; };
+
+template <typename T>
+struct counting_alloc
+{
+  using value_type = T;
+  live_alloc_count* c;
+  counting_alloc(live_alloc_count* c) : c(c) {}
+  template <typename U> counting_alloc(const counting_alloc<U>& o) : c(o.c) {}
+  T* allocate(std::size_t n) { ++c->allocs; return std::allocator<T>{}.allocate(n); }
+  void deallocate(T* p, std::size_t n) { --c->allocs; std::allocator<T>{}.deallocate(p, n); }
+};
+
+bool make_shared_throw_test()
+{
+  live_alloc_count c;
+  struct thrower {
+    thrower(live_alloc_count* c, int i) : c(c) { if (3 == i) throw 3; ++c->objs; }
+    thrower(const thrower& o) : c(o.c) { if (3 == c->objs) throw 3; ++c->objs; }
+    ~thrower() { --c->objs; }
+    live_alloc_count* c;
+  };
+  int thrown = 0;
+  try { cest::allocate_shared<thrower>(counting_alloc<thrower>(&c), &c, 3); }
+  catch (int) { ++thrown; }
+  {
+    thrower t(&c, 0);
+    try { cest::allocate_shared<thrower[]>(counting_alloc<thrower>(&c), 5, t); }
+    catch (int) { ++thrown; }
+  }
+  auto sp = cest::allocate_shared<thrower>(counting_alloc<thrower>(&c), &c, 1);
+  const bool b = 1==c.allocs && 1==c.objs;
+  sp.reset();
+  return b && 2==thrown && 0==c.allocs && 0==c.objs;
+}
+
+// Copies of an atomic_shared_ptr are made and destroyed by several threads
+bool atomic_shared_ptr_test()
+{
+  auto sp = cest::make_shared<int, cest::atomic_policy>(42);
+  cest::weak_ptr<int, cest::atomic_policy> wp{sp};
+  std::atomic<bool> ok{true};
+  {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+      threads.emplace_back([&] {
+        for (int i = 0; i < 10000; i++) {
+          cest::atomic_shared_ptr<int> sp2 = sp;
+          auto sp3 = wp.lock();
+          if (42 != *sp2 || 42 != *sp3)
+            ok = false;
+        }
+      });
+    for (auto& t : threads)
+      t.join();
+  }
+
+  bool b = ok && 1==sp.use_count();
+  sp.reset();
+  return b && wp.expired();
+}
+
 void
 memory_tests()
 {
@@ -166,6 +331,11 @@ memory_tests()
   static_assert(make_unique_test(), "make_unique: Tests failed!");
   static_assert(shared_ptr_test<cest::shared_ptr>());
   static_assert(shared_ptr_test2<cest::shared_ptr>());
+  static_assert(shared_ptr_test3<cest::shared_ptr>());
+  static_assert(constexpr_mem_test<cest::shared_ptr>());
+  static_assert(make_shared_test());
+  static_assert(weak_ptr_test<cest::shared_ptr, cest::weak_ptr>());
+  static_assert(shared_ptr_test3<cest::atomic_shared_ptr>());
 #endif
 
   assert(constexpr_mem_test<std::unique_ptr>());
@@ -180,6 +350,16 @@ memory_tests()
   assert(shared_ptr_test<cest::shared_ptr>());
   assert(shared_ptr_test2<std::shared_ptr>());
   assert(shared_ptr_test2<cest::shared_ptr>());
+  assert(shared_ptr_test3<std::shared_ptr>());
+  assert(shared_ptr_test3<cest::shared_ptr>());
+  assert(constexpr_mem_test<std::shared_ptr>());
+  assert(constexpr_mem_test<cest::shared_ptr>());
+  assert(make_shared_test());
+  assert((weak_ptr_test<std::shared_ptr, std::weak_ptr>()));
+  assert((weak_ptr_test<cest::shared_ptr, cest::weak_ptr>()));
+  assert(shared_ptr_test3<cest::atomic_shared_ptr>());
+  assert(atomic_shared_ptr_test());
+  assert(make_shared_throw_test());
 }
 
 #endif
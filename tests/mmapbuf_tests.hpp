@@ -0,0 +1,57 @@
+#ifndef _CEST_MMAPBUF_TESTS_HPP_
+#define _CEST_MMAPBUF_TESTS_HPP_
+
+#include "cest/mmapbuf.hpp"
+#include "cest/istream.hpp"
+#include "cest/string.hpp"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cassert>
+
+// The streambuf's view of this file is that of std::ifstream
+bool mmapbuf_test1()
+{
+  std::ifstream ifs(__FILE__);
+  std::stringstream ss;
+  ss << ifs.rdbuf();
+  const std::string expected = ss.str();
+
+  cest::mmapbuf mb(__FILE__);
+  cest::istream is(&mb);
+  cest::string line;
+  getline(is, line);
+  bool b1 = mb.is_open() &&
+            line == cest::string("#ifndef _CEST_MMAPBUF_TESTS_HPP_");
+  bool b2 = expected.size() == mb.span().size() &&
+            expected == std::string(mb.span().data(), mb.span().size());
+
+  char buf[16];
+  std::streamsize n = 0;
+  while (is.read(buf, sizeof buf) || is.gcount())
+    n += is.gcount();
+  bool b3 = n == std::streamsize(expected.size() - line.size() - 1);
+  is.clear();
+  bool b4 = 0 == is.readsome(buf, sizeof buf) && is.eof();
+
+  cest::mmapbuf none("mmapbuf_tests/no_such_file");
+  return b1 && b2 && b3 && b4 && !none.is_open() && mb.close() && !mb.is_open();
+}
+
+// No file is opened within a constant expression
+constexpr bool mmapbuf_test2()
+{
+  cest::mmapbuf mb;
+  return !mb.open(__FILE__) && !mb.is_open() && mb.span().empty();
+}
+
+void mmapbuf_tests()
+{
+#if CONSTEXPR_CEST == 1
+  static_assert(mmapbuf_test2());
+#endif
+
+  assert(mmapbuf_test1());
+}
+
+#endif // _CEST_MMAPBUF_TESTS_HPP_
@@ -0,0 +1,32 @@
+// A program which includes the string streams, but not iostream.hpp, must
+// link without the definitions of cest::cout, cerr or clog.
+
+#include "cest/sstream.hpp"
+#include "cest/spanstream.hpp"
+#include <span>
+#include <cassert>
+
+constexpr bool no_iostream_test1()
+{
+  cest::ostringstream oss;
+  oss << "pi " << 3.25 << ' ' << 42 << cest::endl;
+  return oss.str() == "pi 3.25 42\n";
+}
+
+constexpr bool no_iostream_test2()
+{
+  char data[8]{};
+  cest::ospanstream os(std::span<char>(data, 8));
+  os << 1.5 << '!';
+  return data[0] == '1' && data[1] == '.' && data[2] == '5' && data[3] == '!';
+}
+
+int main(int argc, char *argv[])
+{
+  static_assert(no_iostream_test1());
+  static_assert(no_iostream_test2());
+  assert(no_iostream_test1());
+  assert(no_iostream_test2());
+
+  return 0;
+}
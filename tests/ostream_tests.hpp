@@ -0,0 +1,166 @@
+#ifndef _CEST_OSTREAM_TESTS_HPP_
+#define _CEST_OSTREAM_TESTS_HPP_
+
+#include "cest/sstream.hpp"
+#include "cest/string.hpp"
+#include <sstream>
+#include <string>
+#include <climits>
+#include <cassert>
+
+namespace os_tests {
+
+template <typename Oss, typename S>
+constexpr bool ostream_int_test()
+{
+  Oss s;
+  s << 42 << ' ' << -7L << ' ' << LLONG_MIN << ' ' << ULLONG_MAX << ' '
+    << (unsigned short)65535 << ' ' << (short)-2 << ' ' << true;
+  bool b1 = s.str() == S("42 -7 -9223372036854775808 18446744073709551615 "
+                         "65535 -2 1");
+  Oss s2;
+  s2.setf(Oss::hex, Oss::basefield);
+  s2 << 255 << ' ' << (short)-1 << ' ' << -1 << ' ';
+  s2.setf(Oss::showbase | Oss::uppercase);
+  s2 << 255 << ' ' << 0 << ' ';
+  s2.setf(Oss::oct, Oss::basefield);
+  s2 << 8 << ' ' << 0 << ' ';
+  s2.setf(Oss::dec, Oss::basefield);
+  s2.setf(Oss::showpos | Oss::boolalpha);
+  s2 << 5 << ' ' << 5u << ' ' << 0 << ' ' << false;
+  bool b2 = s2.str() == S("ff ffff ffffffff 0XFF 0 010 0 +5 5 +0 false");
+  return b1 && b2;
+}
+
+template <typename Oss, typename S>
+constexpr bool ostream_float_test()
+{
+  Oss s;
+  s << 3.14159265358979 << ' ' << 0.1f << ' ' << 1e21 << ' ' << 1e-5 << ' '
+    << 100.0 << ' ' << -0.0 << ' ' << 123456789.0 << ' ' << 2.5L;
+  bool b1 = s.str() == S("3.14159 0.1 1e+21 1e-05 100 -0 1.23457e+08 2.5");
+  Oss s2;
+  s2.setf(Oss::fixed, Oss::floatfield);
+  s2 << 2.5 << ' ' << 1e21 << ' ';
+  s2.precision(2);
+  s2 << 0.125 << ' ' << 0.375 << ' ' << -1.005 << ' ';
+  s2.setf(Oss::scientific, Oss::floatfield);
+  s2 << 12345.678 << ' ' << 5e-324 << ' ';
+  s2.precision(0);
+  s2 << 2.5 << ' ';
+  s2.setf(Oss::showpoint | Oss::showpos | Oss::uppercase);
+  s2 << 2.5 << ' ';
+  s2.unsetf(Oss::floatfield);
+  s2 << 100.0 << ' ';
+  s2.setf(Oss::fixed | Oss::scientific, Oss::floatfield);
+  s2 << 3.0;
+  bool b2 = s2.str() == S("2.500000 1000000000000000000000.000000 0.12 0.38 "
+                          "-1.00 1.23e+04 4.94e-324 2e+00 +2.E+00 +1.E+02 "
+                          "+0X1.8P+1");
+  return b1 && b2;
+}
+
+template <typename Oss, typename S>
+constexpr bool ostream_pad_test()
+{
+  Oss s;
+  s.width(6);
+  s << 42 << '|';
+  s.width(6);
+  s.fill('*');
+  s.setf(Oss::left, Oss::adjustfield);
+  s << -42 << '|';
+  s.width(6);
+  s.setf(Oss::internal, Oss::adjustfield);
+  s << -42 << '|';
+  s.width(8);
+  s.setf(Oss::hex | Oss::showbase, Oss::basefield | Oss::showbase);
+  s << 255 << '|';
+  s.width(3);
+  s << "abcde" << '|';
+  s.width(4);
+  s.setf(Oss::boolalpha);
+  s << "ab" << true << '|';
+  s.width(9);
+  s.precision(3);
+  s << -1.5 << '|' << 7;
+  return s.str() == S("    42|-42***|-***42|0x****ff|abcde|**abtrue|-*****1.5|0x7")
+         && '*' == s.fill() && 0 == s.width();
+}
+
+// A long conversion exceeds the stack buffer of the formatter
+template <typename Oss, typename S>
+constexpr bool ostream_long_test()
+{
+  Oss s;
+  s.setf(Oss::fixed, Oss::floatfield);
+  s.precision(100);
+  s << 0.5;
+  const S str = s.str();
+  bool b = 102 == str.size() && '0' == str[0] && '.' == str[1] && '5' == str[2];
+  for (int i = 3; b && i < 102; ++i)
+    b = '0' == str[i];
+
+  // and padded: internal, after the sign; or left adjusted
+  Oss t;
+  t.fill('*');
+  t.setf(Oss::fixed, Oss::floatfield);
+  t.setf(Oss::internal, Oss::adjustfield);
+  t.precision(100);
+  t.width(130);
+  t << -0.5 << '|';
+  t.setf(Oss::scientific, Oss::floatfield);
+  t.setf(Oss::left, Oss::adjustfield);
+  t.precision(80);
+  t.width(110);
+  t << 1.0 << '|';
+  t.setf(Oss::fixed, Oss::floatfield);
+  t.setf(Oss::right, Oss::adjustfield);
+  t.precision(0);
+  t.width(305);
+  t << 1e300;
+  const S u = t.str();
+  b = b && 130 + 1 + 110 + 1 + 305 == u.size() && '-' == u[0] &&
+      '*' == u[1] && '*' == u[27] && '0' == u[28] && '5' == u[30] &&
+      '0' == u[129] && '|' == u[130] && '1' == u[131] && '.' == u[132] &&
+      'e' == u[213] && '0' == u[216] && '*' == u[217] && '*' == u[240] &&
+      '|' == u[241] && '*' == u[245] && '1' == u[246] && '5' == u[263];
+  return b;
+}
+
+// A negative precision (a cest extension) selects the shortest digits which
+// read back as the value
+constexpr bool ostream_shortest_test()
+{
+  cest::ostringstream s;
+  s.precision(-1);
+  s << 0.1 << ' ' << 1.0 / 3 << ' ' << 1e23 << ' ' << 5e-324 << ' ' << 1e15;
+  return s.str() == cest::string("0.1 0.3333333333333333 1e+23 5e-324 1e+15");
+}
+
+} // namespace os_tests
+
+void ostream_tests()
+{
+  using namespace os_tests;
+
+  assert((ostream_int_test< std::ostringstream,  std::string>()));
+  assert((ostream_int_test<cest::ostringstream, cest::string>()));
+  assert((ostream_float_test< std::ostringstream,  std::string>()));
+  assert((ostream_float_test<cest::ostringstream, cest::string>()));
+  assert((ostream_pad_test< std::ostringstream,  std::string>()));
+  assert((ostream_pad_test<cest::ostringstream, cest::string>()));
+  assert((ostream_long_test< std::ostringstream,  std::string>()));
+  assert((ostream_long_test<cest::ostringstream, cest::string>()));
+  assert(ostream_shortest_test());
+
+#if CONSTEXPR_CEST == 1
+  static_assert(ostream_int_test<cest::ostringstream, cest::string>());
+  static_assert(ostream_float_test<cest::ostringstream, cest::string>());
+  static_assert(ostream_pad_test<cest::ostringstream, cest::string>());
+  static_assert(ostream_long_test<cest::ostringstream, cest::string>());
+  static_assert(ostream_shortest_test());
+#endif
+}
+
+#endif // _CEST_OSTREAM_TESTS_HPP_
@@ -5,6 +5,9 @@
 #include "cest/list.hpp"
 #include "../tests/tests_util.hpp"
 #include <queue>
+#include <vector>
+#include <functional>
+#include <iterator>
 #include <cassert>
 
 template <typename Q>
@@ -47,6 +50,41 @@ constexpr bool queue_test2()
   return q1.size()==q2.size() && 42==q3.front();
 }
 
+template <typename Pq>
+constexpr bool priority_queue_test1()
+{
+  Pq q;
+  bool b0 = q.empty();
+  const int xs[]{5, 1, 8, 3, 9, 2, 7, 4, 6, 0, 9};
+  for (int x : xs)
+    q.push(x);
+  q.emplace(10);
+  bool b1 = 12==q.size() && 10==q.top();
+
+  const int expected[]{10, 9, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0};
+  bool b2 = true;
+  for (int e : expected) {
+    b2 = b2 && e==q.top();
+    q.pop();
+  }
+  return b0 && b1 && b2 && q.empty();
+}
+
+// bulk construction; and a min-heap
+template <typename Pq>
+constexpr bool priority_queue_test2()
+{
+  const int xs[]{42, 17, 99, 3, 58, 21, 3, 76};
+  Pq q(std::begin(xs), std::end(xs));
+  int prev = q.top();
+  bool b = 3==prev && 8==q.size();
+  for (q.pop(); !q.empty(); q.pop()) {
+    b = b && prev <= q.top();
+    prev = q.top();
+  }
+  return b && 99==prev;
+}
+
 void queue_tests()
 {
   using namespace tests_util;
@@ -60,6 +98,14 @@ void queue_tests()
 
   static_assert(push_dtor_test<cest::queue<Bar<>>>());
   static_assert(push_dtor_test<cest::queue<Bar<>,cest::list<Bar<>>>>());
+
+  static_assert(priority_queue_test1<cest::priority_queue<int>>());
+  static_assert(priority_queue_test1<cest::d_ary_priority_queue<int,3>>());
+  static_assert(priority_queue_test1<cest::d_ary_priority_queue<int,4>>());
+  static_assert(priority_queue_test2<
+    cest::priority_queue<int,cest::vector<int>,std::greater<int>>>());
+  static_assert(priority_queue_test2<
+    cest::priority_queue<int,cest::deque<int>,std::greater<int>,4>>());
 #endif
 
   assert((queue_test1< std::queue<int>>()));
@@ -79,6 +125,17 @@ void queue_tests()
   assert((push_dtor_test< std::queue<Bar<>,cest::list<Bar<>>>>()));
   assert((push_dtor_test<cest::queue<Bar<>,cest::list<Bar<>>>>()));
   assert((push_dtor_test<cest::queue<Bar<>,std::list<Bar<>>>>()));
+
+  assert((priority_queue_test1< std::priority_queue<int>>()));
+  assert((priority_queue_test1<cest::priority_queue<int>>()));
+  assert((priority_queue_test1<cest::d_ary_priority_queue<int,3>>()));
+  assert((priority_queue_test1<cest::d_ary_priority_queue<int,4>>()));
+  assert((priority_queue_test2<
+    std::priority_queue<int,std::vector<int>,std::greater<int>>>()));
+  assert((priority_queue_test2<
+    cest::priority_queue<int,cest::vector<int>,std::greater<int>>>()));
+  assert((priority_queue_test2<
+    cest::priority_queue<int,cest::deque<int>,std::greater<int>,4>>()));
 }
 
 #endif // _CEST_QUEUE_TESTS_HPP_
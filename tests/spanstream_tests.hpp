@@ -0,0 +1,70 @@
+#ifndef _CEST_SPANSTREAM_TESTS_HPP_
+#define _CEST_SPANSTREAM_TESTS_HPP_
+
+#include "cest/spanstream.hpp"
+#include <span>
+#include <cassert>
+#if __has_include(<spanstream>)
+#include <spanstream>
+#endif
+
+namespace ss_tests {
+
+template <typename Iss>
+constexpr bool spanstream_in_test()
+{
+  char data[] = "12 ab";
+  Iss s(std::span<char>(data, 5));
+  int i = 0;
+  char c = 0;
+  s >> i >> c;
+  data[4] = 'z';        // the stream reads the buffer in place
+  s >> c;
+  return 12==i && 'z'==c && data==s.span().data() && 5==s.span().size() &&
+         !(s >> c) && s.eof();
+}
+
+template <typename Iss>
+constexpr bool spanstream_const_test()
+{
+  const char data[3] = {'4', '2', ' '};
+  Iss s(data);
+  int i = 0;
+  s >> i;
+  return 42==i && data==s.span().data();
+}
+
+template <typename Oss>
+constexpr bool spanstream_out_test()
+{
+  char data[6]{};
+  Oss s(std::span<char>(data, 6));
+  s << 42 << ' ';
+  bool b1 = 3==s.span().size() && '4'==data[0] && ' '==data[2] && s.good();
+  s << "abcd";          // the buffer never grows
+  return b1 && s.bad() && 6==s.span().size() && 'c'==data[5];
+}
+
+} // namespace ss_tests
+
+void spanstream_tests()
+{
+  using namespace ss_tests;
+
+#ifdef __cpp_lib_spanstream
+  assert(spanstream_in_test<std::ispanstream>());
+  assert(spanstream_const_test<std::ispanstream>());
+  assert(spanstream_out_test<std::ospanstream>());
+#endif
+  assert(spanstream_in_test<cest::ispanstream>());
+  assert(spanstream_const_test<cest::ispanstream>());
+  assert(spanstream_out_test<cest::ospanstream>());
+
+#if CONSTEXPR_CEST == 1
+  static_assert(spanstream_in_test<cest::ispanstream>());
+  static_assert(spanstream_const_test<cest::ispanstream>());
+  static_assert(spanstream_out_test<cest::ospanstream>());
+#endif
+}
+
+#endif // _CEST_SPANSTREAM_TESTS_HPP_
@@ -0,0 +1,69 @@
+#ifndef _CEST_STACK_TESTS_HPP_
+#define _CEST_STACK_TESTS_HPP_
+
+#include "cest/stack.hpp"
+#include "cest/vector.hpp"
+#include "cest/list.hpp"
+#include "../tests/tests_util.hpp"
+#include <stack>
+#include <vector>
+#include <cassert>
+
+template <typename S>
+constexpr bool stack_test1()
+{
+  S s;
+  bool b0  = s.empty();
+  const int i{42};
+
+  s.push(i);
+  auto t1 = s.top();
+
+  s.push(43);
+  s.emplace(44);
+  auto t2 = s.top();
+  auto sz2 = s.size();
+
+  s.pop();
+  auto t3 = s.top();
+  s.pop();
+  s.pop();
+
+  return b0 && t1==42 && t2==44 && sz2==3 && t3==43 && s.empty();
+}
+
+// tests copy ctor and operator=
+template <typename S>
+constexpr bool stack_test2()
+{
+  S s1;
+  s1.push(42);
+  S s2 = s1;
+  S s3;
+  s3 = s2;
+  return s1.size()==s2.size() && 42==s3.top();
+}
+
+void stack_tests()
+{
+#if CONSTEXPR_CEST == 1
+  static_assert(stack_test1<cest::stack<int>>());
+  static_assert(stack_test1<cest::stack<int,cest::vector<int>>>());
+  static_assert(stack_test1<cest::stack<int,cest::list<int>>>());
+
+  static_assert(stack_test2<cest::stack<int>>());
+  static_assert(stack_test2<cest::stack<int,cest::vector<int>>>());
+#endif
+
+  assert((stack_test1< std::stack<int>>()));
+  assert((stack_test1<cest::stack<int>>()));
+  assert((stack_test1<cest::stack<int,cest::vector<int>>>()));
+  assert((stack_test1<cest::stack<int,cest::list<int>>>()));
+  assert((stack_test1<cest::stack<int,std::vector<int>>>()));
+
+  assert((stack_test2< std::stack<int>>()));
+  assert((stack_test2<cest::stack<int>>()));
+  assert((stack_test2<cest::stack<int,cest::vector<int>>>()));
+}
+
+#endif // _CEST_STACK_TESTS_HPP_
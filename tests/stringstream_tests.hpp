@@ -62,6 +62,52 @@ constexpr bool istringstream_test3()
   return b1 && b2;
 }
 
+template <typename Oss, typename S>
+constexpr bool ostringstream_test1()
+{
+  Oss s1;
+  s1 << "Fire" << ' ' << "and " << 42 << S(" Brimstone!");
+  bool b1 = s1.str() == S("Fire and 42 Brimstone!");
+  Oss s2(S("abcdef"));  // overwrites, from the start
+  s2 << "xyz";
+  bool b2 = s2.str() == S("xyzdef");
+  s2.str(S("reset"));
+  s2 << 'R';
+  return b1 && b2 && s2.str() == S("Reset") && s1.good();
+}
+
+// Many insertions: the put area grows geometrically
+template <typename Oss, typename S>
+constexpr bool ostringstream_test2()
+{
+  Oss s;
+  for (int i = 0; i < 2000; ++i)
+    s << char('a' + i % 26);
+  S str = s.str();
+  bool b = 2000 == str.size();
+  for (int i = 0; b && i < 2000; ++i)
+    b = str[i] == char('a' + i % 26);
+  return b;
+}
+
+// Both directions; each with its own position in the same buffer
+template <typename Ss, typename S>
+constexpr bool stringstream_test1()
+{
+  Ss s;
+  s << "ab" << 12;
+  char c1, c2, c3;
+  s.get(c1).get(c2);
+  s << 'Z';
+  s.get(c3);
+  bool b1 = 'a'==c1 && 'b'==c2 && '1'==c3 && s.str() == S("ab12Z");
+  char buf[2];
+  s.read(buf, 2);
+  bool b2 = '2'==buf[0] && 'Z'==buf[1] && s.good();
+  s.get(c1);
+  return b1 && b2 && s.eof() && s.fail() && !s;
+}
+
 } // namespace ss_tests
 
 void stringstream_tests()
@@ -78,9 +124,19 @@ void stringstream_tests()
   assert((istringstream_test3< std::ifstream,  std::string,  std_isbi>()));
   assert((istringstream_test3<cest::ifstream, cest::string, cest_isbi>()));
 
+  assert((ostringstream_test1< std::ostringstream, std::string>()));
+  assert((ostringstream_test1<cest::ostringstream, cest::string>()));
+  assert((ostringstream_test2< std::ostringstream, std::string>()));
+  assert((ostringstream_test2<cest::ostringstream, cest::string>()));
+  assert((stringstream_test1< std::stringstream, std::string>()));
+  assert((stringstream_test1<cest::stringstream, cest::string>()));
+
 #if CONSTEXPR_CEST == 1
   static_assert(istringstream_test1<cest::istringstream, cest::string>());
   static_assert(istringstream_test2<cest::istringstream, cest::string>());
+  static_assert(ostringstream_test1<cest::ostringstream, cest::string>());
+  static_assert(ostringstream_test2<cest::ostringstream, cest::string>());
+  static_assert(stringstream_test1<cest::stringstream, cest::string>());
 #endif
 }
 